@@ -0,0 +1,91 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <cstdlib>
+
+#include <atomic>
+#include <new>
+
+#include "bench_alloc_count.h"
+
+namespace yafiyogi::benchmark {
+namespace {
+
+std::atomic<std::size_t> g_alloc_count{0};
+
+void * counted_alloc(std::size_t p_size)
+{
+  g_alloc_count.fetch_add(1, std::memory_order_relaxed);
+
+  if(void * ptr = std::malloc(0 == p_size ? 1 : p_size);
+     nullptr != ptr)
+  {
+    return ptr;
+  }
+
+  throw std::bad_alloc{};
+}
+
+} // namespace
+
+std::size_t alloc_count() noexcept
+{
+  return g_alloc_count.load(std::memory_order_relaxed);
+}
+
+} // namespace yafiyogi::benchmark
+
+// Replacement global allocation functions. The nothrow forms provided
+// by the standard library call these.
+void * operator new(std::size_t p_size)
+{
+  return yafiyogi::benchmark::counted_alloc(p_size);
+}
+
+void * operator new[](std::size_t p_size)
+{
+  return yafiyogi::benchmark::counted_alloc(p_size);
+}
+
+void operator delete(void * p_ptr) noexcept
+{
+  std::free(p_ptr);
+}
+
+void operator delete[](void * p_ptr) noexcept
+{
+  std::free(p_ptr);
+}
+
+void operator delete(void * p_ptr, std::size_t /* size */) noexcept
+{
+  std::free(p_ptr);
+}
+
+void operator delete[](void * p_ptr, std::size_t /* size */) noexcept
+{
+  std::free(p_ptr);
+}
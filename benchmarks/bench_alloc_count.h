@@ -0,0 +1,76 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <cstddef>
+
+#include "benchmark/benchmark.h"
+
+namespace yafiyogi::benchmark {
+
+// Number of calls to global operator new since the program started.
+[[nodiscard]]
+std::size_t alloc_count() noexcept;
+
+// Counts the heap allocations made while a benchmark loop runs.
+//
+//   alloc_counter allocs{};
+//   while(state.KeepRunning()) { ... }
+//   allocs.report(state);
+class alloc_counter final
+{
+  public:
+    alloc_counter() noexcept:
+      m_start(alloc_count())
+    {
+    }
+
+    alloc_counter(const alloc_counter &) = delete;
+    alloc_counter(alloc_counter &&) = delete;
+    ~alloc_counter() = default;
+
+    alloc_counter & operator=(const alloc_counter &) = delete;
+    alloc_counter & operator=(alloc_counter &&) = delete;
+
+    [[nodiscard]]
+    std::size_t count() const noexcept
+    {
+      return alloc_count() - m_start;
+    }
+
+    // Adds an 'allocs' counter, averaged per iteration.
+    void report(::benchmark::State & state) const
+    {
+      state.counters["allocs"] = ::benchmark::Counter(static_cast<double>(count()),
+                                                      ::benchmark::Counter::kAvgIterations);
+    }
+
+  private:
+    std::size_t m_start;
+};
+
+} // namespace yafiyogi::benchmark
@@ -0,0 +1,66 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include "fmt/format.h"
+
+#include "bench_yy_mqtt.h"
+
+namespace yafiyogi::benchmark {
+
+BENCHMARK_F(TopicsFixtureType, art_lookup)(::benchmark::State & state)
+{
+  using yy_mqtt::art_topics_detail::node_kind;
+
+  const auto heap_before = heap_in_use();
+  auto automaton = m_art_topics.create_automaton();
+  const auto heap_bytes = heap_in_use() - heap_before;
+
+  size_t idx = 0;
+  std::size_t count = 0;
+
+  while(state.KeepRunning())
+  {
+    auto payloads = automaton.find(TopicsFixtureType::query(idx));
+    ::benchmark::DoNotOptimize(payloads);
+    if(!payloads.empty())
+    {
+      ::benchmark::DoNotOptimize(++count);
+    }
+
+    ++idx;
+    idx = (idx % TopicsFixtureType::query_size());
+  }
+
+  state.counters["heap_bytes"] = static_cast<double>(heap_bytes);
+  state.counters["bytes"] = static_cast<double>(automaton.memory_size());
+  state.counters["leaf"] = static_cast<double>(automaton.node_count(node_kind::Leaf));
+  state.counters["node4"] = static_cast<double>(automaton.node_count(node_kind::Node4));
+  state.counters["node16"] = static_cast<double>(automaton.node_count(node_kind::Node16));
+  state.counters["node48"] = static_cast<double>(automaton.node_count(node_kind::Node48));
+  state.counters["node256"] = static_cast<double>(automaton.node_count(node_kind::Node256));
+}
+
+} // namespace yafiyogi::benchmark
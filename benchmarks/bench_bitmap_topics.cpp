@@ -0,0 +1,189 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "fmt/format.h"
+
+#include "yy_mqtt_bitmap_topics.h"
+#include "yy_mqtt_louds_topics.h"
+#include "yy_mqtt_tuple_topics.h"
+
+#include "bench_yy_mqtt.h"
+
+namespace yafiyogi::benchmark {
+namespace {
+
+using BitmapTopics = yafiyogi::yy_mqtt::bitmap_topics<int>;
+using LoudsTopics = yafiyogi::yy_mqtt::louds_topics<int>;
+using TupleTopics = yafiyogi::yy_mqtt::tuple_topics<int>;
+
+constexpr uint32_t sites = 256;
+constexpr uint32_t properties = 8;
+
+[[nodiscard]]
+uint32_t site_of(uint32_t p_device) noexcept
+{
+  return (p_device * 2654435761U) >> 24;
+}
+
+// Three in four filters have a wildcard, e.g. '3f/+/2' or '+/0012ab/#'.
+// Names are short enough to stay in std::string's own buffer, so 10M
+// filters fit in memory.
+std::vector<std::string> dense_filters(int64_t p_filters)
+{
+  std::vector<std::string> filters{};
+  filters.reserve(static_cast<size_t>(p_filters));
+
+  for(uint32_t idx = 0; static_cast<int64_t>(filters.size()) < p_filters; ++idx)
+  {
+    const uint32_t device = idx / 4;
+    const auto site = site_of(device);
+    const auto property = device % properties;
+
+    switch(idx % 4)
+    {
+      case 0:
+        filters.emplace_back(fmt::format("{:02x}/{:06x}/{}", site, device, property));
+        break;
+
+      case 1:
+        filters.emplace_back(fmt::format("+/{:06x}/{}", device, property));
+        break;
+
+      case 2:
+        filters.emplace_back(fmt::format("{:02x}/{:06x}/+", site, device));
+        break;
+
+      default:
+        filters.emplace_back(fmt::format("+/{:06x}/#", device));
+        break;
+    }
+  }
+
+  for(uint32_t property = 0; property < properties; ++property)
+  {
+    filters.emplace_back(fmt::format("+/+/{}", property));
+  }
+  for(uint32_t site = 0; site < sites; ++site)
+  {
+    filters.emplace_back(fmt::format("{:02x}/#", site));
+  }
+
+  return filters;
+}
+
+// Half the topics come from devices with filters.
+std::vector<std::string> dense_topics(int64_t p_filters)
+{
+  std::vector<std::string> l_topics{};
+
+  uint32_t seed = 54321;
+  for(int lookup = 0; lookup < 10000; ++lookup)
+  {
+    seed = (seed * 1664525) + 1013904223;
+    const auto device = seed % static_cast<uint32_t>(p_filters / 2);
+
+    l_topics.emplace_back(fmt::format("{:02x}/{:06x}/{}", site_of(device), device, device % properties));
+  }
+
+  return l_topics;
+}
+
+template<typename TopicsType>
+void dense_lookup(::benchmark::State & state)
+{
+  const auto l_topics{dense_topics(state.range(0))};
+
+  auto automaton = [&state]() {
+    TopicsType topics{};
+    int value = 0;
+    for(const auto & filter : dense_filters(state.range(0)))
+    {
+      topics.add(filter, ++value);
+    }
+
+    return topics.create_automaton();
+  }();
+
+  size_t idx = 0;
+  size_t matches = 0;
+  for(auto _ : state)
+  {
+    auto payloads = automaton.find(l_topics[idx]);
+    ::benchmark::DoNotOptimize(payloads);
+    matches += payloads.size();
+
+    if(++idx == l_topics.size())
+    {
+      idx = 0;
+    }
+  }
+
+  state.counters["matches"] = ::benchmark::Counter(static_cast<double>(matches), ::benchmark::Counter::kAvgIterations);
+  if constexpr(requires { automaton.memory_size(); })
+  {
+    state.counters["bytes_per_filter"] = static_cast<double>(automaton.memory_size()) / static_cast<double>(state.range(0));
+  }
+}
+
+} // namespace
+
+void bench_bitmap_dense(::benchmark::State & state)
+{
+  dense_lookup<BitmapTopics>(state);
+}
+
+void bench_radix_dense(::benchmark::State & state)
+{
+  dense_lookup<RadixTopics>(state);
+}
+
+void bench_louds_dense(::benchmark::State & state)
+{
+  dense_lookup<LoudsTopics>(state);
+}
+
+void bench_tuple_dense(::benchmark::State & state)
+{
+  dense_lookup<TupleTopics>(state);
+}
+
+void bench_faster_dense(::benchmark::State & state)
+{
+  dense_lookup<FasterTopics>(state);
+}
+
+// Arg 0: filters.
+BENCHMARK(bench_bitmap_dense)->Arg(1000000)->Arg(10000000);
+BENCHMARK(bench_radix_dense)->Arg(1000000)->Arg(10000000);
+BENCHMARK(bench_louds_dense)->Arg(1000000)->Arg(10000000);
+BENCHMARK(bench_tuple_dense)->Arg(1000000)->Arg(10000000);
+BENCHMARK(bench_faster_dense)->Arg(1000000)->Arg(10000000);
+
+} // namespace yafiyogi::benchmark
@@ -0,0 +1,110 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <string>
+
+#include "fmt/format.h"
+
+#include "bench_yy_mqtt.h"
+
+namespace yafiyogi::benchmark {
+
+BENCHMARK_F(TopicsFixtureType, dfa_lookup)(::benchmark::State & state)
+{
+  auto automaton = m_dfa_topics.create_automaton();
+
+  size_t idx = 0;
+  std::size_t count = 0;
+
+  while(state.KeepRunning())
+  {
+    auto payloads = automaton.find(TopicsFixtureType::query(idx));
+    ::benchmark::DoNotOptimize(payloads);
+    if(!payloads.empty())
+    {
+      ::benchmark::DoNotOptimize(++count);
+    }
+
+    ++idx;
+    idx = (idx % TopicsFixtureType::query_size());
+  }
+
+  state.counters["states"] = static_cast<double>(automaton.state_count());
+}
+
+BENCHMARK_F(TopicsFixtureType, dfa_compile)(::benchmark::State & state)
+{
+  while(state.KeepRunning())
+  {
+    auto automaton = m_dfa_topics.create_automaton();
+    ::benchmark::DoNotOptimize(automaton);
+  }
+}
+
+// Each filter has a '+' at a different level, so the number of
+// DFA states grows with the number of level combinations.
+static void dfa_state_explosion(::benchmark::State & state)
+{
+  const auto levels = static_cast<size_type>(state.range(0));
+  DfaTopics topics{};
+
+  for(size_type filter_no = 0; filter_no < levels; ++filter_no)
+  {
+    std::string filter{};
+    for(size_type level = 0; level < levels; ++level)
+    {
+      filter += (level == filter_no) ? "+" : fmt::format("l{}", level);
+      if(level + 1 < levels)
+      {
+        filter += '/';
+      }
+    }
+    topics.add(filter, static_cast<int>(filter_no));
+    topics.add(fmt::format("{}/#", filter), static_cast<int>(filter_no + levels));
+  }
+
+  std::string topic{};
+  for(size_type level = 0; level < levels; ++level)
+  {
+    topic += fmt::format("l{}/", level);
+  }
+  topic += "end";
+
+  auto automaton = topics.create_automaton();
+
+  while(state.KeepRunning())
+  {
+    auto payloads = automaton.find(topic);
+    ::benchmark::DoNotOptimize(payloads);
+  }
+
+  state.counters["states"] = static_cast<double>(automaton.state_count());
+  state.counters["fallback"] = automaton.fallback() ? 1.0 : 0.0;
+}
+
+BENCHMARK(dfa_state_explosion)->Arg(4)->Arg(8)->Arg(16)->Arg(32);
+
+} // namespace yafiyogi::benchmark
@@ -32,7 +32,9 @@ namespace yafiyogi::benchmark {
 
 BENCHMARK_F(TopicsFixtureType, fast_lookup)(::benchmark::State & state)
 {
+  const auto heap_before = heap_in_use();
   auto automaton = m_fast_topics.create_automaton();
+  const auto heap_bytes = heap_in_use() - heap_before;
 
   size_t idx = 0;
   std::size_t count = 0;
@@ -49,6 +51,8 @@ BENCHMARK_F(TopicsFixtureType, fast_lookup)(::benchmark::State & state)
     ++idx;
     idx = (idx % TopicsFixtureType::query_size());
   }
+
+  state.counters["heap_bytes"] = static_cast<double>(heap_bytes);
 }
 
 } // namespace yafiyogi::benchmark
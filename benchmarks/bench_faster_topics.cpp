@@ -24,6 +24,8 @@
 
 */
 
+#include <string>
+
 #include "fmt/format.h"
 
 #include "bench_yy_mqtt.h"
@@ -51,4 +53,55 @@ BENCHMARK_F(TopicsFixtureType, faster_lookup)(::benchmark::State & state)
   }
 }
 
+// Every '+' and '#' combination up to the topic depth, so each topic
+// level multiplies the number of live search states.
+static FasterTopics adversarial_topics(size_type p_depth)
+{
+  FasterTopics topics{};
+  int count = 0;
+
+  for(size_type mask = 0; mask < (size_type{1} << p_depth); ++mask)
+  {
+    std::string filter{};
+    for(size_type level = 0; level < p_depth; ++level)
+    {
+      filter += (0 != (mask & (size_type{1} << level))) ? "+/" : fmt::format("l{}/", level);
+    }
+    topics.add(filter + "#", ++count);
+  }
+
+  return topics;
+}
+
+static void faster_lookup_adversarial(::benchmark::State & state,
+                                      yy_mqtt::TopicSearchLimits limits)
+{
+  const auto depth = static_cast<size_type>(state.range(0));
+  auto automaton = adversarial_topics(depth).create_automaton();
+  automaton.limits(limits);
+
+  std::string topic{};
+  for(size_type level = 0; level < depth; ++level)
+  {
+    topic += fmt::format("l{}/", level);
+  }
+  topic += "end";
+
+  std::size_t matches = 0;
+  while(state.KeepRunning())
+  {
+    auto payloads = automaton.find(topic);
+    ::benchmark::DoNotOptimize(payloads);
+    matches = payloads.size();
+  }
+
+  state.counters["matches"] = static_cast<double>(matches);
+  state.counters["limited"] = (yy_mqtt::TopicSearchStatus::Ok == automaton.status()) ? 0.0 : 1.0;
+}
+
+BENCHMARK_CAPTURE(faster_lookup_adversarial, unlimited, yy_mqtt::TopicSearchLimits{})
+  ->DenseRange(2, 12, 2);
+BENCHMARK_CAPTURE(faster_lookup_adversarial, limited, yy_mqtt::TopicSearchLimits{.max_levels = 16, .max_states = 256})
+  ->DenseRange(2, 12, 2);
+
 } // namespace yafiyogi::benchmark
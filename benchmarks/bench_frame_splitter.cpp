@@ -0,0 +1,149 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <cstdlib>
+#include <cstring>
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "fmt/format.h"
+
+#include "yy_mqtt_frame_splitter.h"
+
+#include "bench_yy_mqtt.h"
+
+namespace yafiyogi::benchmark {
+namespace {
+
+// Raw MQTT bytes, e.g. a TCP stream saved from a capture, named by
+// YY_MQTT_STREAM_FILE. Without one, the captured PUBLISH packets
+// repeated to 1MB.
+const std::string & stream_bytes()
+{
+  static const std::string bytes = [] {
+    if(const char * file_name = std::getenv("YY_MQTT_STREAM_FILE");
+       nullptr != file_name)
+    {
+      std::ifstream file{file_name, std::ios::binary};
+      return std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    }
+
+    std::string l_bytes{};
+    while(l_bytes.size() < (1 << 20))
+    {
+      l_bytes.append(captured_publish());
+    }
+
+    return l_bytes;
+  }();
+
+  return bytes;
+}
+
+// Read sizes as a non-blocking socket might return them.
+std::vector<size_t> chunk_sizes(size_t p_max_chunk)
+{
+  std::mt19937 gen{3};
+  std::uniform_int_distribution<size_t> chunk{1, p_max_chunk};
+
+  std::vector<size_t> sizes{};
+  for(int idx = 0; idx < 4096; ++idx)
+  {
+    sizes.emplace_back(chunk(gen));
+  }
+
+  return sizes;
+}
+
+} // namespace
+
+// Split the whole stream per iteration, reading it in random sized
+// chunks of up to state.range(0) bytes.
+void frame_split(::benchmark::State & state)
+{
+  const std::string_view stream{stream_bytes()};
+  const auto sizes{chunk_sizes(static_cast<size_t>(state.range(0)))};
+  yy_mqtt::frame_splitter splitter{64 * 1024};
+
+  size_t packets = 0;
+  size_t chunk_idx = 0;
+
+  bool failed = false;
+  for(auto _ : state)
+  {
+    size_t pos = 0;
+    while(!failed && (pos < stream.size()))
+    {
+      auto space = splitter.prepare();
+      const auto count = std::min({space.size(), sizes[chunk_idx], stream.size() - pos});
+      chunk_idx = (chunk_idx + 1) % sizes.size();
+
+      std::memcpy(space.data(), stream.data() + pos, count);
+      splitter.commit(count);
+      pos += count;
+
+      std::string_view packet{};
+      auto status = splitter.next(packet);
+      while(yy_mqtt::FrameStatus::Ok == status)
+      {
+        ::benchmark::DoNotOptimize(packet);
+        ++packets;
+        status = splitter.next(packet);
+      }
+
+      // A bad packet is never consumed, so the ring would fill and
+      // the loop spin on empty reads.
+      if(yy_mqtt::FrameStatus::NeedMore != status)
+      {
+        state.SkipWithError(yy_mqtt::FrameStatus::Malformed == status
+                            ? "malformed packet in stream"
+                            : "packet larger than the ring buffer in stream");
+        failed = true;
+      }
+    }
+
+    if(failed)
+    {
+      break;
+    }
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * stream.size()));
+  state.counters["packets"] = ::benchmark::Counter(static_cast<double>(packets),
+                                                   ::benchmark::Counter::kAvgIterations);
+  state.counters["straddled"] = ::benchmark::Counter(static_cast<double>(splitter.straddled()),
+                                                     ::benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(frame_split)->RangeMultiplier(8)->Range(8, 32 * 1024)->Unit(::benchmark::kMicrosecond);
+
+} // namespace yafiyogi::benchmark
@@ -0,0 +1,198 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "fmt/format.h"
+
+#include "yy_mqtt_huge_pages.h"
+
+#include "bench_yy_mqtt.h"
+
+namespace yafiyogi::benchmark {
+namespace {
+
+// User space dTLB read misses of the calling thread. Where perf
+// events are unavailable (e.g. perf_event_paranoid, containers) the
+// counter is not opened and the benchmark reports timings only.
+class dtlb_counter final
+{
+  public:
+    dtlb_counter() noexcept
+    {
+      perf_event_attr attr{};
+      attr.size = sizeof(attr);
+      attr.type = PERF_TYPE_HW_CACHE;
+      attr.config = PERF_COUNT_HW_CACHE_DTLB
+        | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+        | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+      attr.disabled = 1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+
+      m_fd = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    dtlb_counter(const dtlb_counter &) = delete;
+    dtlb_counter(dtlb_counter &&) = delete;
+    ~dtlb_counter() noexcept
+    {
+      if(valid())
+      {
+        ::close(m_fd);
+      }
+    }
+
+    dtlb_counter & operator=(const dtlb_counter &) = delete;
+    dtlb_counter & operator=(dtlb_counter &&) = delete;
+
+    [[nodiscard]]
+    bool valid() const noexcept
+    {
+      return m_fd >= 0;
+    }
+
+    void start() noexcept
+    {
+      if(valid())
+      {
+        ::ioctl(m_fd, PERF_EVENT_IOC_RESET, 0);
+        ::ioctl(m_fd, PERF_EVENT_IOC_ENABLE, 0);
+      }
+    }
+
+    [[nodiscard]]
+    uint64_t stop() noexcept
+    {
+      uint64_t count = 0;
+      if(valid())
+      {
+        ::ioctl(m_fd, PERF_EVENT_IOC_DISABLE, 0);
+        if(sizeof(count) != ::read(m_fd, &count, sizeof(count)))
+        {
+          count = 0;
+        }
+      }
+
+      return count;
+    }
+
+  private:
+    int m_fd = -1;
+};
+
+// Enough distinct filters for the radix tables to span many 4 KB
+// pages, e.g. 'fleet12/vehicle0345/engine/oil temperature'.
+const std::vector<std::string> & fleet_topics()
+{
+  static const std::vector<std::string> l_topics = [] {
+    static constexpr std::string_view sensors[] = {"engine/oil temperature", "engine/coolant temperature", "tyres/front left pressure", "tyres/rear right pressure", "cabin/humidity"};
+
+    std::vector<std::string> topics{};
+    for(int fleet = 0; fleet < 64; ++fleet)
+    {
+      for(int vehicle = 0; vehicle < 512; ++vehicle)
+      {
+        for(const auto sensor : sensors)
+        {
+          topics.emplace_back(fmt::format("fleet{}/vehicle{:04}/{}", fleet, vehicle, sensor));
+        }
+      }
+    }
+
+    return topics;
+  }();
+
+  return l_topics;
+}
+
+const RadixTopics & fleet_filters()
+{
+  static const RadixTopics l_filters = [] {
+    RadixTopics filters{};
+    int value = 0;
+    for(const auto & topic : fleet_topics())
+    {
+      filters.add(topic, ++value);
+    }
+    filters.add("fleet7/+/engine/#", ++value);
+
+    return filters;
+  }();
+
+  return l_filters;
+}
+
+} // namespace
+
+// Arg 0: 0 normal pages, 1 transparent huge pages, 2 hugetlbfs.
+void bench_radix_huge_pages(::benchmark::State & state)
+{
+  const auto pages = static_cast<yy_mqtt::HugePages>(state.range(0));
+  const auto & l_topics = fleet_topics();
+  auto automaton = fleet_filters().create_automaton(pages);
+
+  // Random order, so consecutive lookups touch unrelated pages.
+  std::vector<uint32_t> order(l_topics.size());
+  uint32_t seed = 12345;
+  for(auto & idx : order)
+  {
+    seed = (seed * 1664525) + 1013904223;
+    idx = seed % static_cast<uint32_t>(l_topics.size());
+  }
+
+  dtlb_counter dtlb{};
+  size_t idx = 0;
+
+  dtlb.start();
+  for(auto _ : state)
+  {
+    auto payloads = automaton.find(l_topics[order[idx]]);
+    ::benchmark::DoNotOptimize(payloads);
+
+    ++idx;
+    idx = (idx % order.size());
+  }
+  const auto misses = dtlb.stop();
+
+  state.counters["backing"] = static_cast<double>(automaton.backing());
+  state.counters["table_bytes"] = static_cast<double>(automaton.memory_size());
+  if(dtlb.valid())
+  {
+    state.counters["dtlb_misses"] = ::benchmark::Counter(static_cast<double>(misses), ::benchmark::Counter::kAvgIterations);
+  }
+}
+
+BENCHMARK(bench_radix_huge_pages)->Arg(0)->Arg(1)->Arg(2);
+
+} // namespace yafiyogi::benchmark
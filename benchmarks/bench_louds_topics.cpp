@@ -0,0 +1,127 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "fmt/format.h"
+
+#include "yy_mqtt_louds_topics.h"
+
+#include "bench_yy_mqtt.h"
+
+namespace yafiyogi::benchmark {
+namespace {
+
+using LoudsTopics = yafiyogi::yy_mqtt::louds_topics<int>;
+
+// Mostly literal archive filters, e.g.
+// 'archive/site017/0x00158d0004a3f1c2/local_temperature'.
+std::vector<std::string> archive_filters(int64_t p_filters)
+{
+  static constexpr std::string_view properties[] = {"battery", "linkquality", "local_temperature", "position", "state"};
+
+  std::vector<std::string> filters{};
+  filters.reserve(static_cast<size_t>(p_filters));
+
+  uint64_t device = 0x00158d0000000000ULL;
+  for(int64_t idx = 0; static_cast<int64_t>(filters.size()) < p_filters; ++idx)
+  {
+    device += 7919;
+    for(const auto property : properties)
+    {
+      filters.emplace_back(fmt::format("archive/site{:03}/0x{:016x}/{}", idx % 100, device, property));
+    }
+  }
+  filters.resize(static_cast<size_t>(p_filters));
+
+  return filters;
+}
+
+template<typename TopicsType,
+         typename CreateFn>
+void archive_lookup(::benchmark::State & state,
+                    CreateFn && p_create)
+{
+  const auto filters{archive_filters(state.range(0))};
+
+  TopicsType topics{};
+  int value = 0;
+  for(const auto & filter : filters)
+  {
+    topics.add(filter, ++value);
+  }
+  topics.add("archive/+/+/battery", ++value);
+  topics.add("archive/site042/#", ++value);
+
+  auto automaton = p_create(topics);
+
+  size_t idx = 0;
+  uint32_t seed = 12345;
+  for(auto _ : state)
+  {
+    auto payloads = automaton.find(filters[idx]);
+    ::benchmark::DoNotOptimize(payloads);
+
+    seed = (seed * 1664525) + 1013904223;
+    idx = seed % filters.size();
+  }
+
+  if constexpr(requires { automaton.memory_size(); })
+  {
+    state.counters["bytes_per_filter"] = static_cast<double>(automaton.memory_size()) / static_cast<double>(filters.size());
+  }
+}
+
+} // namespace
+
+void bench_louds_archive(::benchmark::State & state)
+{
+  archive_lookup<LoudsTopics>(state, [](const LoudsTopics & topics) {
+    return topics.create_automaton();
+  });
+}
+
+void bench_radix_tree_archive(::benchmark::State & state)
+{
+  archive_lookup<RadixTopics>(state, [](const RadixTopics & topics) {
+    return topics.create_automaton(yy_mqtt::HugePages::Off, RadixTopics::RadixLayout::Tree);
+  });
+}
+
+void bench_faster_archive(::benchmark::State & state)
+{
+  archive_lookup<FasterTopics>(state, [](const FasterTopics & topics) {
+    return topics.create_automaton();
+  });
+}
+
+BENCHMARK(bench_louds_archive)->RangeMultiplier(10)->Range(10000, 1000000);
+BENCHMARK(bench_radix_tree_archive)->RangeMultiplier(10)->Range(10000, 1000000);
+BENCHMARK(bench_faster_archive)->RangeMultiplier(10)->Range(10000, 1000000);
+
+} // namespace yafiyogi::benchmark
@@ -0,0 +1,107 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "fmt/format.h"
+
+#include "yy_mqtt_match_pool.h"
+
+#include "bench_yy_mqtt.h"
+
+namespace yafiyogi::benchmark {
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+using FasterQuery = decltype(std::declval<const FasterTopics &>().create_automaton());
+using Pool = yy_mqtt::match_pool<FasterQuery, clock_type::time_point>;
+
+// Skewed load: half the messages go to 8 hot topics, the rest are
+// spread over the fixture's topics.
+const std::vector<std::string> & skewed_topics()
+{
+  static const std::vector<std::string> topics = [] {
+    std::mt19937 gen{17};
+    std::uniform_int_distribution<int> coin{0, 1};
+    std::uniform_int_distribution<size_t> hot{0, 7};
+    std::uniform_int_distribution<size_t> cold{0, TopicsFixtureType::query_size() - 1};
+
+    std::vector<std::string> l_topics{};
+    for(int idx = 0; idx < 8192; ++idx)
+    {
+      const auto query_idx = (0 == coin(gen)) ? hot(gen) : cold(gen);
+      l_topics.emplace_back(TopicsFixtureType::query(query_idx));
+    }
+
+    return l_topics;
+  }();
+
+  return topics;
+}
+
+} // namespace
+
+// Arg 0: 1 to steal, 0 for topics pinned to their hashed worker.
+BENCHMARK_DEFINE_F(TopicsFixtureType, match_pool_skewed)(::benchmark::State & state)
+{
+  yy_mqtt::match_pool_options options{};
+  options.workers = 4;
+  options.steal = 0 != state.range(0);
+
+  std::atomic<int64_t> latency_ns{0};
+  const auto & topics = skewed_topics();
+
+  Pool pool{[]() { return TopicsFixtureType::m_faster_topics.create_automaton(); },
+            [&latency_ns](std::string_view, const clock_type::time_point & p_posted, auto p_payloads) {
+              ::benchmark::DoNotOptimize(p_payloads);
+              const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - p_posted);
+              latency_ns.fetch_add(elapsed.count(), std::memory_order_relaxed);
+            },
+            options};
+
+  for(auto _ : state)
+  {
+    for(const auto & topic : topics)
+    {
+      pool.post(topic, clock_type::now());
+    }
+    pool.flush();
+  }
+
+  const auto messages = static_cast<double>(state.iterations() * topics.size());
+  state.SetItemsProcessed(static_cast<int64_t>(messages));
+  state.counters["latency_ns"] = static_cast<double>(latency_ns.load()) / messages;
+  state.counters["steals"] = static_cast<double>(pool.steals());
+}
+
+BENCHMARK_REGISTER_F(TopicsFixtureType, match_pool_skewed)->Arg(0)->Arg(1)->UseRealTime();
+
+} // namespace yafiyogi::benchmark
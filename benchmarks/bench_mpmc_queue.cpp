@@ -0,0 +1,121 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "yy_mqtt_mpmc_queue.h"
+
+#include "bench_yy_mqtt.h"
+
+namespace yafiyogi::benchmark {
+namespace {
+
+using Message = std::shared_ptr<const std::string>;
+using Delivery = yy_mqtt::delivery<const int *, Message>;
+
+const Message & message()
+{
+  static const Message l_message = std::make_shared<const std::string>("payload");
+
+  return l_message;
+}
+
+// Baseline: the mutex protected deque the queue replaces.
+class locked_deque final
+{
+  public:
+    void push(Delivery p_delivery)
+    {
+      std::lock_guard lock{m_mutex};
+      m_deque.emplace_back(std::move(p_delivery));
+    }
+
+    bool pop(Delivery & p_delivery)
+    {
+      std::lock_guard lock{m_mutex};
+      if(m_deque.empty())
+      {
+        return false;
+      }
+      p_delivery = std::move(m_deque.front());
+      m_deque.pop_front();
+      return true;
+    }
+
+  private:
+    std::mutex m_mutex{};
+    std::deque<Delivery> m_deque{};
+};
+
+const int subscriber = 1;
+
+} // namespace
+
+// Every thread both produces and consumes, so each push contends with
+// the pushes and pops of all the other threads.
+void mpmc_queue_push_pop(::benchmark::State & state)
+{
+  static yy_mqtt::delivery_queue<const int *, Message> queue{1024};
+  Delivery popped{};
+
+  for(auto _ : state)
+  {
+    while(!queue.try_push(Delivery{&subscriber, message()}))
+    {
+    }
+    while(!queue.try_pop(popped))
+    {
+    }
+    ::benchmark::DoNotOptimize(popped.value);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+void locked_deque_push_pop(::benchmark::State & state)
+{
+  static locked_deque queue{};
+  Delivery popped{};
+
+  for(auto _ : state)
+  {
+    queue.push(Delivery{&subscriber, message()});
+    while(!queue.pop(popped))
+    {
+    }
+    ::benchmark::DoNotOptimize(popped.value);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(mpmc_queue_push_pop)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK(locked_deque_push_pop)->ThreadRange(1, 32)->UseRealTime();
+
+} // namespace yafiyogi::benchmark
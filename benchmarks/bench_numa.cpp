@@ -0,0 +1,106 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <memory>
+#include <thread>
+
+#include "yy_mqtt_numa.h"
+
+#include "bench_yy_mqtt.h"
+
+namespace yafiyogi::benchmark {
+namespace {
+
+using FasterQuery = decltype(std::declval<const FasterTopics &>().create_automaton());
+
+// One run per node, with the automaton built on the reader's node
+// (local) and on the next node (remote). A single node machine only
+// has the local run.
+void numa_args(::benchmark::internal::Benchmark * p_bench)
+{
+  const auto nodes = static_cast<int64_t>(yy_mqtt::numa_topology::system().node_count());
+
+  for(int64_t node = 0; node < nodes; ++node)
+  {
+    p_bench->Args({node, 0});
+    if(nodes > 1)
+    {
+      p_bench->Args({node, 1});
+    }
+  }
+}
+
+// Builds the automaton on a thread pinned to p_node, so first touch
+// places it in that node's memory.
+std::unique_ptr<FasterQuery> build_on(size_t p_node)
+{
+  std::unique_ptr<FasterQuery> query{};
+
+  std::thread{[&query, p_node]() {
+    std::ignore = yy_mqtt::numa_topology::system().pin_to_node(p_node);
+    query.reset(new FasterQuery(TopicsFixtureType::m_faster_topics.create_automaton()));
+  }}.join();
+
+  return query;
+}
+
+} // namespace
+
+BENCHMARK_DEFINE_F(TopicsFixtureType, numa_faster_lookup)(::benchmark::State & state)
+{
+  const auto & topology = yy_mqtt::numa_topology::system();
+  const auto node = static_cast<size_t>(state.range(0));
+  const auto data_node = (node + static_cast<size_t>(state.range(1))) % topology.node_count();
+
+  auto automaton = build_on(data_node);
+
+  // Restored after the run, so later benchmarks are not left pinned.
+  cpu_set_t affinity;
+  ::pthread_getaffinity_np(::pthread_self(), sizeof(affinity), &affinity);
+  const bool pinned = topology.pin_to_node(node);
+
+  size_t idx = 0;
+  for(auto _ : state)
+  {
+    auto payloads = automaton->find(TopicsFixtureType::query(idx));
+    ::benchmark::DoNotOptimize(payloads);
+
+    ++idx;
+    idx = (idx % TopicsFixtureType::query_size());
+  }
+
+  ::pthread_setaffinity_np(::pthread_self(), sizeof(affinity), &affinity);
+
+  state.counters["nodes"] = static_cast<double>(topology.node_count());
+  state.counters["pinned"] = pinned ? 1.0 : 0.0;
+}
+
+BENCHMARK_REGISTER_F(TopicsFixtureType, numa_faster_lookup)->Apply(numa_args);
+
+} // namespace yafiyogi::benchmark
@@ -0,0 +1,146 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "fmt/format.h"
+
+#include "yy_mqtt_owner_topics.h"
+
+#include "bench_alloc_count.h"
+#include "bench_yy_mqtt.h"
+
+namespace yafiyogi::benchmark {
+namespace {
+
+struct Subscription final
+{
+    yy_mqtt::owner_id_type owner_id = 0;
+};
+
+using OwnerFasterTopics = yafiyogi::yy_mqtt::faster_topics<Subscription>;
+
+// 500 owners, each with several overlapping filters in one site.
+template<typename Builder>
+void add_overlapping(Builder & p_topics)
+{
+  std::mt19937 gen{7};
+  std::uniform_int_distribution<int> room{0, 9};
+  std::uniform_int_distribution<int> device{0, 9};
+
+  for(yy_mqtt::owner_id_type owner = 0; owner < 500; ++owner)
+  {
+    const auto owner_room = room(gen);
+    p_topics.add(fmt::format("o{}/site/#", owner), Subscription{owner});
+    p_topics.add(fmt::format("o{}/site/room{}/#", owner, owner_room), Subscription{owner});
+    p_topics.add(fmt::format("o{}/site/room{}/+/Temp", owner, owner_room), Subscription{owner});
+    p_topics.add(fmt::format("o{}/site/room{}/device{}/+", owner, owner_room, device(gen)), Subscription{owner});
+  }
+}
+
+const std::vector<std::string> & owner_queries()
+{
+  static const std::vector<std::string> queries = [] {
+    std::mt19937 gen{11};
+    std::uniform_int_distribution<int> owner{0, 499};
+    std::uniform_int_distribution<int> room{0, 9};
+    std::uniform_int_distribution<int> device{0, 9};
+
+    std::vector<std::string> l_queries{};
+    for(int idx = 0; idx < 256; ++idx)
+    {
+      l_queries.emplace_back(fmt::format("o{}/site/room{}/device{}/Temp", owner(gen), room(gen), device(gen)));
+    }
+
+    return l_queries;
+  }();
+
+  return queries;
+}
+
+} // namespace
+
+// Dedup by hash set after each lookup.
+void owner_hash_set_lookup(::benchmark::State & state)
+{
+  OwnerFasterTopics topics{};
+  add_overlapping(topics);
+  auto automaton = topics.create_automaton();
+  const auto & queries = owner_queries();
+
+  std::unordered_set<yy_mqtt::owner_id_type> seen{};
+  size_t idx = 0;
+  alloc_counter allocs{};
+
+  for(auto _ : state)
+  {
+    seen.clear();
+    for(auto payload : automaton.find(queries[idx]))
+    {
+      if(seen.insert(payload->owner_id).second)
+      {
+        ::benchmark::DoNotOptimize(payload);
+      }
+    }
+
+    ++idx;
+    idx = (idx % queries.size());
+  }
+
+  allocs.report(state);
+}
+
+void owner_dedup_lookup(::benchmark::State & state)
+{
+  yy_mqtt::owner_topics<OwnerFasterTopics> topics{};
+  add_overlapping(topics);
+  auto automaton = topics.create_automaton();
+  const auto & queries = owner_queries();
+
+  size_t idx = 0;
+  alloc_counter allocs{};
+
+  for(auto _ : state)
+  {
+    for(auto payload : automaton.find(queries[idx]))
+    {
+      ::benchmark::DoNotOptimize(payload);
+    }
+
+    ++idx;
+    idx = (idx % queries.size());
+  }
+
+  allocs.report(state);
+}
+
+BENCHMARK(owner_hash_set_lookup);
+BENCHMARK(owner_dedup_lookup);
+
+} // namespace yafiyogi::benchmark
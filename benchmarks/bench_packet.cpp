@@ -0,0 +1,149 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <string>
+#include <string_view>
+#include <tuple>
+
+#include "fmt/format.h"
+
+#include "yy_mqtt_packet.h"
+
+#include "bench_yy_mqtt.h"
+
+namespace yafiyogi::benchmark {
+namespace {
+
+void append_u16(std::string & p_bytes,
+                size_t p_value)
+{
+  p_bytes.push_back(static_cast<char>((p_value >> 8) & 0xFF));
+  p_bytes.push_back(static_cast<char>(p_value & 0xFF));
+}
+
+void append_vbi(std::string & p_bytes,
+                size_t p_value)
+{
+  do
+  {
+    auto byte = static_cast<char>(p_value & 0x7F);
+    p_value >>= 7;
+    if(0 != p_value)
+    {
+      byte = static_cast<char>(byte | 0x80);
+    }
+    p_bytes.push_back(byte);
+  } while(0 != p_value);
+}
+
+} // namespace
+
+const std::string & captured_publish()
+{
+  static const std::string bytes = [] {
+    std::string l_bytes{};
+    const std::string_view payload{"{\"temperature\":21.5,\"humidity\":40}"};
+    const std::string_view properties{"\x01\x01", 2}; // Payload Format Indicator.
+
+    for(size_t idx = 0; idx < TopicsFixtureType::query_size(); ++idx)
+    {
+      const auto topic = TopicsFixtureType::query(idx);
+      if(topic.empty())
+      {
+        continue;
+      }
+
+      std::string body{};
+      append_u16(body, topic.size());
+      body.append(topic);
+      append_u16(body, idx + 1);
+      append_vbi(body, properties.size());
+      body.append(properties);
+      body.append(payload);
+
+      l_bytes.push_back(static_cast<char>(0x32));
+      append_vbi(l_bytes, body.size());
+      l_bytes.append(body);
+    }
+
+    return l_bytes;
+  }();
+
+  return bytes;
+}
+
+BENCHMARK_F(TopicsFixtureType, packet_decode)(::benchmark::State & state)
+{
+  const std::string_view bytes{captured_publish()};
+  size_t pos = 0;
+  yy_mqtt::PublishPacket publish{};
+
+  while(state.KeepRunning())
+  {
+    const auto packet{bytes.substr(pos)};
+    yy_mqtt::FixedHeader header{};
+    std::ignore = yy_mqtt::decode_fixed_header(packet, header);
+    ::benchmark::DoNotOptimize(yy_mqtt::decode_publish(packet, yy_mqtt::ProtocolVersion::V5, publish));
+    ::benchmark::DoNotOptimize(publish);
+
+    pos += header.packet_size();
+    pos = (pos == bytes.size()) ? 0 : pos;
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes.size() / TopicsFixtureType::query_size()));
+}
+
+// Decode each PUBLISH and match its topic straight from the buffer.
+BENCHMARK_F(TopicsFixtureType, packet_decode_lookup)(::benchmark::State & state)
+{
+  auto automaton = m_faster_topics.create_automaton();
+  const std::string_view bytes{captured_publish()};
+  size_t pos = 0;
+  std::size_t count = 0;
+  yy_mqtt::PublishPacket publish{};
+
+  while(state.KeepRunning())
+  {
+    const auto packet{bytes.substr(pos)};
+    yy_mqtt::FixedHeader header{};
+    std::ignore = yy_mqtt::decode_fixed_header(packet, header);
+
+    if(yy_mqtt::DecodeStatus::Ok == yy_mqtt::decode_publish(packet, yy_mqtt::ProtocolVersion::V5, publish))
+    {
+      auto payloads = automaton.find(publish.topic);
+      ::benchmark::DoNotOptimize(payloads);
+      if(!payloads.empty())
+      {
+        ::benchmark::DoNotOptimize(++count);
+      }
+    }
+
+    pos += header.packet_size();
+    pos = (pos == bytes.size()) ? 0 : pos;
+  }
+}
+
+} // namespace yafiyogi::benchmark
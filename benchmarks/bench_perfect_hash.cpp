@@ -0,0 +1,95 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "fmt/format.h"
+
+#include "bench_yy_mqtt.h"
+
+namespace yafiyogi::benchmark {
+namespace {
+
+// e.g. 'zigbee2mqtt/0x00158d0000012345/state'.
+std::vector<std::string> device_topics(int64_t p_devices)
+{
+  std::vector<std::string> l_topics{};
+  l_topics.reserve(static_cast<size_t>(p_devices));
+
+  for(int64_t device = 0; device < p_devices; ++device)
+  {
+    l_topics.emplace_back(fmt::format("zigbee2mqtt/0x00158d{:010x}/state", device * 7919));
+  }
+
+  return l_topics;
+}
+
+} // namespace
+
+// Arg 0: children of the 'zigbee2mqtt' state.
+// Arg 1: 0 sorted edges and binary search, 1 perfect hash.
+void bench_dfa_fan_out(::benchmark::State & state)
+{
+  const auto l_topics{device_topics(state.range(0))};
+  const auto hash_min_edges = (0 == state.range(1)) ? std::numeric_limits<size_type>::max() : DfaTopics::default_hash_min_edges;
+
+  DfaTopics topics{size_type{1} << 20, hash_min_edges};
+  int value = 0;
+  for(const auto & topic : l_topics)
+  {
+    topics.add(topic, ++value);
+  }
+  topics.add("zigbee2mqtt/+/availability", ++value);
+
+  auto automaton = topics.create_automaton();
+
+  // Every other lookup misses, as for devices without a subscription.
+  std::vector<std::string> queries{};
+  for(size_t idx = 0; idx < l_topics.size(); ++idx)
+  {
+    queries.emplace_back((0 == (idx % 2)) ? l_topics[idx] : fmt::format("zigbee2mqtt/0x00158e{:010x}/state", idx));
+  }
+
+  size_t idx = 0;
+  uint32_t seed = 12345;
+  for(auto _ : state)
+  {
+    auto payloads = automaton.find(queries[idx]);
+    ::benchmark::DoNotOptimize(payloads);
+
+    seed = (seed * 1664525) + 1013904223;
+    idx = seed % queries.size();
+  }
+
+  state.counters["fallback"] = automaton.fallback() ? 1.0 : 0.0;
+}
+
+BENCHMARK(bench_dfa_fan_out)->ArgsProduct({{10, 100, 1000, 10000, 100000}, {0, 1}});
+
+} // namespace yafiyogi::benchmark
@@ -0,0 +1,145 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <random>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "fmt/format.h"
+
+#include "yy_mqtt_pruned_topics.h"
+
+#include "bench_yy_mqtt.h"
+
+namespace yafiyogi::benchmark {
+namespace {
+
+using PrunedTopics = yy_mqtt::pruned_topics<FasterTopics>;
+
+struct overlap_corpus final
+{
+    std::vector<std::tuple<std::string, int>> filters{};
+    std::vector<std::string> queries{};
+};
+
+// Each owner subscribes to a site wide '#', some room level filters
+// and some device filters that the wider ones already cover. The
+// engines keep one value per filter, so equal filters from different
+// owners collapse the same way in both builds.
+const overlap_corpus & corpus()
+{
+  static const overlap_corpus l_corpus = [] {
+    overlap_corpus data{};
+    std::mt19937 gen{42};
+    std::uniform_int_distribution<int> site{0, 3};
+    std::uniform_int_distribution<int> room{0, 9};
+    std::uniform_int_distribution<int> device{0, 9};
+
+    for(int owner = 0; owner < 200; ++owner)
+    {
+      const int owner_site = site(gen);
+      data.filters.emplace_back(fmt::format("site{}/#", owner_site), owner);
+
+      for(int idx = 0; idx < 3; ++idx)
+      {
+        const int owner_room = room(gen);
+        data.filters.emplace_back(fmt::format("site{}/room{}/+/Temp", owner_site, owner_room), owner);
+        data.filters.emplace_back(fmt::format("site{}/room{}/device{}/+", owner_site, owner_room, device(gen)), owner);
+        data.filters.emplace_back(fmt::format("site{}/room{}/device{}/Temp", owner_site, owner_room, device(gen)), owner);
+        data.filters.emplace_back(fmt::format("site{}/room{}/#", site(gen), owner_room), owner);
+      }
+    }
+
+    for(int idx = 0; idx < 256; ++idx)
+    {
+      data.queries.emplace_back(fmt::format("site{}/room{}/device{}/Temp", site(gen), room(gen), device(gen)));
+    }
+
+    return data;
+  }();
+
+  return l_corpus;
+}
+
+template<typename Builder>
+void overlap_lookup(::benchmark::State & state)
+{
+  const auto & data = corpus();
+
+  Builder topics{};
+  for(const auto & [filter, owner] : data.filters)
+  {
+    topics.add(filter, owner);
+  }
+
+  auto automaton = topics.create_automaton();
+
+  size_t idx = 0;
+  std::size_t payload_count = 0;
+
+  for(auto _ : state)
+  {
+    auto payloads = automaton.find(data.queries[idx]);
+    ::benchmark::DoNotOptimize(payloads);
+    payload_count += payloads.size();
+
+    ++idx;
+    idx = (idx % data.queries.size());
+  }
+
+  state.counters["filters"] = static_cast<double>(data.filters.size());
+  state.counters["payloads"] = ::benchmark::Counter(static_cast<double>(payload_count),
+                                                    ::benchmark::Counter::kAvgIterations);
+  if constexpr (std::is_same_v<Builder, PrunedTopics>)
+  {
+    state.counters["pruned"] = static_cast<double>(topics.pruned_count());
+  }
+}
+
+} // namespace
+
+void pruned_analysis(::benchmark::State & state)
+{
+  const auto & data = corpus();
+
+  for(auto _ : state)
+  {
+    PrunedTopics topics{};
+    for(const auto & [filter, owner] : data.filters)
+    {
+      topics.add(filter, owner);
+    }
+    ::benchmark::DoNotOptimize(topics.pruned_count());
+  }
+}
+
+BENCHMARK(overlap_lookup<FasterTopics>)->Name("overlap_lookup");
+BENCHMARK(overlap_lookup<PrunedTopics>)->Name("pruned_overlap_lookup");
+BENCHMARK(pruned_analysis)->Unit(::benchmark::kMillisecond);
+
+} // namespace yafiyogi::benchmark
@@ -0,0 +1,98 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "fmt/format.h"
+
+#include "bench_yy_mqtt.h"
+
+namespace yafiyogi::benchmark {
+namespace {
+
+using RadixLayout = RadixTopics::RadixLayout;
+
+// A fleet of TRVs, each publishing the same properties, e.g.
+// 'iot21/Room 0042/TRV/local_temperature'.
+std::vector<std::string> fleet_topics(int64_t p_devices)
+{
+  static constexpr std::string_view properties[] = {
+    "availability", "battery", "boost_heating", "boost_heating_countdown", "child_lock",
+    "current_heating_setpoint", "eco_mode", "eco_temperature", "linkquality", "local_temperature",
+    "local_temperature_calibration", "max_temperature", "min_temperature", "position", "preset",
+    "programming_mode", "running_state", "system_mode", "update-installed_version", "valve_state"};
+
+  std::vector<std::string> l_topics{};
+  for(int64_t device = 0; device < p_devices; ++device)
+  {
+    for(const auto property : properties)
+    {
+      l_topics.emplace_back(fmt::format("iot21/Room {:04}/TRV/{}", device, property));
+    }
+  }
+
+  return l_topics;
+}
+
+} // namespace
+
+// Arg 0: devices. Arg 1: 0 tree, 1 minimized.
+void bench_radix_minimize(::benchmark::State & state)
+{
+  const auto l_topics{fleet_topics(state.range(0))};
+  const auto layout = (0 == state.range(1)) ? RadixLayout::Tree : RadixLayout::Minimized;
+
+  RadixTopics topics{};
+  int value = 0;
+  for(const auto & topic : l_topics)
+  {
+    topics.add(topic, ++value);
+  }
+  topics.add("iot21/+/TRV/battery", ++value);
+  topics.add("iot21/Room 0001/#", ++value);
+
+  auto automaton = topics.create_automaton(yy_mqtt::HugePages::Off, layout);
+
+  size_t idx = 0;
+  uint32_t seed = 12345;
+  for(auto _ : state)
+  {
+    auto payloads = automaton.find(l_topics[idx]);
+    ::benchmark::DoNotOptimize(payloads);
+
+    seed = (seed * 1664525) + 1013904223;
+    idx = seed % l_topics.size();
+  }
+
+  state.counters["bytes"] = static_cast<double>(automaton.memory_size());
+  state.counters["nodes"] = static_cast<double>(automaton.node_count());
+}
+
+BENCHMARK(bench_radix_minimize)->ArgsProduct({{10, 100, 1000, 10000}, {0, 1}});
+
+} // namespace yafiyogi::benchmark
@@ -0,0 +1,121 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <string>
+#include <vector>
+
+#include "fmt/format.h"
+
+#include "bench_yy_mqtt.h"
+
+namespace yafiyogi::benchmark {
+namespace {
+
+// Long literal levels, e.g. 'iot21/Front Bedroom 3/Plug/Salt Lamp 7/state'.
+std::vector<std::string> long_topics()
+{
+  static constexpr std::string_view rooms[] = {"Front Bedroom", "Back Bedroom", "Living Room", "Kitchen Extension"};
+  static constexpr std::string_view devices[] = {"Plug/Salt Lamp", "Plug/Desk Fan", "Light/Ceiling Spot", "Sensor/Temperature Humidity"};
+
+  std::vector<std::string> l_topics{};
+  for(int floor = 0; floor < 8; ++floor)
+  {
+    for(const auto room : rooms)
+    {
+      for(const auto device : devices)
+      {
+        l_topics.emplace_back(fmt::format("iot21/{} {}/{}/state", room, floor, device));
+      }
+    }
+  }
+
+  return l_topics;
+}
+
+template<typename TopicsType>
+void long_topic_lookup(::benchmark::State & state)
+{
+  const auto l_topics{long_topics()};
+
+  TopicsType topics{};
+  int value = 0;
+  for(const auto & topic : l_topics)
+  {
+    topics.add(topic, ++value);
+  }
+  topics.add("iot21/+/Plug/+/state", ++value);
+  topics.add("iot21/Kitchen Extension 0/#", ++value);
+
+  auto automaton = topics.create_automaton();
+
+  size_t idx = 0;
+  std::size_t count = 0;
+
+  while(state.KeepRunning())
+  {
+    auto payloads = automaton.find(l_topics[idx]);
+    ::benchmark::DoNotOptimize(payloads);
+    if(!payloads.empty())
+    {
+      ::benchmark::DoNotOptimize(++count);
+    }
+
+    ++idx;
+    idx = (idx % l_topics.size());
+  }
+}
+
+} // namespace
+
+BENCHMARK_F(TopicsFixtureType, radix_lookup)(::benchmark::State & state)
+{
+  auto automaton = m_radix_topics.create_automaton();
+
+  size_t idx = 0;
+  std::size_t count = 0;
+
+  while(state.KeepRunning())
+  {
+    auto payloads = automaton.find(TopicsFixtureType::query(idx));
+    ::benchmark::DoNotOptimize(payloads);
+    if(!payloads.empty())
+    {
+      ::benchmark::DoNotOptimize(++count);
+    }
+
+    ++idx;
+    idx = (idx % TopicsFixtureType::query_size());
+  }
+
+  state.counters["nodes"] = static_cast<double>(automaton.node_count());
+  state.counters["bytes"] = static_cast<double>(automaton.memory_size());
+}
+
+BENCHMARK(long_topic_lookup<FastTopics>)->Name("fast_long_topic_lookup");
+BENCHMARK(long_topic_lookup<ArtTopics>)->Name("art_long_topic_lookup");
+BENCHMARK(long_topic_lookup<RadixTopics>)->Name("radix_long_topic_lookup");
+
+} // namespace yafiyogi::benchmark
@@ -0,0 +1,151 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "fmt/format.h"
+
+#include "yy_mqtt_retained_topics.h"
+#include "yy_mqtt_util.h"
+
+#include "bench_yy_mqtt.h"
+
+namespace yafiyogi::benchmark {
+namespace {
+
+using RetainedTopics = yy_mqtt::retained_topics<int>;
+
+constexpr std::array<std::string_view, 10> measurements{
+  "Temp", "Humidity", "Power", "State", "Voltage",
+  "Current", "Lux", "Battery", "Motion", "Pressure"};
+
+constexpr std::array<std::string_view, 6> filters{
+  "iot3/room42/device7/Temp",
+  "iot3/room42/+/Temp",
+  "iot3/room42/#",
+  "iot3/+/device7/#",
+  "+/+/device7/Temp",
+  "+/+/+/Temp"};
+
+// 10 sites x 100 rooms x 100 devices x 10 measurements.
+const std::vector<std::string> & retained_names()
+{
+  static const std::vector<std::string> names = [] {
+    std::vector<std::string> l_names{};
+    l_names.reserve(1'000'000);
+
+    for(int site = 0; site < 10; ++site)
+    {
+      for(int room = 0; room < 100; ++room)
+      {
+        for(int device = 0; device < 100; ++device)
+        {
+          for(const auto measurement : measurements)
+          {
+            l_names.emplace_back(fmt::format("iot{}/room{}/device{}/{}", site, room, device, measurement));
+          }
+        }
+      }
+    }
+
+    return l_names;
+  }();
+
+  return names;
+}
+
+RetainedTopics & retained_index()
+{
+  static RetainedTopics * index = [] {
+    auto * l_index = new RetainedTopics{};
+    int value = 0;
+
+    for(const auto & name : retained_names())
+    {
+      l_index->set(name, ++value);
+    }
+    l_index->shrink_to_fit();
+
+    return l_index;
+  }();
+
+  return *index;
+}
+
+} // namespace
+
+void retained_find(::benchmark::State & state)
+{
+  auto & index = retained_index();
+  const auto filter = filters[static_cast<size_t>(state.range(0))];
+  size_t matches = 0;
+
+  for(auto _ : state)
+  {
+    auto payloads = index.find(filter);
+    ::benchmark::DoNotOptimize(payloads);
+    matches = payloads.size();
+  }
+
+  state.SetLabel(std::string{filter});
+  state.counters["matches"] = static_cast<double>(matches);
+  state.counters["topics"] = static_cast<double>(index.size());
+  state.counters["nodes"] = static_cast<double>(index.node_count());
+  state.counters["labels"] = static_cast<double>(index.label_count());
+  state.counters["bytes"] = static_cast<double>(index.memory_size());
+}
+
+// Baseline: topic_match() against every retained name.
+void retained_scan(::benchmark::State & state)
+{
+  const auto & names = retained_names();
+  const auto filter = filters[static_cast<size_t>(state.range(0))];
+  size_t matches = 0;
+
+  for(auto _ : state)
+  {
+    matches = 0;
+    for(const auto & name : names)
+    {
+      if(yy_mqtt::TopicMatchStatus::Match == yy_mqtt::topic_match(filter, name))
+      {
+        ++matches;
+      }
+    }
+    ::benchmark::DoNotOptimize(matches);
+  }
+
+  state.SetLabel(std::string{filter});
+  state.counters["matches"] = static_cast<double>(matches);
+}
+
+BENCHMARK(retained_find)->DenseRange(0, filters.size() - 1)->Unit(::benchmark::kMicrosecond);
+BENCHMARK(retained_scan)->DenseRange(0, filters.size() - 1)->Unit(::benchmark::kMillisecond)->Iterations(3);
+
+} // namespace yafiyogi::benchmark
@@ -0,0 +1,79 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <tuple>
+
+#include "fmt/format.h"
+
+#include "yy_mqtt_shared_topics.h"
+
+#include "bench_yy_mqtt.h"
+
+namespace yafiyogi::benchmark {
+
+using SharedTopics = yy_mqtt::shared_topics<int>;
+
+// Lookup cost for a group of state.range(0) members, against the
+// fixture's filters shared into groups of that size.
+void shared_lookup(::benchmark::State & state,
+                   SharedTopics::select_type p_select)
+{
+  const auto group_size = static_cast<int>(state.range(0));
+  SharedTopics topics{p_select};
+
+  int count = 0;
+  for(size_t idx = 0; idx < TopicsFixtureType::topics_size(); ++idx)
+  {
+    for(int member = 0; member < group_size; ++member)
+    {
+      std::ignore = topics.add(fmt::format("$share/g{}/{}", idx, TopicsFixtureType::topic(idx)), ++count);
+    }
+  }
+
+  auto automaton = topics.create_automaton();
+
+  size_t idx = 0;
+  std::size_t matches = 0;
+
+  for(auto _ : state)
+  {
+    auto payloads = automaton.find(TopicsFixtureType::query(idx));
+    ::benchmark::DoNotOptimize(payloads);
+    matches += payloads.size();
+
+    ++idx;
+    idx = (idx % TopicsFixtureType::query_size());
+  }
+
+  state.counters["members"] = static_cast<double>(count);
+  state.counters["payloads"] = ::benchmark::Counter(static_cast<double>(matches),
+                                                    ::benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK_CAPTURE(shared_lookup, round_robin, SharedTopics::select_type::RoundRobin)->RangeMultiplier(10)->Range(1, 1000);
+BENCHMARK_CAPTURE(shared_lookup, hashed, SharedTopics::select_type::Hashed)->RangeMultiplier(10)->Range(1, 1000);
+
+} // namespace yafiyogi::benchmark
@@ -0,0 +1,157 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "fmt/format.h"
+
+#include "yy_mqtt_suffix_topics.h"
+
+#include "bench_yy_mqtt.h"
+
+namespace yafiyogi::benchmark {
+namespace {
+
+using SuffixTopics = yafiyogi::yy_mqtt::suffix_topics<int>;
+
+constexpr int64_t rooms = 50;
+constexpr int64_t devices = 20;
+
+// Dashboard filters, e.g. '+/+/+/metric017' and 'iot21/+/+/metric017',
+// plus one device per room subscribed in full.
+std::vector<std::string> dashboard_filters(int64_t p_metrics)
+{
+  std::vector<std::string> filters{};
+
+  for(int64_t metric = 0; metric < p_metrics; ++metric)
+  {
+    filters.emplace_back(fmt::format("+/+/+/metric{:03}", metric));
+    filters.emplace_back(fmt::format("iot21/+/+/metric{:03}", metric));
+    filters.emplace_back(fmt::format("+/room{:02}/+/metric{:03}", metric % rooms, metric));
+  }
+  for(int64_t room = 0; room < rooms; ++room)
+  {
+    for(int64_t metric = 0; metric < p_metrics; ++metric)
+    {
+      filters.emplace_back(fmt::format("iot21/room{:02}/dev00/metric{:03}", room, metric));
+    }
+  }
+
+  return filters;
+}
+
+// e.g. 'iot21/room07/dev13/metric042'; a third publish metrics nobody watches.
+std::vector<std::string> dashboard_topics(int64_t p_metrics)
+{
+  std::vector<std::string> l_topics{};
+
+  uint32_t seed = 54321;
+  for(int idx = 0; idx < 10000; ++idx)
+  {
+    seed = (seed * 1664525) + 1013904223;
+    const auto room = (seed >> 8) % rooms;
+    const auto device = (seed >> 16) % devices;
+    const auto metric = (seed >> 4) % static_cast<uint32_t>((p_metrics * 3) / 2);
+
+    l_topics.emplace_back(fmt::format("iot21/room{:02}/dev{:02}/metric{:03}", room, device, metric));
+  }
+
+  return l_topics;
+}
+
+template<typename TopicsType,
+         typename CreateFn>
+void dashboard_lookup(::benchmark::State & state,
+                      CreateFn && p_create)
+{
+  const auto filters{dashboard_filters(state.range(0))};
+  const auto l_topics{dashboard_topics(state.range(0))};
+
+  TopicsType topics{};
+  int value = 0;
+  for(const auto & filter : filters)
+  {
+    topics.add(filter, ++value);
+  }
+
+  auto automaton = p_create(topics);
+
+  size_t idx = 0;
+  size_t matches = 0;
+  for(auto _ : state)
+  {
+    auto payloads = automaton.find(l_topics[idx]);
+    ::benchmark::DoNotOptimize(payloads);
+    matches += payloads.size();
+
+    if(++idx == l_topics.size())
+    {
+      idx = 0;
+    }
+  }
+
+  state.counters["matches"] = ::benchmark::Counter(static_cast<double>(matches), ::benchmark::Counter::kAvgIterations);
+}
+
+} // namespace
+
+void bench_suffix_dashboard(::benchmark::State & state)
+{
+  dashboard_lookup<SuffixTopics>(state, [](const SuffixTopics & topics) {
+    return topics.create_automaton();
+  });
+}
+
+void bench_radix_dashboard(::benchmark::State & state)
+{
+  dashboard_lookup<RadixTopics>(state, [](const RadixTopics & topics) {
+    return topics.create_automaton();
+  });
+}
+
+void bench_dfa_dashboard(::benchmark::State & state)
+{
+  dashboard_lookup<DfaTopics>(state, [](const DfaTopics & topics) {
+    return topics.create_automaton();
+  });
+}
+
+void bench_faster_dashboard(::benchmark::State & state)
+{
+  dashboard_lookup<FasterTopics>(state, [](const FasterTopics & topics) {
+    return topics.create_automaton();
+  });
+}
+
+// Arg 0: metrics, each with three wildcard filters.
+BENCHMARK(bench_suffix_dashboard)->RangeMultiplier(4)->Range(16, 1024);
+BENCHMARK(bench_radix_dashboard)->RangeMultiplier(4)->Range(16, 1024);
+BENCHMARK(bench_dfa_dashboard)->RangeMultiplier(4)->Range(16, 1024);
+BENCHMARK(bench_faster_dashboard)->RangeMultiplier(4)->Range(16, 1024);
+
+} // namespace yafiyogi::benchmark
@@ -0,0 +1,70 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <string_view>
+#include <tuple>
+
+#include "fmt/format.h"
+
+#include "yy_mqtt_topic_alias.h"
+
+#include "bench_yy_mqtt.h"
+
+namespace yafiyogi::benchmark {
+
+using FasterAliasTable = yy_mqtt::topic_alias_table<FasterTopics::automaton_type>;
+
+// Every query topic has an alias, and PUBLISH packets only carry the
+// alias.
+BENCHMARK_F(TopicsFixtureType, alias_lookup)(::benchmark::State & state)
+{
+  auto automaton = m_faster_topics.create_automaton();
+  const auto max_alias = static_cast<yy_mqtt::topic_alias_type>(TopicsFixtureType::query_size());
+  FasterAliasTable aliases{max_alias};
+
+  for(yy_mqtt::topic_alias_type alias = 1; alias <= max_alias; ++alias)
+  {
+    std::ignore = aliases.find(alias, TopicsFixtureType::query(alias - 1U), automaton, 1);
+  }
+
+  size_t idx = 0;
+  std::size_t count = 0;
+
+  while(state.KeepRunning())
+  {
+    auto payloads = aliases.find(static_cast<yy_mqtt::topic_alias_type>(idx + 1), std::string_view{}, automaton, 1);
+    ::benchmark::DoNotOptimize(payloads);
+    if(!payloads.empty())
+    {
+      ::benchmark::DoNotOptimize(++count);
+    }
+
+    ++idx;
+    idx = (idx % TopicsFixtureType::query_size());
+  }
+}
+
+} // namespace yafiyogi::benchmark
@@ -0,0 +1,146 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "fmt/format.h"
+
+#include "yy_mqtt_util.h"
+
+#include "bench_alloc_count.h"
+#include "bench_yy_mqtt.h"
+
+namespace yafiyogi::benchmark {
+namespace {
+
+// 64 ACL style filters for one client, checked against every publish.
+const std::vector<std::string> & acl_filters()
+{
+  static const std::vector<std::string> filters = [] {
+    std::vector<std::string> l_filters{};
+
+    for(int site = 0; site < 8; ++site)
+    {
+      l_filters.emplace_back(fmt::format("tenant/site{}/#", site));
+      l_filters.emplace_back(fmt::format("tenant/site{}/+/status", site));
+      l_filters.emplace_back(fmt::format("tenant/site{}/room{}/+/Temp", site, site));
+      l_filters.emplace_back(fmt::format("tenant/site{}/room{}/device{}/cmd", site, site, site));
+      l_filters.emplace_back(fmt::format("alerts/site{}/+", site));
+      l_filters.emplace_back(fmt::format("+/site{}/room{}/+/Humidity", site, site));
+      l_filters.emplace_back(fmt::format("$SYS/site{}/#", site));
+      l_filters.emplace_back(fmt::format("audit/site{}/room{}", site, site));
+    }
+
+    return l_filters;
+  }();
+
+  return filters;
+}
+
+const std::vector<std::string_view> & acl_filter_views()
+{
+  static const std::vector<std::string_view> views{acl_filters().begin(), acl_filters().end()};
+
+  return views;
+}
+
+const std::vector<std::string> & acl_topics()
+{
+  static const std::vector<std::string> topics = [] {
+    std::mt19937 gen{13};
+    std::uniform_int_distribution<int> site{0, 9};
+    std::uniform_int_distribution<int> room{0, 9};
+    std::uniform_int_distribution<int> device{0, 9};
+
+    std::vector<std::string> l_topics{};
+    for(int idx = 0; idx < 256; ++idx)
+    {
+      l_topics.emplace_back(fmt::format("tenant/site{}/room{}/device{}/Temp", site(gen), room(gen), device(gen)));
+    }
+
+    return l_topics;
+  }();
+
+  return topics;
+}
+
+} // namespace
+
+void topic_match_loop(::benchmark::State & state)
+{
+  const auto & filters = acl_filter_views();
+  const auto & topics = acl_topics();
+  yy_mqtt::TopicMatchResults results{};
+
+  size_t idx = 0;
+  alloc_counter allocs{};
+
+  for(auto _ : state)
+  {
+    results.clear();
+    for(const auto & filter : filters)
+    {
+      results.emplace_back(yy_mqtt::topic_match(filter, topics[idx]));
+    }
+    ::benchmark::DoNotOptimize(results.data());
+
+    ++idx;
+    idx = (idx % topics.size());
+  }
+
+  allocs.report(state);
+}
+
+void topic_match_many(::benchmark::State & state)
+{
+  const auto & filters = acl_filter_views();
+  const auto & topics = acl_topics();
+  yy_mqtt::topic_matcher matcher{};
+  yy_mqtt::TopicMatchResults results{};
+
+  size_t idx = 0;
+  alloc_counter allocs{};
+
+  for(auto _ : state)
+  {
+    matcher.topic(topics[idx]);
+    matcher.match_many(yy_quad::make_const_span(filters), results);
+    ::benchmark::DoNotOptimize(results.data());
+
+    ++idx;
+    idx = (idx % topics.size());
+  }
+
+  allocs.report(state);
+}
+
+BENCHMARK(topic_match_loop);
+BENCHMARK(topic_match_many);
+
+} // namespace yafiyogi::benchmark
@@ -0,0 +1,88 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include "yy_mqtt_topic.h"
+#include "yy_mqtt_util.h"
+
+#include "bench_alloc_count.h"
+#include "bench_yy_mqtt.h"
+
+namespace yafiyogi::benchmark {
+
+// Validate, tokenize and look up as separate passes.
+BENCHMARK_F(TopicsFixtureType, topic_separate_passes)(::benchmark::State & state)
+{
+  auto automaton = m_dfa_topics.create_automaton();
+  yy_mqtt::TopicLevelsView levels{};
+  size_t idx = 0;
+  alloc_counter allocs{};
+
+  for(auto _ : state)
+  {
+    const auto query = TopicsFixtureType::query(idx);
+
+    if(yy_mqtt::TopicValidStatus::Valid == yy_mqtt::topic_validate(query, yy_mqtt::TopicType::Name))
+    {
+      yy_mqtt::topic_tokenize_view(levels, query);
+      for(auto payload : automaton.find(query))
+      {
+        ::benchmark::DoNotOptimize(payload);
+      }
+    }
+
+    ++idx;
+    idx = (idx % TopicsFixtureType::query_size());
+  }
+
+  allocs.report(state);
+}
+
+// One Topic parse, then the lookup walks its levels.
+BENCHMARK_F(TopicsFixtureType, topic_single_pass)(::benchmark::State & state)
+{
+  auto automaton = m_dfa_topics.create_automaton();
+  yy_mqtt::Topic topic{};
+  size_t idx = 0;
+  alloc_counter allocs{};
+
+  for(auto _ : state)
+  {
+    if(yy_mqtt::TopicValidStatus::Valid == topic.assign(TopicsFixtureType::query(idx)))
+    {
+      for(auto payload : automaton.find(topic))
+      {
+        ::benchmark::DoNotOptimize(payload);
+      }
+    }
+
+    ++idx;
+    idx = (idx % TopicsFixtureType::query_size());
+  }
+
+  allocs.report(state);
+}
+
+} // namespace yafiyogi::benchmark
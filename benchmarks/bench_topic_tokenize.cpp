@@ -24,17 +24,33 @@
 
 */
 
+#include <array>
+#include <string_view>
+
 #include "fmt/format.h"
 
+#include "bench_alloc_count.h"
 #include "bench_yy_mqtt.h"
 #include "yy_mqtt_util.h"
 
 namespace yafiyogi::benchmark {
+namespace {
+
+// Deep topics with levels longer than the std::string SSO buffer.
+constexpr std::array<std::string_view, 4> long_level_topics{
+  "enterprise-campus-north/building-0042/floor-0007/room-0123/sensor-temperature-0001/reading",
+  "enterprise-campus-south/building-0017/floor-0002/room-0456/sensor-humidity-0002/reading",
+  "enterprise-campus-east/building-0003/floor-0011/room-0789/sensor-pressure-0003/reading",
+  "enterprise-campus-west/building-0099/floor-0005/room-0012/sensor-occupancy-0004/reading"
+};
+
+} // namespace
 
 BENCHMARK_F(TopicsFixtureType, topic_tokenize)(::benchmark::State & state)
 {
   size_t idx = 0;
   std::size_t count = 0;
+  alloc_counter allocs{};
 
   while(state.KeepRunning())
   {
@@ -47,6 +63,47 @@ BENCHMARK_F(TopicsFixtureType, topic_tokenize)(::benchmark::State & state)
     ++idx;
     idx = (idx % TopicsFixtureType::query_size());
   }
+
+  allocs.report(state);
 }
 
+void topic_tokenize_long_levels(::benchmark::State & state)
+{
+  yy_mqtt::TopicLevels levels{};
+  size_t idx = 0;
+  alloc_counter allocs{};
+
+  for(auto _ : state)
+  {
+    yy_mqtt::topic_tokenize(levels, long_level_topics[idx]);
+    ::benchmark::DoNotOptimize(levels.data());
+
+    ++idx;
+    idx = (idx % long_level_topics.size());
+  }
+
+  allocs.report(state);
+}
+
+void topic_tokenize_buffer_long_levels(::benchmark::State & state)
+{
+  yy_mqtt::TopicLevelsBuffer levels{};
+  size_t idx = 0;
+  alloc_counter allocs{};
+
+  for(auto _ : state)
+  {
+    yy_mqtt::topic_tokenize(levels, long_level_topics[idx]);
+    ::benchmark::DoNotOptimize(levels[0].data());
+
+    ++idx;
+    idx = (idx % long_level_topics.size());
+  }
+
+  allocs.report(state);
+}
+
+BENCHMARK(topic_tokenize_long_levels);
+BENCHMARK(topic_tokenize_buffer_long_levels);
+
 } // namespace yafiyogi::benchmark
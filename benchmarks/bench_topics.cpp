@@ -26,6 +26,7 @@
 
 #include "fmt/format.h"
 
+#include "bench_alloc_count.h"
 #include "bench_yy_mqtt.h"
 
 namespace yafiyogi::benchmark {
@@ -37,6 +38,13 @@ BENCHMARK_F(TopicsFixtureType, lookup)(::benchmark::State & state)
   size_t idx = 0;
   std::size_t count = 0;
 
+  // Grow the scratch buffers before counting.
+  for(size_t warm = 0; warm < TopicsFixtureType::query_size(); ++warm)
+  {
+    ::benchmark::DoNotOptimize(automaton.find(TopicsFixtureType::query(warm)));
+  }
+
+  alloc_counter allocs{};
   while(state.KeepRunning())
   {
     auto payloads = automaton.find(TopicsFixtureType::query(idx));
@@ -49,6 +57,8 @@ BENCHMARK_F(TopicsFixtureType, lookup)(::benchmark::State & state)
     ++idx;
     idx = (idx % TopicsFixtureType::query_size());
   }
+
+  allocs.report(state);
 }
 
 } // namespace yafiyogi::benchmark
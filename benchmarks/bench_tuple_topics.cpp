@@ -0,0 +1,148 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "fmt/format.h"
+
+#include "yy_mqtt_tuple_topics.h"
+
+#include "bench_yy_mqtt.h"
+
+namespace yafiyogi::benchmark {
+namespace {
+
+using TupleTopics = yafiyogi::yy_mqtt::tuple_topics<int>;
+
+constexpr std::string_view properties[] = {"battery", "linkquality", "local_temperature", "position", "state"};
+
+// Four shapes: 'L/L/L/L', 'L/L/+/L', 'L/L/L/#' and 'L/+/#', e.g.
+// 'iot21/site017/0x00158d0004a3f1c2/battery' and 'iot21/site017/+/battery'.
+std::vector<std::string> shaped_filters(int64_t p_filters)
+{
+  std::vector<std::string> filters{};
+  filters.reserve(static_cast<size_t>(p_filters));
+
+  for(int64_t idx = 0; static_cast<int64_t>(filters.size()) < p_filters; ++idx)
+  {
+    const auto site = idx % 1000;
+    const auto device = 0x00158d0000000000ULL + (static_cast<uint64_t>(idx) * 7919);
+    const auto property = properties[static_cast<size_t>(idx) % std::size(properties)];
+
+    filters.emplace_back(fmt::format("iot21/site{:03}/0x{:016x}/{}", site, device, property));
+    if(0 == (idx % 4))
+    {
+      filters.emplace_back(fmt::format("iot21/site{:03}/0x{:016x}/#", site, device));
+    }
+    if(idx < 5000)
+    {
+      filters.emplace_back(fmt::format("iot21/site{:03}/+/{}", site, property));
+    }
+    if(idx < 1000)
+    {
+      filters.emplace_back(fmt::format("iot21/+/0x{:016x}/#", device));
+    }
+  }
+  filters.resize(static_cast<size_t>(p_filters));
+
+  return filters;
+}
+
+// Half the topics come from devices without a literal filter.
+std::vector<std::string> shaped_topics(int64_t p_filters)
+{
+  std::vector<std::string> l_topics{};
+
+  uint32_t seed = 54321;
+  for(int lookup = 0; lookup < 10000; ++lookup)
+  {
+    seed = (seed * 1664525) + 1013904223;
+    const auto idx = static_cast<int64_t>(seed % static_cast<uint32_t>(p_filters * 2));
+    const auto device = 0x00158d0000000000ULL + (static_cast<uint64_t>(idx) * 7919);
+    const auto property = properties[static_cast<size_t>(idx) % std::size(properties)];
+
+    l_topics.emplace_back(fmt::format("iot21/site{:03}/0x{:016x}/{}", idx % 1000, device, property));
+  }
+
+  return l_topics;
+}
+
+template<typename TopicsType>
+void shaped_lookup(::benchmark::State & state)
+{
+  const auto filters{shaped_filters(state.range(0))};
+  const auto l_topics{shaped_topics(state.range(0))};
+
+  TopicsType topics{};
+  int value = 0;
+  for(const auto & filter : filters)
+  {
+    topics.add(filter, ++value);
+  }
+
+  auto automaton = topics.create_automaton();
+
+  size_t idx = 0;
+  size_t matches = 0;
+  for(auto _ : state)
+  {
+    auto payloads = automaton.find(l_topics[idx]);
+    ::benchmark::DoNotOptimize(payloads);
+    matches += payloads.size();
+
+    if(++idx == l_topics.size())
+    {
+      idx = 0;
+    }
+  }
+
+  state.counters["matches"] = ::benchmark::Counter(static_cast<double>(matches), ::benchmark::Counter::kAvgIterations);
+}
+
+} // namespace
+
+void bench_tuple_shapes(::benchmark::State & state)
+{
+  shaped_lookup<TupleTopics>(state);
+}
+
+void bench_faster_shapes(::benchmark::State & state)
+{
+  shaped_lookup<FasterTopics>(state);
+}
+
+void bench_radix_shapes(::benchmark::State & state)
+{
+  shaped_lookup<RadixTopics>(state);
+}
+
+BENCHMARK(bench_tuple_shapes)->RangeMultiplier(10)->Range(10000, 1000000);
+BENCHMARK(bench_faster_shapes)->RangeMultiplier(10)->Range(10000, 1000000);
+BENCHMARK(bench_radix_shapes)->RangeMultiplier(10)->Range(10000, 1000000);
+
+} // namespace yafiyogi::benchmark
@@ -31,6 +31,10 @@
 #include <random>
 #include <vector>
 
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
 #include "fmt/format.h"
 
 #include "yy_cpp/yy_assert.h"
@@ -483,6 +487,9 @@ FastTopics TopicsFixtureType::m_fast_topics;
 FasterTopics TopicsFixtureType::m_faster_topics;
 StateTopics TopicsFixtureType::m_state_topics;
 VariantStateTopics TopicsFixtureType::m_variant_state_topics;
+DfaTopics TopicsFixtureType::m_dfa_topics;
+ArtTopics TopicsFixtureType::m_art_topics;
+RadixTopics TopicsFixtureType::m_radix_topics;
 
 TopicsFixtureType::TopicsFixtureType()
 {
@@ -507,6 +514,9 @@ void TopicsFixtureType::SetUp(const ::benchmark::State & /* st */)
       m_faster_topics.add(topic, count);
       m_state_topics.add(topic, count);
       m_variant_state_topics.add(topic, count);
+      m_dfa_topics.add(topic, count);
+      m_art_topics.add(topic, count);
+      m_radix_topics.add(topic, count);
     }
   }
 }
@@ -521,11 +531,25 @@ size_type TopicsFixtureType::query_size()
   return g_query.size();
 }
 
+std::string_view TopicsFixtureType::topic(size_type idx)
+{
+  return topics[idx];
+}
+
 size_type TopicsFixtureType::topics_size()
 {
   return topics.size();
 }
 
+size_t heap_in_use() noexcept
+{
+#if defined(__GLIBC__) && ((__GLIBC__ > 2) || (__GLIBC_MINOR__ >= 33))
+  return ::mallinfo2().uordblks;
+#else
+  return 0;
+#endif
+}
+
 } // namespace yafiyogi::benchmark
 
 BENCHMARK_MAIN();
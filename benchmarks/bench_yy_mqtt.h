@@ -26,6 +26,7 @@
 
 #pragma once
 
+#include <string>
 #include <string_view>
 
 #include "benchmark/benchmark.h"
@@ -36,6 +37,9 @@
 #include "yy_mqtt_faster_topics.h"
 #include "yy_mqtt_state_topics.h"
 #include "yy_mqtt_variant_state_topics.h"
+#include "yy_mqtt_dfa_topics.h"
+#include "yy_mqtt_art_topics.h"
+#include "yy_mqtt_radix_topics.h"
 
 
 using Topics = yafiyogi::yy_mqtt::topics<int>;
@@ -44,6 +48,9 @@ using FastTopics = yafiyogi::yy_mqtt::fast_topics<int>;
 using FasterTopics = yafiyogi::yy_mqtt::faster_topics<int>;
 using StateTopics = yafiyogi::yy_mqtt::state_topics<int>;
 using VariantStateTopics = yafiyogi::yy_mqtt::variant_state_topics<int>;
+using DfaTopics = yafiyogi::yy_mqtt::dfa_topics<int>;
+using ArtTopics = yafiyogi::yy_mqtt::art_topics<int>;
+using RadixTopics = yafiyogi::yy_mqtt::radix_topics<int>;
 
 namespace yafiyogi::benchmark {
 
@@ -56,6 +63,7 @@ struct TopicsFixtureType:
 
     static std::string_view query(size_t idx);
     static size_t query_size();
+    static std::string_view topic(size_t idx);
     static size_t topics_size();
 
     static Topics m_topics;
@@ -64,8 +72,18 @@ struct TopicsFixtureType:
     static FasterTopics m_faster_topics;
     static StateTopics m_state_topics;
     static VariantStateTopics m_variant_state_topics;
+    static DfaTopics m_dfa_topics;
+    static ArtTopics m_art_topics;
+    static RadixTopics m_radix_topics;
 };
 
+// MQTT 5 QoS 1 PUBLISH packets for every fixture query, back to back
+// as they would arrive on a connection.
+const std::string & captured_publish();
 
+// Heap bytes in use, where the C library reports it, else 0. The
+// difference around create_automaton() is the memory the automaton
+// holds, for engines without a memory_size().
+size_t heap_in_use() noexcept;
 
 } // namespace yafiyogi::benchmark
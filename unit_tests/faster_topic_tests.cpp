@@ -168,4 +168,35 @@ TEST_F(TestFasterTopics, TestMosquittoValidNoMatching)
   EXPECT_TRUE(test_topic({{"$BOB/bar", 888}}, "$SYS/bar", Values{}));
 }
 
+TEST_F(TestFasterTopics, TestSearchLimits)
+{
+  faster_topics l_topics{};
+  l_topics.add("+/+/+/+/#", 111);
+  l_topics.add("a/+/c/#", 222);
+
+  auto automaton = l_topics.create_automaton();
+
+  EXPECT_EQ(2, automaton.find("a/b/c/d/e").size());
+  EXPECT_EQ(TopicSearchStatus::Ok, automaton.status());
+
+  automaton.limits(TopicSearchLimits{.max_levels = 4, .max_states = 0});
+  EXPECT_TRUE(automaton.find("a/b/c/d/e").empty());
+  EXPECT_EQ(TopicSearchStatus::LevelLimit, automaton.status());
+  EXPECT_EQ(2, automaton.find("a/b/c/d").size());
+  EXPECT_EQ(TopicSearchStatus::Ok, automaton.status());
+
+  automaton.limits(TopicSearchLimits{.max_levels = 0, .max_states = 4});
+  EXPECT_TRUE(automaton.find("a/b/c/d/e").empty());
+  EXPECT_EQ(TopicSearchStatus::StateLimit, automaton.status());
+
+  // max_states caps the states queued; this lookup queues 13.
+  automaton.limits(TopicSearchLimits{.max_levels = 0, .max_states = 12});
+  EXPECT_TRUE(automaton.find("a/b/c/d/e").empty());
+  EXPECT_EQ(TopicSearchStatus::StateLimit, automaton.status());
+
+  automaton.limits(TopicSearchLimits{.max_levels = 0, .max_states = 13});
+  EXPECT_EQ(2, automaton.find("a/b/c/d/e").size());
+  EXPECT_EQ(TopicSearchStatus::Ok, automaton.status());
+}
+
 } // namespace yafiyogi::yy_mqtt::tests
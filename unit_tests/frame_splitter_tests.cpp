@@ -0,0 +1,222 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "yy_mqtt_frame_splitter.h"
+#include "yy_mqtt_packet.h"
+
+namespace yafiyogi::yy_mqtt::tests {
+
+using namespace std::string_literals;
+using namespace std::string_view_literals;
+
+class TestFrameSplitter:
+      public testing::Test
+{
+  public:
+    void SetUp() override
+    {
+    }
+
+    void TearDown() override
+    {
+    }
+
+    static std::string packet(uint8_t p_first,
+                              size_type p_body_size,
+                              char p_fill)
+    {
+      std::string bytes{};
+      bytes.push_back(static_cast<char>(p_first));
+      auto size = p_body_size;
+      do
+      {
+        auto byte = static_cast<char>(size & 0x7F);
+        size >>= 7;
+        if(0 != size)
+        {
+          byte = static_cast<char>(byte | 0x80);
+        }
+        bytes.push_back(byte);
+      } while(0 != size);
+      bytes.append(p_body_size, p_fill);
+
+      return bytes;
+    }
+};
+
+TEST_F(TestFrameSplitter, TestBranchlessVariableByteInteger)
+{
+  uint32_t value = 0;
+  size_type size = 0;
+
+  EXPECT_EQ(DecodeStatus::Ok, decode_variable_byte_integer({0x00, 0, 0, 0}, 1, value, size));
+  EXPECT_EQ(0, value);
+  EXPECT_EQ(1, size);
+
+  EXPECT_EQ(DecodeStatus::Ok, decode_variable_byte_integer({0x80, 0x01, 0, 0}, 2, value, size));
+  EXPECT_EQ(128, value);
+  EXPECT_EQ(2, size);
+
+  EXPECT_EQ(DecodeStatus::Ok, decode_variable_byte_integer({0xFF, 0xFF, 0xFF, 0x7F}, 4, value, size));
+  EXPECT_EQ(268435455, value);
+  EXPECT_EQ(4, size);
+
+  EXPECT_EQ(DecodeStatus::Incomplete, decode_variable_byte_integer({0x80, 0, 0, 0}, 1, value, size));
+  EXPECT_EQ(DecodeStatus::Incomplete, decode_variable_byte_integer({0x80, 0x80, 0x80, 0}, 3, value, size));
+  EXPECT_EQ(DecodeStatus::Malformed, decode_variable_byte_integer({0x80, 0x80, 0x80, 0x80}, 4, value, size));
+}
+
+TEST_F(TestFrameSplitter, TestWholePackets)
+{
+  frame_splitter splitter{64};
+  const auto first{packet(0x30, 10, 'a')};
+  const auto second{packet(0xC0, 0, 0)}; // PINGREQ
+
+  EXPECT_EQ(first.size(), splitter.write(first));
+  EXPECT_EQ(second.size(), splitter.write(second));
+
+  std::string_view frame{};
+  ASSERT_EQ(FrameStatus::Ok, splitter.next(frame));
+  EXPECT_EQ(first, frame);
+  ASSERT_EQ(FrameStatus::Ok, splitter.next(frame));
+  EXPECT_EQ(second, frame);
+  EXPECT_EQ(FrameStatus::NeedMore, splitter.next(frame));
+  EXPECT_EQ(0, splitter.size());
+  EXPECT_EQ(0, splitter.straddled());
+}
+
+TEST_F(TestFrameSplitter, TestPartialReads)
+{
+  frame_splitter splitter{1024};
+  const auto bytes{packet(0x30, 300, 'b')}; // Two byte Remaining Length.
+  std::string_view frame{};
+
+  for(size_type idx = 0; idx < bytes.size(); ++idx)
+  {
+    EXPECT_EQ(FrameStatus::NeedMore, splitter.next(frame));
+    EXPECT_EQ(1, splitter.write(std::string_view{bytes}.substr(idx, 1)));
+  }
+
+  ASSERT_EQ(FrameStatus::Ok, splitter.next(frame));
+  EXPECT_EQ(bytes, frame);
+}
+
+TEST_F(TestFrameSplitter, TestStraddle)
+{
+  frame_splitter splitter{32};
+  const auto bytes{packet(0x30, 10, 'c')};  // 12 bytes.
+  std::string_view frame{};
+
+  // 12 + 12 bytes, then the third packet wraps.
+  for(int idx = 0; idx < 2; ++idx)
+  {
+    ASSERT_EQ(bytes.size(), splitter.write(bytes));
+    ASSERT_EQ(FrameStatus::Ok, splitter.next(frame));
+  }
+
+  ASSERT_EQ(bytes.size(), splitter.write(bytes));
+  ASSERT_EQ(FrameStatus::Ok, splitter.next(frame));
+  EXPECT_EQ(bytes, frame);
+  EXPECT_EQ(1, splitter.straddled());
+}
+
+TEST_F(TestFrameSplitter, TestPrepareCommit)
+{
+  frame_splitter splitter{16};
+  EXPECT_EQ(16, splitter.capacity());
+
+  auto space = splitter.prepare();
+  ASSERT_EQ(16, space.size());
+  const auto bytes{packet(0x30, 3, 'd')};
+  std::copy(bytes.begin(), bytes.end(), space.begin());
+  splitter.commit(bytes.size());
+
+  std::string_view frame{};
+  ASSERT_EQ(FrameStatus::Ok, splitter.next(frame));
+  EXPECT_EQ(bytes, frame);
+
+  // The returned packet's space is held until the next call to next().
+  EXPECT_EQ(16 - bytes.size(), splitter.prepare().size());
+  EXPECT_EQ(FrameStatus::NeedMore, splitter.next(frame));
+  EXPECT_EQ(16 - bytes.size(), splitter.prepare().size());
+}
+
+TEST_F(TestFrameSplitter, TestErrors)
+{
+  std::string_view frame{};
+
+  frame_splitter too_large{16};
+  too_large.write(packet(0x30, 20, 'e').substr(0, 8));
+  EXPECT_EQ(FrameStatus::TooLarge, too_large.next(frame));
+
+  frame_splitter malformed{16};
+  malformed.write("\x30\x80\x80\x80\x80\x01"sv);
+  EXPECT_EQ(FrameStatus::Malformed, malformed.next(frame));
+}
+
+TEST_F(TestFrameSplitter, TestRandomChunks)
+{
+  std::mt19937 gen{1};
+  std::uniform_int_distribution<size_type> body_size{0, 200};
+  std::uniform_int_distribution<size_type> chunk_size{1, 97};
+
+  std::vector<std::string> packets{};
+  std::string stream{};
+  for(int idx = 0; idx < 200; ++idx)
+  {
+    packets.emplace_back(packet(0x30, body_size(gen), static_cast<char>('A' + (idx % 26))));
+    stream.append(packets.back());
+  }
+
+  frame_splitter splitter{256};
+  size_type pos = 0;
+  size_type found = 0;
+  std::string_view frame{};
+
+  while(found < packets.size())
+  {
+    const auto chunk{std::string_view{stream}.substr(pos, chunk_size(gen))};
+    pos += splitter.write(chunk);
+
+    while(FrameStatus::Ok == splitter.next(frame))
+    {
+      ASSERT_EQ(packets[found], frame);
+      ++found;
+    }
+  }
+
+  EXPECT_EQ(stream.size(), pos);
+  EXPECT_LT(0, splitter.straddled());
+}
+
+} // namespace yafiyogi::yy_mqtt::tests
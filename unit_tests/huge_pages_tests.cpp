@@ -0,0 +1,153 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <cstdint>
+#include <cstring>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "yy_mqtt_huge_pages.h"
+#include "yy_mqtt_radix_topics.h"
+
+namespace yafiyogi::yy_mqtt::tests {
+
+class TestHugePages:
+      public testing::Test
+{
+  public:
+    using radix_topics = yafiyogi::yy_mqtt::radix_topics<int>;
+
+    void SetUp() override
+    {
+    }
+
+    void TearDown() override
+    {
+    }
+};
+
+TEST_F(TestHugePages, TestRegionOff)
+{
+  huge_page_region region{100, HugePages::Off};
+
+  ASSERT_FALSE(region.empty());
+  EXPECT_GE(region.size(), 100);
+  EXPECT_EQ(HugePages::Off, region.backing());
+
+  std::memset(region.data(), 0x5a, region.size());
+  EXPECT_EQ(0x5a, static_cast<unsigned char *>(region.data())[region.size() - 1]);
+}
+
+// Huge pages may not be available here, but whatever backing is
+// obtained the memory must be usable.
+TEST_F(TestHugePages, TestRegionFallback)
+{
+  for(const auto pages : {HugePages::Advise, HugePages::HugeTlb})
+  {
+    huge_page_region region{huge_page_size + 1, pages};
+
+    ASSERT_FALSE(region.empty());
+    EXPECT_GE(region.size(), huge_page_size + 1);
+    if(HugePages::Off != region.backing())
+    {
+      EXPECT_EQ(0, region.size() % huge_page_size);
+      EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(region.data()) % huge_page_size);
+    }
+
+    std::memset(region.data(), 0x5a, region.size());
+    EXPECT_EQ(0x5a, static_cast<unsigned char *>(region.data())[region.size() - 1]);
+  }
+}
+
+TEST_F(TestHugePages, TestRegionEmpty)
+{
+  huge_page_region region{0, HugePages::Advise};
+
+  EXPECT_TRUE(region.empty());
+  EXPECT_EQ(0, region.size());
+}
+
+TEST_F(TestHugePages, TestRegionMove)
+{
+  huge_page_region region{100, HugePages::Off};
+  auto * data = region.data();
+
+  huge_page_region moved{std::move(region)};
+  EXPECT_TRUE(region.empty());
+  EXPECT_EQ(data, moved.data());
+
+  region = std::move(moved);
+  EXPECT_TRUE(moved.empty());
+  EXPECT_EQ(data, region.data());
+}
+
+TEST_F(TestHugePages, TestRadixHugePages)
+{
+  radix_topics l_topics{};
+  l_topics.add("iot21/Front Bedroom/Plug/Salt Lamp", 1);
+  l_topics.add("iot21/Front Bedroom/Plug/Desk Fan", 2);
+  l_topics.add("iot21/+/Plug/#", 3);
+
+  for(const auto pages : {HugePages::Off, HugePages::Advise, HugePages::HugeTlb})
+  {
+    auto automaton = l_topics.create_automaton(pages);
+
+    EXPECT_EQ(l_topics.create_automaton().memory_size(), automaton.memory_size());
+
+    auto payloads = automaton.find("iot21/Front Bedroom/Plug/Salt Lamp");
+    ASSERT_EQ(2, payloads.size());
+    std::vector<int> values{*payloads[0], *payloads[1]};
+    std::sort(values.begin(), values.end());
+    EXPECT_EQ((std::vector<int>{1, 3}), values);
+
+    payloads = automaton.find("iot21/Back Bedroom/Plug/Desk Fan");
+    ASSERT_EQ(1, payloads.size());
+    EXPECT_EQ(3, *payloads[0]);
+
+    EXPECT_TRUE(automaton.find("iot21/Front Bedroom/Light").empty());
+
+    // Tables stay valid in the moved to query.
+    auto moved{std::move(automaton)};
+    EXPECT_EQ(0, automaton.node_count());
+    EXPECT_TRUE(automaton.find("iot21/Front Bedroom/Plug/Desk Fan").empty());
+    EXPECT_EQ(2, moved.find("iot21/Front Bedroom/Plug/Desk Fan").size());
+  }
+
+  // Only a root node; the empty edge and label tables are not copied.
+  radix_topics l_empty{};
+  for(const auto pages : {HugePages::Off, HugePages::Advise})
+  {
+    auto automaton = l_empty.create_automaton(pages);
+
+    EXPECT_TRUE(automaton.find("iot21").empty());
+  }
+}
+
+} // namespace yafiyogi::yy_mqtt::tests
@@ -0,0 +1,302 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "fmt/format.h"
+#include "gtest/gtest.h"
+
+#include "yy_mqtt_louds_topics.h"
+
+namespace yafiyogi::yy_mqtt::tests {
+
+class TestLoudsTopics:
+      public testing::Test
+{
+  public:
+    using louds_topics = yafiyogi::yy_mqtt::louds_topics<int>;
+    using Automaton = louds_topics::automaton_type;
+    using Values = std::vector<Automaton::value_type>;
+
+    void SetUp() override
+    {
+    }
+
+    void TearDown() override
+    {
+    }
+
+    // Payloads are unordered, so compare sorted.
+    static Values sorted(Automaton::payloads_span_type p_payloads)
+    {
+      Values values{};
+      for(const auto payload : p_payloads)
+      {
+        values.emplace_back(*payload);
+      }
+      std::sort(values.begin(), values.end());
+
+      return values;
+    }
+
+    bool test_topic(const std::vector<std::tuple<std::string_view, int>> & p_filters,
+                    const std::string_view p_topic,
+                    Values && p_values)
+    {
+      louds_topics l_topics{};
+
+      for(auto & filter : p_filters)
+      {
+        auto [topic, value] = filter;
+        l_topics.add(topic, std::move(value));
+      }
+
+      auto automaton = l_topics.create_automaton();
+      std::sort(p_values.begin(), p_values.end());
+
+      const auto found = sorted(automaton.find(p_topic));
+      if(found != p_values)
+      {
+        fmt::print("topic=[{}] payloads=[{}] expected=[{}]\n", p_topic, fmt::join(found, ","), fmt::join(p_values, ","));
+        return false;
+      }
+
+      return sorted(automaton.find(Topic{p_topic})) == p_values;
+    }
+};
+
+TEST_F(TestLoudsTopics, TestMatchSingleLevelWildcard)
+{
+  EXPECT_TRUE(test_topic({{"sport/+", 111}}, "sport", Values{}));
+  EXPECT_TRUE(test_topic({{"sport/+", 222}}, "sport/", Values{222}));
+  EXPECT_TRUE(test_topic({{"+/+", 333}}, "/finance", Values{333}));
+  EXPECT_TRUE(test_topic({{"+/+", 444}}, "/finance/", Values{444}));
+  EXPECT_TRUE(test_topic({{"/+", 555}}, "/finance", Values{555}));
+  EXPECT_TRUE(test_topic({{"/+", 666}},"/finance/", Values{666}));
+  EXPECT_TRUE(test_topic({{"+", 777}}, "/finance", Values{}));
+}
+
+TEST_F(TestLoudsTopics, TestMatchMultiLevelWildcard)
+{
+  EXPECT_TRUE(test_topic({{"sport/tennis/player1/#", 111}}, "sport/tennis/player1", Values{111}));
+  EXPECT_TRUE(test_topic({{"sport/tennis/player1/#", 222}}, "sport/tennis/player1/", Values{222}));
+  EXPECT_TRUE(test_topic({{"sport/tennis/player1/#", 333}}, "sport/tennis/player1/ranking", Values{333}));
+  EXPECT_TRUE(test_topic({{"sport/tennis/player1/#", 444}}, "sport/tennis/player1/score/wimbledon", Values{444}));
+  EXPECT_TRUE(test_topic({{"sport/#", 555}}, "sport", Values{555}));
+}
+
+TEST_F(TestLoudsTopics, TestDollarMatch)
+{
+  EXPECT_TRUE(test_topic({{"#", 111}}, "$sport/tennis/player1", Values{}));
+  EXPECT_TRUE(test_topic({{"+/monlitor/Clients", 222}}, "$SYS/monlitor/Clients", Values{}));
+  EXPECT_TRUE(test_topic({{"$SYS/#", 333}}, "$SYS/", Values{333}));
+  EXPECT_TRUE(test_topic({{"$SYS/#", 444}}, "$SYS/monitor", Values{444}));
+  EXPECT_TRUE(test_topic({{"$SYS/monitor/+", 555}}, "$SYS/monitor/Clients", Values{555}));
+}
+
+TEST_F(TestLoudsTopics, TestTrieMatch)
+{
+  EXPECT_TRUE(test_topic({{"/+", 111},{"/+/+", 112}}, "/roofer", Values{111}));
+  EXPECT_TRUE(test_topic({{"/+", 222},{"/+/+", 223}}, "/roofer/", Values{222, 223}));
+  EXPECT_TRUE(test_topic({{"/+", 333},{"/+/#", 334}}, "/roofer", Values{333, 334}));
+  EXPECT_TRUE(test_topic({{"/+", 444}}, "/roofer/", Values{444}));
+  EXPECT_TRUE(test_topic({{"/+/#", 555}}, "/roofer/", Values{555}));
+  EXPECT_TRUE(test_topic({{"/+", 666},{"/+/#", 667}}, "/roofer/", Values{666, 667}));
+  EXPECT_TRUE(test_topic({{"/+/+", 777},{"/+/#", 778}}, "/roofer/", Values({777, 778})));
+}
+
+// Based on https://github.com/eclipse/mosquitto/blob/v2.0.18/test/unit/util_topic_test.c
+TEST_F(TestLoudsTopics, TestMosquittoValidMatching)
+{
+  EXPECT_TRUE(test_topic({{"foo/#", 111}}, "foo/", Values{111}));
+  EXPECT_TRUE(test_topic({{"foo/#", 222}}, "foo", Values{222}));
+  EXPECT_TRUE(test_topic({{"foo//bar", 333}}, "foo//bar", Values{333}));
+  EXPECT_TRUE(test_topic({{"foo//+", 444}}, "foo//bar", Values{444}));
+  EXPECT_TRUE(test_topic({{"foo/+/+/baz", 555}}, "foo///baz", Values{555}));
+  EXPECT_TRUE(test_topic({{"foo/bar/+", 666}}, "foo/bar/", Values{666}));
+  EXPECT_TRUE(test_topic({{"foo/bar", 777}}, "foo/bar", Values{777}));
+  EXPECT_TRUE(test_topic({{"foo/+", 888}}, "foo/bar", Values{888}));
+  EXPECT_TRUE(test_topic({{"foo/+/baz", 999}}, "foo/bar/baz", Values{999}));
+  EXPECT_TRUE(test_topic({{"A/B/+/#", 1111}}, "A/B/B/C", Values{1111}));
+  EXPECT_TRUE(test_topic({{"foo/+/#", 2222}}, "foo/bar/baz", Values{2222}));
+  EXPECT_TRUE(test_topic({{"foo/+/#", 3333}}, "foo/bar", Values{3333}));
+  EXPECT_TRUE(test_topic({{"#", 4444}}, "foo/bar/baz", Values{4444}));
+  EXPECT_TRUE(test_topic({{"#", 5555}}, "foo/bar/baz", Values{5555}));
+  EXPECT_TRUE(test_topic({{"#", 6666}}, "/foo/bar", Values{6666}));
+  EXPECT_TRUE(test_topic({{"/#", 7777}}, "/foo/bar", Values{7777}));
+}
+
+// Based on https://github.com/eclipse/mosquitto/blob/v2.0.18/test/unit/util_topic_test.c
+TEST_F(TestLoudsTopics, TestMosquittoValidNoMatching)
+{
+  EXPECT_TRUE(test_topic({{"test/6/#", 111}}, "test/3", Values{}));
+  EXPECT_TRUE(test_topic({{"foo/bar", 222}}, "foo", Values{}));
+  EXPECT_TRUE(test_topic({{"foo/+", 333}}, "foo/bar/baz", Values{}));
+  EXPECT_TRUE(test_topic({{"foo/+/baz", 444}}, "foo/bar/bar", Values{}));
+  EXPECT_TRUE(test_topic({{"foo/+/#", 555}}, "fo2/bar/baz", Values{}));
+  EXPECT_TRUE(test_topic({{"/#", 666}}, "foo/bar", Values{}));
+  EXPECT_TRUE(test_topic({{"#", 777}}, "$SYS/bar", Values{}));
+  EXPECT_TRUE(test_topic({{"$BOB/bar", 888}}, "$SYS/bar", Values{}));
+}
+
+TEST_F(TestLoudsTopics, TestBitVector)
+{
+  louds_topics_detail::bit_vector bits{};
+  std::vector<bool> expected{};
+
+  for(size_type idx = 0; idx < 2000; ++idx)
+  {
+    const bool bit = (0 == (idx % 3)) || (0 == (idx % 7));
+    bits.push_back(bit);
+    expected.push_back(bit);
+  }
+  bits.build_index();
+
+  size_type ones = 0;
+  size_type zeros = 0;
+  for(size_type idx = 0; idx < expected.size(); ++idx)
+  {
+    EXPECT_EQ(ones, bits.rank1(idx)) << idx;
+    EXPECT_EQ(expected[idx], bits[idx]) << idx;
+
+    if(expected[idx])
+    {
+      ++ones;
+    }
+    else
+    {
+      EXPECT_EQ(idx, bits.select0(zeros)) << zeros;
+      ++zeros;
+    }
+  }
+  EXPECT_EQ(ones, bits.rank1(expected.size()));
+}
+
+TEST_F(TestLoudsTopics, TestFrontCodedLabels)
+{
+  louds_topics_detail::front_coded_labels labels{};
+  std::vector<std::string> expected{};
+
+  for(int idx = 0; idx < 100; ++idx)
+  {
+    expected.emplace_back(fmt::format("0x00158d00{:08x}", idx * 31));
+  }
+  expected.emplace_back("");
+  expected.emplace_back("battery");
+
+  for(const auto & label : expected)
+  {
+    labels.push_back(label);
+  }
+  labels.finish();
+
+  EXPECT_EQ(expected.size(), labels.size());
+
+  std::string label{};
+  for(size_type idx = 0; idx < expected.size(); ++idx)
+  {
+    labels.get(idx, label);
+    EXPECT_EQ(expected[idx], label);
+  }
+}
+
+TEST_F(TestLoudsTopics, TestFilterOrder)
+{
+  using louds_topics_detail::filter_less;
+
+  EXPECT_TRUE(filter_less("a", "a/b"));
+  EXPECT_TRUE(filter_less("a/b", "a-"));
+  EXPECT_TRUE(filter_less("a/#", "a/+"));
+  EXPECT_TRUE(filter_less("a/+", "a/"));
+  EXPECT_TRUE(filter_less("a/", "a/b"));
+  EXPECT_FALSE(filter_less("a/b", "a/b"));
+  EXPECT_FALSE(filter_less("a/b/c", "a/b"));
+}
+
+TEST_F(TestLoudsTopics, TestBuildSorted)
+{
+  louds_topics::builder_type builder{};
+
+  EXPECT_TRUE(builder.add_sorted("home/+/temperature", 1));
+  EXPECT_TRUE(builder.add_sorted("home/kitchen", 2));
+  EXPECT_TRUE(builder.add_sorted("home/kitchen", 3));
+  EXPECT_TRUE(builder.add_sorted("home/kitchen/temperature", 4));
+  EXPECT_FALSE(builder.add_sorted("home/attic", 5));
+  EXPECT_FALSE(builder.add_sorted("", 6));
+
+  auto automaton = builder.create_automaton();
+  EXPECT_EQ((Values{3}), sorted(automaton.find("home/kitchen")));
+  EXPECT_EQ((Values{1, 4}), sorted(automaton.find("home/kitchen/temperature")));
+  EXPECT_TRUE(automaton.find("home/attic").empty());
+}
+
+TEST_F(TestLoudsTopics, TestReadSorted)
+{
+  std::istringstream input{"iot21/Attic/TRV/battery\n"
+                           "iot21/Attic/TRV/linkquality\n"
+                           "iot21/Kitchen/TRV/battery\n"};
+
+  louds_topics::builder_type builder{};
+  EXPECT_TRUE(builder.read_sorted(input, [](std::string_view, size_type p_line) {
+    return static_cast<int>(p_line) + 1;
+  }));
+
+  auto automaton = builder.create_automaton();
+  EXPECT_EQ((Values{2}), sorted(automaton.find("iot21/Attic/TRV/linkquality")));
+  EXPECT_EQ((Values{3}), sorted(automaton.find("iot21/Kitchen/TRV/battery")));
+
+  std::istringstream unsorted{"b\na\n"};
+  louds_topics::builder_type unsorted_builder{};
+  EXPECT_FALSE(unsorted_builder.read_sorted(unsorted, [](std::string_view, size_type) { return 0; }));
+}
+
+TEST_F(TestLoudsTopics, TestHighFanOut)
+{
+  louds_topics l_topics{};
+  for(int idx = 0; idx < 5000; ++idx)
+  {
+    l_topics.add(fmt::format("zigbee2mqtt/0x00158d{:08x}/state", idx * 7919), idx);
+  }
+  l_topics.add("zigbee2mqtt/+/state", -1);
+  l_topics.add("zigbee2mqtt/bridge/#", -2);
+
+  auto automaton = l_topics.create_automaton();
+  // root, 'zigbee2mqtt', devices and their 'state', '+', '+/state', 'bridge', 'bridge/#'.
+  EXPECT_EQ((2 * 5000) + 6, automaton.node_count());
+
+  for(int idx = 0; idx < 5000; idx += 7)
+  {
+    EXPECT_EQ((Values{-1, idx}), sorted(automaton.find(fmt::format("zigbee2mqtt/0x00158d{:08x}/state", idx * 7919))));
+  }
+  EXPECT_EQ((Values{-1}), sorted(automaton.find("zigbee2mqtt/0x00158dffffffff/state")));
+  EXPECT_EQ((Values{-2, -1}), sorted(automaton.find("zigbee2mqtt/bridge/state")));
+  EXPECT_TRUE(automaton.find("zigbee2mqtt/0x00158d00000000/availability").empty());
+}
+
+} // namespace yafiyogi::yy_mqtt::tests
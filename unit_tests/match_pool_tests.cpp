@@ -0,0 +1,137 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <gtest/gtest.h>
+
+#include "fmt/format.h"
+
+#include "yy_mqtt_faster_topics.h"
+#include "yy_mqtt_match_pool.h"
+
+namespace yafiyogi::yy_mqtt::tests {
+
+class TestMatchPool:
+      public testing::Test
+{
+  public:
+    using Topics = faster_topics<int>;
+    using Query = decltype(std::declval<const Topics &>().create_automaton());
+    using Pool = match_pool<Query, int>;
+
+    void SetUp() override
+    {
+      m_topics.add("t/+", 1);
+      m_topics.add("t/#", 2);
+    }
+
+    void TearDown() override
+    {
+    }
+
+    // Posts p_per_topic numbered messages on each of p_topic_count
+    // topics, interleaved, and checks each topic's arrive in order.
+    void check_order(match_pool_options p_options,
+                     int p_topic_count,
+                     int p_per_topic)
+    {
+      std::mutex mutex{};
+      std::unordered_map<std::string, int> last{};
+      int dispatched = 0;
+      int payloads = 0;
+      bool ordered = true;
+
+      {
+        Pool pool{[this]() { return m_topics.create_automaton(); },
+                  [&](std::string_view p_topic, const int & p_seq, auto p_payloads) {
+                    std::lock_guard lock{mutex};
+                    auto [found, inserted] = last.try_emplace(std::string{p_topic}, p_seq);
+                    if(!inserted)
+                    {
+                      ordered = ordered && (found->second < p_seq);
+                      found->second = p_seq;
+                    }
+                    payloads += static_cast<int>(p_payloads.size());
+                    ++dispatched;
+                  },
+                  p_options};
+
+        for(int seq = 0; seq < p_per_topic; ++seq)
+        {
+          for(int topic = 0; topic < p_topic_count; ++topic)
+          {
+            pool.post(fmt::format("t/{}", topic), seq);
+          }
+        }
+
+        pool.flush();
+
+        std::lock_guard lock{mutex};
+        EXPECT_EQ(p_topic_count * p_per_topic, dispatched);
+      }
+
+      EXPECT_TRUE(ordered);
+      EXPECT_EQ(p_topic_count, static_cast<int>(last.size()));
+      EXPECT_EQ(2 * p_topic_count * p_per_topic, payloads);
+    }
+
+    Topics m_topics{};
+};
+
+TEST_F(TestMatchPool, TestOrderPerTopic)
+{
+  check_order(match_pool_options{4, 8, 4, true}, 50, 200);
+}
+
+TEST_F(TestMatchPool, TestOrderWithoutStealing)
+{
+  check_order(match_pool_options{4, 8, 4, false}, 50, 200);
+}
+
+TEST_F(TestMatchPool, TestSingleWorker)
+{
+  check_order(match_pool_options{1, 1, 1, true}, 3, 100);
+}
+
+TEST_F(TestMatchPool, TestNumaPin)
+{
+  check_order(match_pool_options{4, 8, 4, true, true}, 50, 50);
+}
+
+TEST_F(TestMatchPool, TestFlushEmpty)
+{
+  Pool pool{[this]() { return m_topics.create_automaton(); },
+            [](std::string_view, const int &, auto) {}};
+
+  pool.flush();
+  EXPECT_EQ(4, pool.worker_count());
+}
+
+} // namespace yafiyogi::yy_mqtt::tests
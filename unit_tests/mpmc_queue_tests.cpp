@@ -0,0 +1,161 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "yy_mqtt_mpmc_queue.h"
+
+namespace yafiyogi::yy_mqtt::tests {
+
+class TestMpmcQueue:
+      public testing::Test
+{
+  public:
+    void SetUp() override
+    {
+    }
+
+    void TearDown() override
+    {
+    }
+};
+
+TEST_F(TestMpmcQueue, TestCapacity)
+{
+  EXPECT_EQ(2, mpmc_queue<int>{0}.capacity());
+  EXPECT_EQ(8, mpmc_queue<int>{8}.capacity());
+  EXPECT_EQ(16, mpmc_queue<int>{9}.capacity());
+}
+
+TEST_F(TestMpmcQueue, TestFifo)
+{
+  mpmc_queue<int> queue{4};
+  int value = 0;
+
+  EXPECT_FALSE(queue.try_pop(value));
+
+  for(int idx = 0; idx < 4; ++idx)
+  {
+    EXPECT_TRUE(queue.try_push(idx));
+  }
+  EXPECT_FALSE(queue.try_push(4));
+  EXPECT_EQ(4, queue.size_approx());
+
+  for(int idx = 0; idx < 4; ++idx)
+  {
+    EXPECT_TRUE(queue.try_pop(value));
+    EXPECT_EQ(idx, value);
+  }
+  EXPECT_FALSE(queue.try_pop(value));
+
+  // Wraps around the ring.
+  for(int lap = 0; lap < 3; ++lap)
+  {
+    EXPECT_TRUE(queue.try_push(lap));
+    EXPECT_TRUE(queue.try_pop(value));
+    EXPECT_EQ(lap, value);
+  }
+}
+
+TEST_F(TestMpmcQueue, TestDeliveryReleasesMessage)
+{
+  using Message = std::shared_ptr<const std::string>;
+  delivery_queue<const int *, Message> queue{4};
+
+  const int subscriber = 7;
+  auto message = std::make_shared<const std::string>("payload");
+
+  EXPECT_TRUE(queue.try_push(delivery<const int *, Message>{&subscriber, message}));
+  EXPECT_EQ(2, message.use_count());
+
+  delivery<const int *, Message> popped{};
+  EXPECT_TRUE(queue.try_pop(popped));
+  EXPECT_EQ(&subscriber, popped.value);
+  EXPECT_EQ(message, popped.message);
+
+  popped = delivery<const int *, Message>{};
+  EXPECT_EQ(1, message.use_count());
+}
+
+TEST_F(TestMpmcQueue, TestThreads)
+{
+  constexpr int producers = 4;
+  constexpr int consumers = 4;
+  constexpr int per_producer = 20000;
+
+  mpmc_queue<int> queue{64};
+  std::atomic<long> sum{0};
+  std::atomic<int> popped{0};
+  std::vector<std::thread> threads{};
+
+  for(int producer = 0; producer < producers; ++producer)
+  {
+    threads.emplace_back([&queue]() {
+      for(int value = 1; value <= per_producer; ++value)
+      {
+        while(!queue.try_push(value))
+        {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  for(int consumer = 0; consumer < consumers; ++consumer)
+  {
+    threads.emplace_back([&queue, &sum, &popped]() {
+      int value = 0;
+      while(popped.load() < (producers * per_producer))
+      {
+        if(queue.try_pop(value))
+        {
+          sum += value;
+          ++popped;
+        }
+        else
+        {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  for(auto & thread : threads)
+  {
+    thread.join();
+  }
+
+  EXPECT_EQ(producers * per_producer, popped.load());
+  EXPECT_EQ(static_cast<long>(producers) * per_producer * (per_producer + 1) / 2, sum.load());
+}
+
+} // namespace yafiyogi::yy_mqtt::tests
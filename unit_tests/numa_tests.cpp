@@ -0,0 +1,127 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "yy_mqtt_numa.h"
+
+namespace yafiyogi::yy_mqtt::tests {
+
+class TestNuma:
+      public testing::Test
+{
+  public:
+    void SetUp() override
+    {
+      m_root = std::filesystem::temp_directory_path() / "yy_mqtt_numa_tests";
+      std::filesystem::remove_all(m_root);
+      std::filesystem::create_directories(m_root);
+    }
+
+    void TearDown() override
+    {
+      std::filesystem::remove_all(m_root);
+    }
+
+    void write(const std::string & p_file,
+               const std::string & p_content)
+    {
+      const auto path = m_root / p_file;
+      std::filesystem::create_directories(path.parent_path());
+      std::ofstream{path} << p_content << '\n';
+    }
+
+    std::filesystem::path m_root{};
+};
+
+TEST_F(TestNuma, TestParseCpuList)
+{
+  cpu_list cpus{};
+
+  EXPECT_TRUE(numa_parse_cpu_list("0-3,8,10-11\n", cpus));
+  EXPECT_EQ((cpu_list{0, 1, 2, 3, 8, 10, 11}), cpus);
+
+  EXPECT_TRUE(numa_parse_cpu_list("5", cpus));
+  EXPECT_EQ((cpu_list{5}), cpus);
+
+  EXPECT_TRUE(numa_parse_cpu_list("", cpus));
+  EXPECT_TRUE(cpus.empty());
+
+  EXPECT_FALSE(numa_parse_cpu_list("3-1", cpus));
+  EXPECT_FALSE(numa_parse_cpu_list("a-b", cpus));
+  EXPECT_FALSE(numa_parse_cpu_list("1,,2", cpus));
+  EXPECT_TRUE(cpus.empty());
+}
+
+TEST_F(TestNuma, TestTwoNodes)
+{
+  write("online", "0-1");
+  write("node0/cpulist", "0-3");
+  write("node1/cpulist", "4-7");
+
+  const numa_topology topology{m_root.string()};
+
+  ASSERT_EQ(2, topology.node_count());
+  EXPECT_EQ((cpu_list{0, 1, 2, 3}), topology.cpus(0));
+  EXPECT_EQ((cpu_list{4, 5, 6, 7}), topology.cpus(1));
+}
+
+TEST_F(TestNuma, TestSingleNodeFallback)
+{
+  const numa_topology topology{(m_root / "missing").string()};
+
+  ASSERT_EQ(1, topology.node_count());
+  EXPECT_TRUE(topology.cpus(0).empty());
+  EXPECT_EQ(0, topology.current_node());
+  EXPECT_FALSE(topology.pin_to_node(0));
+  EXPECT_FALSE(topology.pin_to_node(1));
+}
+
+TEST_F(TestNuma, TestPinBeyondCpuSetSize)
+{
+  write("online", "0");
+  write("node0/cpulist", "4096-4097");
+
+  const numa_topology topology{m_root.string()};
+
+  // No such CPUs, but the set must be sized for them rather than overrun.
+  ASSERT_EQ(1, topology.node_count());
+  EXPECT_FALSE(topology.pin_to_node(0));
+}
+
+TEST_F(TestNuma, TestSystem)
+{
+  const auto & topology = numa_topology::system();
+
+  ASSERT_LE(1, topology.node_count());
+  EXPECT_GT(topology.node_count(), topology.current_node());
+}
+
+} // namespace yafiyogi::yy_mqtt::tests
@@ -0,0 +1,142 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include "yy_mqtt_faster_topics.h"
+#include "yy_mqtt_owner_topics.h"
+#include "yy_mqtt_topics.h"
+
+namespace yafiyogi::yy_mqtt::tests {
+
+struct Subscription final
+{
+    owner_id_type owner_id = 0;
+    int qos = 0;
+};
+
+class TestOwnerTopics:
+      public testing::Test
+{
+  public:
+    using Owners = std::vector<owner_id_type>;
+
+    void SetUp() override
+    {
+    }
+
+    void TearDown() override
+    {
+    }
+
+    template<typename Automaton>
+    static Owners owners(Automaton & p_automaton,
+                         std::string_view p_topic)
+    {
+      Owners l_owners{};
+      for(const auto payload : p_automaton.find(p_topic))
+      {
+        l_owners.emplace_back(payload->owner_id);
+      }
+      std::sort(l_owners.begin(), l_owners.end());
+
+      return l_owners;
+    }
+
+    template<typename Topics>
+    static void add_overlapping(Topics & p_topics)
+    {
+      p_topics.add("a/#", Subscription{1, 0});
+      p_topics.add("a/b/+", Subscription{1, 1});
+      p_topics.add("a/b/c", Subscription{1, 2});
+      p_topics.add("+/b/c", Subscription{2, 0});
+      p_topics.add("a/+/c", Subscription{2, 1});
+      p_topics.add("x/#", Subscription{3, 0});
+    }
+};
+
+TEST_F(TestOwnerTopics, TestFasterTopics)
+{
+  owner_topics<faster_topics<Subscription>> l_topics{};
+  add_overlapping(l_topics);
+
+  auto automaton = l_topics.create_automaton();
+
+  EXPECT_EQ(5, automaton.find_all("a/b/c").size());
+  EXPECT_EQ((Owners{1, 2}), owners(automaton, "a/b/c"));
+  EXPECT_EQ((Owners{1}), owners(automaton, "a/b/d"));
+  EXPECT_EQ((Owners{3}), owners(automaton, "x"));
+  EXPECT_EQ((Owners{}), owners(automaton, "y"));
+
+  // Stamps from one lookup do not leak into the next.
+  for(int idx = 0; idx < 3; ++idx)
+  {
+    EXPECT_EQ((Owners{1, 2}), owners(automaton, "a/b/c"));
+  }
+}
+
+TEST_F(TestOwnerTopics, TestMove)
+{
+  owner_topics<faster_topics<Subscription>> l_topics{};
+  add_overlapping(l_topics);
+
+  auto built = l_topics.create_automaton();
+  auto automaton{std::move(built)};
+  EXPECT_EQ((Owners{1, 2}), owners(automaton, "a/b/c"));
+
+  built = std::move(automaton);
+  EXPECT_EQ((Owners{1, 2}), owners(built, "a/b/c"));
+}
+
+TEST_F(TestOwnerTopics, TestUnknownOwner)
+{
+  owner_topics<faster_topics<Subscription>> l_topics{};
+  add_overlapping(l_topics);
+
+  auto automaton = l_topics.create_automaton();
+
+  // An owner beyond those added is passed through, not written past the stamps.
+  for(auto payload : automaton.find_all("x/y"))
+  {
+    payload->owner_id = 1000;
+  }
+  EXPECT_EQ((Owners{1000}), owners(automaton, "x/y"));
+}
+
+TEST_F(TestOwnerTopics, TestTopics)
+{
+  owner_topics<topics<Subscription>> l_topics{};
+  add_overlapping(l_topics);
+
+  auto automaton = l_topics.create_automaton();
+
+  EXPECT_EQ((Owners{1, 2}), owners(automaton, "a/b/c"));
+  EXPECT_EQ((Owners{1}), owners(automaton, "a"));
+}
+
+} // namespace yafiyogi::yy_mqtt::tests
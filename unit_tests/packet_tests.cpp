@@ -0,0 +1,246 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+#include "yy_mqtt_packet.h"
+
+namespace yafiyogi::yy_mqtt::tests {
+
+using namespace std::string_literals;
+using namespace std::string_view_literals;
+
+class TestPacket:
+      public testing::Test
+{
+  public:
+    void SetUp() override
+    {
+    }
+
+    void TearDown() override
+    {
+    }
+
+    static std::string str(std::string_view p_string)
+    {
+      std::string bytes{};
+      bytes.push_back(static_cast<char>(p_string.size() >> 8));
+      bytes.push_back(static_cast<char>(p_string.size() & 0xFF));
+      bytes.append(p_string);
+
+      return bytes;
+    }
+
+    static std::string vbi(uint32_t p_value)
+    {
+      std::string bytes{};
+      do
+      {
+        auto byte = static_cast<char>(p_value & 0x7F);
+        p_value >>= 7;
+        if(0 != p_value)
+        {
+          byte = static_cast<char>(byte | 0x80);
+        }
+        bytes.push_back(byte);
+      } while(0 != p_value);
+
+      return bytes;
+    }
+
+    static std::string packet(uint8_t p_first,
+                              std::string_view p_body)
+    {
+      std::string bytes{};
+      bytes.push_back(static_cast<char>(p_first));
+      bytes.append(vbi(static_cast<uint32_t>(p_body.size())));
+      bytes.append(p_body);
+
+      return bytes;
+    }
+};
+
+TEST_F(TestPacket, TestVariableByteInteger)
+{
+  for(uint32_t value : {0U, 127U, 128U, 16383U, 16384U, 2097151U, 2097152U, 268435455U})
+  {
+    const auto bytes{vbi(value)};
+    size_type pos = 0;
+    uint32_t decoded = 0;
+
+    EXPECT_EQ(DecodeStatus::Ok, decode_variable_byte_integer(bytes, pos, decoded));
+    EXPECT_EQ(value, decoded);
+    EXPECT_EQ(bytes.size(), pos);
+  }
+
+  size_type pos = 0;
+  uint32_t decoded = 0;
+  EXPECT_EQ(DecodeStatus::Incomplete, decode_variable_byte_integer("\x80\x80"sv, pos, decoded));
+  EXPECT_EQ(DecodeStatus::Malformed, decode_variable_byte_integer("\x80\x80\x80\x80\x01"sv, pos, decoded));
+}
+
+TEST_F(TestPacket, TestFixedHeader)
+{
+  FixedHeader header{};
+
+  const auto bytes{packet(0x3B, std::string(200, 'x'))};
+  EXPECT_EQ(DecodeStatus::Ok, decode_fixed_header(bytes, header));
+  EXPECT_EQ(PacketType::Publish, header.type);
+  EXPECT_EQ(0x0B, header.flags);
+  EXPECT_EQ(200, header.remaining_length);
+  EXPECT_EQ(3, header.header_size);
+  EXPECT_EQ(bytes.size(), header.packet_size());
+
+  EXPECT_EQ(DecodeStatus::Incomplete, decode_fixed_header(""sv, header));
+  EXPECT_EQ(DecodeStatus::Incomplete, decode_fixed_header("\x30\x80"sv, header));
+}
+
+TEST_F(TestPacket, TestPublishV311)
+{
+  const auto bytes{packet(0x33, str("iot21/Kitchen/Temp") + "\x00\x07"s + "21.5")};
+  PublishPacket publish{};
+
+  ASSERT_EQ(DecodeStatus::Ok, decode_publish(bytes, ProtocolVersion::V311, publish));
+  EXPECT_EQ("iot21/Kitchen/Temp", publish.topic);
+  EXPECT_EQ(1, publish.qos);
+  EXPECT_TRUE(publish.retain);
+  EXPECT_FALSE(publish.dup);
+  EXPECT_EQ(7, publish.packet_id);
+  EXPECT_EQ("21.5", publish.payload);
+  EXPECT_TRUE(publish.properties.empty());
+
+  // Views point into the buffer.
+  EXPECT_EQ(bytes.data() + 4, publish.topic.data());
+}
+
+TEST_F(TestPacket, TestPublishV5)
+{
+  const auto properties{"\x01\x01"s + "\x23\x00\x05"s + "\x26"s + str("k") + str("v")};
+  const auto bytes{packet(0x30, str("iot21/Kitchen/Temp") + vbi(static_cast<uint32_t>(properties.size())) + properties + "on")};
+  PublishPacket publish{};
+
+  ASSERT_EQ(DecodeStatus::Ok, decode_publish(bytes, ProtocolVersion::V5, publish));
+  EXPECT_EQ("iot21/Kitchen/Temp", publish.topic);
+  EXPECT_EQ(0, publish.qos);
+  EXPECT_EQ(5, publish.topic_alias);
+  EXPECT_EQ(properties, publish.properties);
+  EXPECT_EQ("on", publish.payload);
+
+  auto props{publish.properties};
+  Property property{};
+  ASSERT_EQ(DecodeStatus::Ok, decode_property(props, property));
+  EXPECT_EQ(static_cast<uint8_t>(PropertyId::PayloadFormatIndicator), property.id);
+  EXPECT_EQ(1, property.value);
+  ASSERT_EQ(DecodeStatus::Ok, decode_property(props, property));
+  EXPECT_EQ(static_cast<uint8_t>(PropertyId::TopicAlias), property.id);
+  ASSERT_EQ(DecodeStatus::Ok, decode_property(props, property));
+  EXPECT_EQ(static_cast<uint8_t>(PropertyId::UserProperty), property.id);
+  EXPECT_EQ("k", property.data);
+  EXPECT_EQ("v", property.pair_value);
+  EXPECT_TRUE(props.empty());
+
+  // Alias only.
+  const auto alias_bytes{packet(0x30, str("") + "\x03\x23\x00\x05"s + "on")};
+  ASSERT_EQ(DecodeStatus::Ok, decode_publish(alias_bytes, ProtocolVersion::V5, publish));
+  EXPECT_TRUE(publish.topic.empty());
+  EXPECT_EQ(5, publish.topic_alias);
+}
+
+TEST_F(TestPacket, TestPublishErrors)
+{
+  PublishPacket publish{};
+
+  EXPECT_EQ(DecodeStatus::WrongType, decode_publish(packet(0x82, "\x00\x01"s), ProtocolVersion::V311, publish));
+  EXPECT_EQ(DecodeStatus::Incomplete, decode_publish(packet(0x30, str("a/b")).substr(0, 4), ProtocolVersion::V311, publish));
+  // QoS 3.
+  EXPECT_EQ(DecodeStatus::Malformed, decode_publish(packet(0x36, str("a/b") + "\x00\x01"s), ProtocolVersion::V311, publish));
+  // DUP with QoS 0.
+  EXPECT_EQ(DecodeStatus::Malformed, decode_publish(packet(0x38, str("a/b")), ProtocolVersion::V311, publish));
+  // Packet id 0.
+  EXPECT_EQ(DecodeStatus::Malformed, decode_publish(packet(0x32, str("a/b") + "\x00\x00"s), ProtocolVersion::V311, publish));
+  // Topic length past the end.
+  EXPECT_EQ(DecodeStatus::Malformed, decode_publish(packet(0x30, "\x00\x09" "a/b"s), ProtocolVersion::V311, publish));
+  // Wildcards in a topic name.
+  EXPECT_EQ(DecodeStatus::InvalidTopic, decode_publish(packet(0x30, str("a/+")), ProtocolVersion::V311, publish));
+  EXPECT_EQ(DecodeStatus::InvalidTopic, decode_publish(packet(0x30, str("a/#")), ProtocolVersion::V311, publish));
+  EXPECT_EQ(DecodeStatus::InvalidTopic, decode_publish(packet(0x30, str("a\0b"sv)), ProtocolVersion::V311, publish));
+  // Empty topic without an alias.
+  EXPECT_EQ(DecodeStatus::InvalidTopic, decode_publish(packet(0x30, str("") + "\x00"s), ProtocolVersion::V5, publish));
+  // Alias 0.
+  EXPECT_EQ(DecodeStatus::Malformed, decode_publish(packet(0x30, str("a") + "\x03\x23\x00\x00"s), ProtocolVersion::V5, publish));
+  // Unknown property.
+  EXPECT_EQ(DecodeStatus::Malformed, decode_publish(packet(0x30, str("a") + "\x01\x7F"s), ProtocolVersion::V5, publish));
+}
+
+TEST_F(TestPacket, TestSubscribe)
+{
+  SubscribePacket subscribe{};
+
+  const auto v311{packet(0x82, "\x00\x0A"s + str("iot21/+/Temp") + "\x01"s + str("$share/g/iot21/#") + "\x02"s)};
+  ASSERT_EQ(DecodeStatus::Ok, decode_subscribe(v311, ProtocolVersion::V311, subscribe));
+  EXPECT_EQ(10, subscribe.packet_id);
+  ASSERT_EQ(2, subscribe.filters.size());
+  EXPECT_EQ("iot21/+/Temp", subscribe.filters[0].filter);
+  EXPECT_EQ(1, subscribe.filters[0].qos());
+  EXPECT_EQ("$share/g/iot21/#", subscribe.filters[1].filter);
+  EXPECT_EQ(2, subscribe.filters[1].qos());
+
+  const auto v5{packet(0x82, "\x00\x0B"s + "\x02\x0B\x07"s + str("a/#") + "\x2D"s)};
+  ASSERT_EQ(DecodeStatus::Ok, decode_subscribe(v5, ProtocolVersion::V5, subscribe));
+  EXPECT_EQ(11, subscribe.packet_id);
+  EXPECT_EQ("\x0B\x07"sv, subscribe.properties);
+  ASSERT_EQ(1, subscribe.filters.size());
+  EXPECT_EQ("a/#", subscribe.filters[0].filter);
+  EXPECT_EQ(0x2D, subscribe.filters[0].options);
+}
+
+TEST_F(TestPacket, TestSubscribeErrors)
+{
+  SubscribePacket subscribe{};
+
+  // Flags must be 0b0010.
+  EXPECT_EQ(DecodeStatus::Malformed, decode_subscribe(packet(0x80, "\x00\x01"s + str("a") + "\x00"s), ProtocolVersion::V311, subscribe));
+  // No filters.
+  EXPECT_EQ(DecodeStatus::Malformed, decode_subscribe(packet(0x82, "\x00\x01"s), ProtocolVersion::V311, subscribe));
+  // Reserved option bits.
+  EXPECT_EQ(DecodeStatus::Malformed, decode_subscribe(packet(0x82, "\x00\x01"s + str("a") + "\x04"s), ProtocolVersion::V311, subscribe));
+  EXPECT_EQ(DecodeStatus::Malformed, decode_subscribe(packet(0x82, "\x00\x01\x00"s + str("a") + "\x40"s), ProtocolVersion::V5, subscribe));
+  // QoS 3, Retain Handling 3.
+  EXPECT_EQ(DecodeStatus::Malformed, decode_subscribe(packet(0x82, "\x00\x01"s + str("a") + "\x03"s), ProtocolVersion::V311, subscribe));
+  EXPECT_EQ(DecodeStatus::Malformed, decode_subscribe(packet(0x82, "\x00\x01\x00"s + str("a") + "\x30"s), ProtocolVersion::V5, subscribe));
+  // Options byte missing.
+  EXPECT_EQ(DecodeStatus::Malformed, decode_subscribe(packet(0x82, "\x00\x01"s + str("a")), ProtocolVersion::V311, subscribe));
+  // Invalid filters.
+  EXPECT_EQ(DecodeStatus::InvalidTopic, decode_subscribe(packet(0x82, "\x00\x01"s + str("a/#/b") + "\x00"s), ProtocolVersion::V311, subscribe));
+  EXPECT_EQ(DecodeStatus::InvalidTopic, decode_subscribe(packet(0x82, "\x00\x01"s + str("a+") + "\x00"s), ProtocolVersion::V311, subscribe));
+  EXPECT_EQ(DecodeStatus::InvalidTopic, decode_subscribe(packet(0x82, "\x00\x01"s + str("") + "\x00"s), ProtocolVersion::V311, subscribe));
+}
+
+} // namespace yafiyogi::yy_mqtt::tests
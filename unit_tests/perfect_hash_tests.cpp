@@ -0,0 +1,117 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <cstdint>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "yy_mqtt_perfect_hash.h"
+#include "yy_mqtt_topic.h"
+
+namespace yafiyogi::yy_mqtt::tests {
+
+class TestPerfectHash:
+      public testing::Test
+{
+  public:
+    void SetUp() override
+    {
+    }
+
+    void TearDown() override
+    {
+    }
+
+    // True if p_hashes map one to one onto [0, size).
+    static bool is_minimal_perfect(const std::vector<uint64_t> & p_hashes)
+    {
+      std::vector<uint32_t> seeds{};
+      std::vector<uint32_t> slots{};
+
+      if(!perfect_hash_build(yy_quad::make_const_span(p_hashes), seeds, slots))
+      {
+        return false;
+      }
+
+      const auto size = static_cast<uint32_t>(p_hashes.size());
+      const auto buckets = perfect_hash_bucket_count(size);
+      std::vector<bool> seen(size, false);
+
+      for(uint32_t idx = 0; idx < size; ++idx)
+      {
+        const auto seed = seeds[perfect_hash_bucket(p_hashes[idx], buckets)];
+        const auto slot = perfect_hash_slot(p_hashes[idx], seed, size);
+
+        if((slot != slots[idx]) || seen[slot])
+        {
+          return false;
+        }
+        seen[slot] = true;
+      }
+
+      return std::all_of(seen.begin(), seen.end(), [](bool found) { return found; });
+    }
+};
+
+TEST_F(TestPerfectHash, TestSizes)
+{
+  for(const size_type size : {1, 2, 3, 10, 100, 1000, 20000})
+  {
+    std::vector<uint64_t> hashes{};
+    for(size_type idx = 0; idx < size; ++idx)
+    {
+      hashes.emplace_back(topic_level_hash("0x00158d00" + std::to_string(idx)));
+    }
+
+    EXPECT_TRUE(is_minimal_perfect(hashes)) << size;
+  }
+}
+
+TEST_F(TestPerfectHash, TestEmpty)
+{
+  std::vector<uint64_t> hashes{};
+  std::vector<uint32_t> seeds{};
+  std::vector<uint32_t> slots{};
+
+  EXPECT_TRUE(perfect_hash_build(yy_quad::make_const_span(hashes), seeds, slots));
+  EXPECT_TRUE(seeds.empty());
+  EXPECT_TRUE(slots.empty());
+}
+
+TEST_F(TestPerfectHash, TestDuplicateHash)
+{
+  std::vector<uint64_t> hashes{1, 2, 3, 2};
+  std::vector<uint32_t> seeds{};
+  std::vector<uint32_t> slots{};
+
+  EXPECT_FALSE(perfect_hash_build(yy_quad::make_const_span(hashes), seeds, slots));
+}
+
+} // namespace yafiyogi::yy_mqtt::tests
@@ -0,0 +1,144 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <algorithm>
+
+#include "fmt/format.h"
+#include <gtest/gtest.h>
+
+#include "yy_mqtt_faster_topics.h"
+#include "yy_mqtt_pruned_topics.h"
+
+namespace yafiyogi::yy_mqtt::tests {
+
+class TestPrunedTopics:
+      public testing::Test
+{
+  public:
+    using pruned_topics = yafiyogi::yy_mqtt::pruned_topics<yafiyogi::yy_mqtt::faster_topics<int>>;
+    using Values = std::vector<int>;
+
+    void SetUp() override
+    {
+    }
+
+    void TearDown() override
+    {
+    }
+
+    static std::vector<std::string> kept(const pruned_topics & p_topics)
+    {
+      std::vector<std::string> filters{};
+      for(const auto & filter : p_topics.filters())
+      {
+        if(!filter.pruned)
+        {
+          filters.emplace_back(filter.filter);
+        }
+      }
+
+      return filters;
+    }
+};
+
+TEST_F(TestPrunedTopics, TestPruneSameValue)
+{
+  pruned_topics l_topics{};
+  l_topics.add("a/b/c", 1);
+  l_topics.add("a/b/+", 1);
+  l_topics.add("a/#", 1);
+  l_topics.add("x/y", 1);
+
+  EXPECT_EQ(2, l_topics.pruned_count());
+  EXPECT_EQ((std::vector<std::string>{"a/#", "x/y"}), kept(l_topics));
+
+  auto automaton = l_topics.create_automaton();
+  auto payloads = automaton.find("a/b/c");
+  ASSERT_EQ(1, payloads.size());
+  EXPECT_EQ(1, *payloads[0]);
+  EXPECT_EQ(1, automaton.find("a").size());
+  EXPECT_EQ(1, automaton.find("x/y").size());
+  EXPECT_TRUE(automaton.find("b").empty());
+}
+
+TEST_F(TestPrunedTopics, TestKeepDifferentValues)
+{
+  pruned_topics l_topics{};
+  l_topics.add("a/#", 1);
+  l_topics.add("a/b/c", 2);
+  l_topics.add("a/b/+", 2);
+
+  EXPECT_EQ(1, l_topics.pruned_count());
+  EXPECT_EQ((std::vector<std::string>{"a/#", "a/b/+"}), kept(l_topics));
+
+  auto automaton = l_topics.create_automaton();
+  Values values{};
+  for(const auto payload : automaton.find("a/b/c"))
+  {
+    values.emplace_back(*payload);
+  }
+  std::sort(values.begin(), values.end());
+  EXPECT_EQ((Values{1, 2}), values);
+}
+
+TEST_F(TestPrunedTopics, TestDuplicates)
+{
+  pruned_topics l_topics{};
+  l_topics.add("a/+", 1);
+  l_topics.add("a/+", 1);
+  l_topics.add("#", 2);
+  l_topics.add("$SYS/a", 2);
+
+  EXPECT_EQ(1, l_topics.pruned_count());
+  EXPECT_EQ((std::vector<std::string>{"a/+", "#", "$SYS/a"}), kept(l_topics));
+
+  // A later, wider filter prunes the ones it subsumes.
+  l_topics.add("+/+", 1);
+  EXPECT_EQ(2, l_topics.pruned_count());
+  EXPECT_EQ((std::vector<std::string>{"#", "$SYS/a", "+/+"}), kept(l_topics));
+}
+
+TEST_F(TestPrunedTopics, TestManyOwners)
+{
+  pruned_topics l_topics{};
+  for(int owner = 0; owner < 1000; ++owner)
+  {
+    l_topics.add(fmt::format("site{}/room1/device1/Temp", owner % 10), owner);
+    l_topics.add(fmt::format("site{}/room1/+/Temp", owner % 10), owner);
+    l_topics.add(fmt::format("site{}/room{}/#", owner % 10, owner % 3), owner);
+  }
+
+  // Owners in room1 keep only 'site/room1/#'; the others keep all but the device filter.
+  EXPECT_EQ(3000, l_topics.size());
+  EXPECT_EQ(333 * 2 + (1000 - 333), l_topics.pruned_count());
+  EXPECT_EQ(3000 - l_topics.pruned_count(), kept(l_topics).size());
+
+  const auto & const_topics = l_topics;
+  auto automaton = const_topics.create_automaton();
+  EXPECT_FALSE(automaton.find("site1/room1/device1/Temp").empty());
+}
+
+} // namespace yafiyogi::yy_mqtt::tests
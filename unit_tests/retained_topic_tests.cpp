@@ -0,0 +1,159 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include "yy_mqtt_retained_topics.h"
+
+namespace yafiyogi::yy_mqtt::tests {
+
+class TestRetainedTopics:
+      public testing::Test
+{
+  public:
+    using retained_topics = yafiyogi::yy_mqtt::retained_topics<int>;
+    using Values = std::vector<int>;
+
+    void SetUp() override
+    {
+    }
+
+    void TearDown() override
+    {
+    }
+
+    static Values sorted(retained_topics::payloads_span_type p_payloads)
+    {
+      Values values{};
+      for(const auto payload : p_payloads)
+      {
+        values.emplace_back(*payload);
+      }
+      std::sort(values.begin(), values.end());
+
+      return values;
+    }
+
+    bool test_filter(const std::vector<std::tuple<std::string_view, int>> & p_topics,
+                     const std::string_view p_filter,
+                     Values && p_values)
+    {
+      retained_topics l_topics{};
+
+      for(auto & [topic, value] : p_topics)
+      {
+        l_topics.set(topic, value);
+      }
+
+      std::sort(p_values.begin(), p_values.end());
+
+      return sorted(l_topics.find(p_filter)) == p_values;
+    }
+};
+
+TEST_F(TestRetainedTopics, TestMatchLiteral)
+{
+  EXPECT_TRUE(test_filter({{"sport/tennis", 111}}, "sport/tennis", Values{111}));
+  EXPECT_TRUE(test_filter({{"sport/tennis", 222}}, "sport", Values{}));
+  EXPECT_TRUE(test_filter({{"sport", 333}}, "sport/tennis", Values{}));
+  EXPECT_TRUE(test_filter({{"foo//bar", 444}}, "foo//bar", Values{444}));
+  EXPECT_TRUE(test_filter({{"/foo", 555}, {"foo", 556}}, "/foo", Values{555}));
+}
+
+TEST_F(TestRetainedTopics, TestMatchSingleLevelWildcard)
+{
+  EXPECT_TRUE(test_filter({{"sport", 111}}, "sport/+", Values{}));
+  EXPECT_TRUE(test_filter({{"sport/", 222}}, "sport/+", Values{222}));
+  EXPECT_TRUE(test_filter({{"/finance", 333}}, "+/+", Values{333}));
+  EXPECT_TRUE(test_filter({{"/finance", 444}}, "/+", Values{444}));
+  EXPECT_TRUE(test_filter({{"/finance/", 555}}, "/+", Values{555}));
+  EXPECT_TRUE(test_filter({{"/finance", 666}}, "+", Values{}));
+  EXPECT_TRUE(test_filter({{"foo/bar/baz", 777}}, "foo/+", Values{}));
+  EXPECT_TRUE(test_filter({{"foo///baz", 888}}, "foo/+/+/baz", Values{888}));
+  EXPECT_TRUE(test_filter({{"a/b/c", 1}, {"a/x/c", 2}, {"a/b/d", 3}, {"b/b/c", 4}}, "a/+/c", Values{1, 2}));
+}
+
+TEST_F(TestRetainedTopics, TestMatchMultiLevelWildcard)
+{
+  EXPECT_TRUE(test_filter({{"sport/tennis/player1", 111}}, "sport/tennis/player1/#", Values{111}));
+  EXPECT_TRUE(test_filter({{"sport/tennis/player1/ranking", 222}}, "sport/tennis/player1/#", Values{222}));
+  EXPECT_TRUE(test_filter({{"sport/tennis/player1/score/wimbledon", 333}}, "sport/tennis/player1/#", Values{333}));
+  EXPECT_TRUE(test_filter({{"sport", 444}, {"sport/", 445}, {"sports", 446}}, "sport/#", Values{444, 445}));
+  EXPECT_TRUE(test_filter({{"a", 1}, {"a/b", 2}, {"/a", 3}, {"a/b/c", 4}}, "#", Values{1, 2, 3, 4}));
+  EXPECT_TRUE(test_filter({{"foo/bar", 555}}, "/#", Values{}));
+  EXPECT_TRUE(test_filter({{"iot21/Kitchen/Temp/1", 1}, {"iot21/Kitchen/Temp", 2}, {"iot21/Kitchen/Humidity", 3}, {"iot21/Lounge/Temp/a/b", 4}}, "iot21/+/Temp/#", Values{1, 2, 4}));
+}
+
+TEST_F(TestRetainedTopics, TestDollarMatch)
+{
+  EXPECT_TRUE(test_filter({{"$SYS/bar", 111}}, "#", Values{}));
+  EXPECT_TRUE(test_filter({{"$SYS/monitor/Clients", 222}}, "+/monitor/Clients", Values{}));
+  EXPECT_TRUE(test_filter({{"$SYS/monitor/Clients", 333}}, "$SYS/#", Values{333}));
+  EXPECT_TRUE(test_filter({{"$SYS/monitor/Clients", 444}}, "$SYS/monitor/+", Values{444}));
+  EXPECT_TRUE(test_filter({{"$SYS/bar", 555}}, "$BOB/bar", Values{}));
+  EXPECT_TRUE(test_filter({{"foo/$SYS", 666}}, "foo/+", Values{666}));
+}
+
+TEST_F(TestRetainedTopics, TestSetErase)
+{
+  retained_topics l_topics{};
+
+  l_topics.set("a/b/c", 1);
+  l_topics.set("a/b", 2);
+  l_topics.set("a/d", 3);
+  EXPECT_EQ(3, l_topics.size());
+  EXPECT_EQ((Values{1, 2, 3}), sorted(l_topics.find("a/#")));
+
+  // Replace.
+  l_topics.set("a/b", 20);
+  EXPECT_EQ(3, l_topics.size());
+  EXPECT_EQ((Values{20}), sorted(l_topics.find("a/b")));
+
+  EXPECT_TRUE(l_topics.erase("a/b/c"));
+  EXPECT_FALSE(l_topics.erase("a/b/c"));
+  EXPECT_FALSE(l_topics.erase("a"));
+  EXPECT_FALSE(l_topics.erase("x/y"));
+  EXPECT_EQ(2, l_topics.size());
+  EXPECT_EQ((Values{3, 20}), sorted(l_topics.find("a/#")));
+
+  // root, a, a/b, a/d
+  EXPECT_EQ(4, l_topics.node_count());
+
+  EXPECT_TRUE(l_topics.erase("a/b"));
+  EXPECT_TRUE(l_topics.erase("a/d"));
+  EXPECT_TRUE(l_topics.empty());
+  EXPECT_EQ(1, l_topics.node_count());
+  EXPECT_TRUE(l_topics.find("#").empty());
+
+  // Freed nodes and values are reused.
+  l_topics.set("x/y", 4);
+  EXPECT_EQ(3, l_topics.node_count());
+  EXPECT_EQ((Values{4}), sorted(l_topics.find("+/y")));
+}
+
+} // namespace yafiyogi::yy_mqtt::tests
@@ -0,0 +1,188 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <cstdint>
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "yy_mqtt_roaring.h"
+
+namespace yafiyogi::yy_mqtt::tests {
+
+class TestRoaring:
+      public testing::Test
+{
+  public:
+    using Ids = std::vector<uint32_t>;
+
+    void SetUp() override
+    {
+    }
+
+    void TearDown() override
+    {
+    }
+
+    static Ids ids(roaring_view p_view)
+    {
+      Ids found{};
+      p_view.for_each([&found](uint32_t p_id) {
+        found.emplace_back(p_id);
+      });
+
+      return found;
+    }
+
+    // Every p_step'th id below p_end, from p_begin.
+    static Ids stride(uint32_t p_begin,
+                      uint32_t p_end,
+                      uint32_t p_step)
+    {
+      Ids range{};
+      for(uint32_t id = p_begin; id < p_end; id += p_step)
+      {
+        range.emplace_back(id);
+      }
+
+      return range;
+    }
+
+    static Ids set_and(const Ids & p_lhs,
+                       const Ids & p_rhs)
+    {
+      Ids result{};
+      std::set_intersection(p_lhs.begin(), p_lhs.end(), p_rhs.begin(), p_rhs.end(), std::back_inserter(result));
+
+      return result;
+    }
+
+    static Ids set_or(const Ids & p_lhs,
+                      const Ids & p_rhs)
+    {
+      Ids result{};
+      std::set_union(p_lhs.begin(), p_lhs.end(), p_rhs.begin(), p_rhs.end(), std::back_inserter(result));
+
+      return result;
+    }
+};
+
+TEST_F(TestRoaring, TestPushBack)
+{
+  // Sparse, dense and sparse again across three containers.
+  Ids expected{stride(3, 1000, 7)};
+  const auto dense = stride(65536, 65536 + 20000, 2);
+  expected.insert(expected.end(), dense.begin(), dense.end());
+  expected.emplace_back(5u << 16);
+
+  roaring_bitmap bitmap{};
+  for(const auto id : expected)
+  {
+    bitmap.push_back(id);
+  }
+
+  EXPECT_EQ(3, bitmap.view().containers.size());
+  EXPECT_FALSE(bitmap.view().containers[0].dense);
+  EXPECT_TRUE(bitmap.view().containers[1].dense);
+  EXPECT_EQ(expected.size(), bitmap.view().cardinality());
+  EXPECT_EQ(expected, ids(bitmap.view()));
+}
+
+TEST_F(TestRoaring, TestPool)
+{
+  const auto lhs_ids{stride(0, 70000, 3)};
+  const auto rhs_ids{stride(1, 70000, 3)};
+
+  roaring_bitmap pool{};
+  const auto lhs = pool.append(yy_quad::make_const_span(lhs_ids));
+  const auto rhs = pool.append(yy_quad::make_const_span(rhs_ids));
+  const auto empty = pool.append(yy_quad::const_span<uint32_t>{});
+
+  EXPECT_EQ(lhs_ids, ids(pool.view(lhs)));
+  EXPECT_EQ(rhs_ids, ids(pool.view(rhs)));
+  EXPECT_TRUE(pool.view(empty).empty());
+}
+
+TEST_F(TestRoaring, TestSetOperations)
+{
+  // Dense and sparse operands in all combinations.
+  const std::vector<Ids> sets{stride(0, 200000, 2),
+                              stride(0, 200000, 3),
+                              stride(5, 200000, 97),
+                              stride(100000, 300000, 1),
+                              Ids{1, 65536, 131072, 262143},
+                              Ids{}};
+
+  roaring_bitmap pool{};
+  std::vector<roaring_range> ranges{};
+  for(const auto & set : sets)
+  {
+    ranges.emplace_back(pool.append(yy_quad::make_const_span(set)));
+  }
+
+  roaring_bitmap result{};
+  for(size_type lhs = 0; lhs < sets.size(); ++lhs)
+  {
+    for(size_type rhs = 0; rhs < sets.size(); ++rhs)
+    {
+      result.assign_and(pool.view(ranges[lhs]), pool.view(ranges[rhs]));
+      EXPECT_EQ(set_and(sets[lhs], sets[rhs]), ids(result.view())) << lhs << " & " << rhs;
+
+      result.assign_or(pool.view(ranges[lhs]), pool.view(ranges[rhs]));
+      EXPECT_EQ(set_or(sets[lhs], sets[rhs]), ids(result.view())) << lhs << " | " << rhs;
+    }
+  }
+}
+
+TEST_F(TestRoaring, TestSparseResult)
+{
+  // Two dense containers whose intersection is small enough for an array.
+  const auto lhs_ids{stride(0, 65536, 2)};
+  const auto rhs_ids{stride(0, 65536, 3)};
+
+  roaring_bitmap pool{};
+  const auto lhs = pool.append(yy_quad::make_const_span(lhs_ids));
+  const auto rhs = pool.append(yy_quad::make_const_span(rhs_ids));
+  const auto disjoint = pool.append(yy_quad::make_const_span(stride(1, 65536, 2)));
+
+  roaring_bitmap result{};
+  result.assign_and(pool.view(lhs), pool.view(rhs));
+  EXPECT_TRUE(result.view().containers[0].dense);
+
+  roaring_bitmap sparse{};
+  sparse.assign_and(result.view(), pool.view(disjoint));
+  EXPECT_TRUE(sparse.empty());
+
+  const auto sixtieths = pool.append(yy_quad::make_const_span(stride(0, 65536, 60)));
+  result.assign_and(pool.view(rhs), pool.view(sixtieths));
+  EXPECT_FALSE(result.view().containers[0].dense);
+  EXPECT_EQ(set_and(rhs_ids, stride(0, 65536, 60)), ids(result.view()));
+}
+
+} // namespace yafiyogi::yy_mqtt::tests
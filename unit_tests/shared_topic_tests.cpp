@@ -0,0 +1,143 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <algorithm>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "yy_mqtt_shared_topics.h"
+
+namespace yafiyogi::yy_mqtt::tests {
+
+class TestSharedTopics:
+      public testing::Test
+{
+  public:
+    using shared_topics = yafiyogi::yy_mqtt::shared_topics<std::string>;
+    using Members = std::vector<std::string>;
+
+    void SetUp() override
+    {
+    }
+
+    void TearDown() override
+    {
+    }
+
+    static Members members(shared_topics::automaton_type::payloads_span_type p_payloads)
+    {
+      Members l_members{};
+      for(const auto payload : p_payloads)
+      {
+        l_members.emplace_back(*payload);
+      }
+      std::sort(l_members.begin(), l_members.end());
+
+      return l_members;
+    }
+};
+
+TEST_F(TestSharedTopics, TestAdd)
+{
+  shared_topics l_topics{};
+
+  EXPECT_TRUE(l_topics.add("$share/workers/iot21/#", "a"));
+  EXPECT_TRUE(l_topics.add("$share/workers/iot21/#", "b"));
+  EXPECT_TRUE(l_topics.add("$share/workers/iot21/#", "a"));
+  EXPECT_FALSE(l_topics.add("iot21/#", "c"));
+  EXPECT_FALSE(l_topics.add("$share/workers", "c"));
+
+  auto automaton = l_topics.create_automaton();
+  ASSERT_EQ(1, automaton.groups().size());
+  EXPECT_EQ("workers", automaton.groups()[0].share_name());
+  EXPECT_EQ("iot21/#", automaton.groups()[0].filter());
+  EXPECT_EQ((Members{"a", "b"}), automaton.groups()[0].members());
+}
+
+TEST_F(TestSharedTopics, TestOnePerGroup)
+{
+  shared_topics l_topics{};
+
+  l_topics.add("$share/workers/iot21/#", "w1");
+  l_topics.add("$share/workers/iot21/#", "w2");
+  l_topics.add("$share/loggers/iot21/#", "l1");
+  l_topics.add("$share/temps/iot21/+/Temp", "t1");
+  l_topics.add("$share/other/iot22/#", "o1");
+
+  auto automaton = l_topics.create_automaton();
+
+  auto payloads = automaton.find("iot21/Kitchen/Temp");
+  ASSERT_EQ(3, payloads.size());
+  auto found = members(payloads);
+  EXPECT_EQ("l1", found[0]);
+  EXPECT_EQ("t1", found[1]);
+  EXPECT_TRUE(("w1" == found[2]) || ("w2" == found[2]));
+
+  EXPECT_EQ(2, automaton.find("iot21").size());
+  EXPECT_TRUE(automaton.find("iot23/x").empty());
+}
+
+TEST_F(TestSharedTopics, TestRoundRobin)
+{
+  shared_topics l_topics{};
+
+  l_topics.add("$share/workers/iot21/#", "w1");
+  l_topics.add("$share/workers/iot21/#", "w2");
+  l_topics.add("$share/workers/iot21/#", "w3");
+
+  auto automaton = l_topics.create_automaton();
+
+  Members delivered{};
+  for(int idx = 0; idx < 6; ++idx)
+  {
+    auto payloads = automaton.find("iot21/a");
+    ASSERT_EQ(1, payloads.size());
+    delivered.emplace_back(*payloads[0]);
+  }
+
+  EXPECT_EQ((Members{"w1", "w2", "w3", "w1", "w2", "w3"}), delivered);
+}
+
+TEST_F(TestSharedTopics, TestHashed)
+{
+  shared_topics l_topics{shared_topics::select_type::Hashed};
+
+  for(int idx = 0; idx < 10; ++idx)
+  {
+    l_topics.add("$share/workers/iot21/#", std::to_string(idx));
+  }
+
+  auto automaton = l_topics.create_automaton();
+
+  const std::string first{*automaton.find("iot21/a")[0]};
+  for(int idx = 0; idx < 5; ++idx)
+  {
+    EXPECT_EQ(first, *automaton.find("iot21/a")[0]);
+  }
+}
+
+} // namespace yafiyogi::yy_mqtt::tests
@@ -0,0 +1,144 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <initializer_list>
+#include <tuple>
+
+#include <gtest/gtest.h>
+
+#include "yy_mqtt_faster_topics.h"
+#include "yy_mqtt_topic_alias.h"
+
+namespace yafiyogi::yy_mqtt::tests {
+
+class TestTopicAlias:
+      public testing::Test
+{
+  public:
+    using topics = yafiyogi::yy_mqtt::faster_topics<int>;
+    using Automaton = topics::automaton_type;
+    using alias_table = yafiyogi::yy_mqtt::topic_alias_table<Automaton>;
+
+    void SetUp() override
+    {
+    }
+
+    void TearDown() override
+    {
+    }
+
+    static Automaton build(std::initializer_list<std::tuple<std::string_view, int>> p_filters)
+    {
+      topics l_topics{};
+      for(const auto & [filter, value] : p_filters)
+      {
+        l_topics.add(filter, value);
+      }
+
+      return l_topics.create_automaton();
+    }
+};
+
+TEST_F(TestTopicAlias, TestSetAndUse)
+{
+  auto automaton = build({{"iot21/+/Temp", 1}, {"iot21/#", 2}});
+  alias_table aliases{10};
+
+  auto payloads = aliases.find(3, "iot21/Kitchen/Temp", automaton, 1);
+  EXPECT_EQ(TopicAliasStatus::Ok, aliases.status());
+  EXPECT_EQ(2, payloads.size());
+  EXPECT_EQ("iot21/Kitchen/Temp", aliases.topic(3));
+  EXPECT_EQ(1, aliases.misses());
+
+  // Alias only, answered from the cache.
+  payloads = aliases.find(3, "", automaton, 1);
+  EXPECT_EQ(TopicAliasStatus::Ok, aliases.status());
+  EXPECT_EQ(2, payloads.size());
+  EXPECT_EQ(1, aliases.hits());
+  EXPECT_EQ(1, aliases.misses());
+
+  // The cache does not share the automaton's scratch space.
+  std::ignore = automaton.find("other");
+  payloads = aliases.find(3, "", automaton, 1);
+  EXPECT_EQ(2, payloads.size());
+
+  // Reassign the alias.
+  payloads = aliases.find(3, "iot21/Kitchen/Humidity", automaton, 1);
+  EXPECT_EQ(1, payloads.size());
+  EXPECT_EQ(2, *payloads[0]);
+  EXPECT_EQ(2, aliases.misses());
+}
+
+TEST_F(TestTopicAlias, TestRebuild)
+{
+  auto automaton = build({{"iot21/+/Temp", 1}});
+  alias_table aliases{10};
+
+  EXPECT_EQ(1, aliases.find(1, "iot21/Kitchen/Temp", automaton, 1).size());
+
+  auto rebuilt = build({{"iot21/+/Temp", 1}, {"iot21/Kitchen/#", 3}});
+  auto payloads = aliases.find(1, "", rebuilt, 2);
+  EXPECT_EQ(2, payloads.size());
+  EXPECT_EQ(2, aliases.misses());
+}
+
+TEST_F(TestTopicAlias, TestErrors)
+{
+  auto automaton = build({{"iot21/#", 1}});
+  alias_table aliases{2};
+
+  EXPECT_TRUE(aliases.find(0, "iot21", automaton, 1).empty());
+  EXPECT_EQ(TopicAliasStatus::InvalidAlias, aliases.status());
+
+  EXPECT_TRUE(aliases.find(3, "iot21", automaton, 1).empty());
+  EXPECT_EQ(TopicAliasStatus::InvalidAlias, aliases.status());
+
+  EXPECT_TRUE(aliases.find(2, "", automaton, 1).empty());
+  EXPECT_EQ(TopicAliasStatus::UnknownAlias, aliases.status());
+
+  EXPECT_EQ(1, aliases.find(2, "iot21", automaton, 1).size());
+  aliases.clear();
+  EXPECT_TRUE(aliases.find(2, "", automaton, 1).empty());
+  EXPECT_EQ(TopicAliasStatus::UnknownAlias, aliases.status());
+}
+
+TEST_F(TestTopicAlias, TestLargeMaximum)
+{
+  auto automaton = build({{"iot21/#", 1}});
+  alias_table aliases{65535};
+
+  EXPECT_TRUE(aliases.find(100, "", automaton, 1).empty());
+  EXPECT_EQ(TopicAliasStatus::UnknownAlias, aliases.status());
+
+  EXPECT_EQ(1, aliases.find(65535, "iot21/Kitchen", automaton, 1).size());
+  EXPECT_EQ(1, aliases.find(1, "iot21/Lounge", automaton, 1).size());
+  EXPECT_EQ("iot21/Kitchen", aliases.topic(65535));
+  EXPECT_EQ(1, aliases.find(65535, "", automaton, 1).size());
+  EXPECT_EQ(1, aliases.hits());
+  EXPECT_TRUE(aliases.topic(100).empty());
+}
+
+} // namespace yafiyogi::yy_mqtt::tests
@@ -0,0 +1,219 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <algorithm>
+#include <array>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "yy_mqtt_art_topics.h"
+#include "yy_mqtt_dfa_topics.h"
+#include "yy_mqtt_fast_topics.h"
+#include "yy_mqtt_faster_topics.h"
+#include "yy_mqtt_flat_topics.h"
+#include "yy_mqtt_radix_topics.h"
+#include "yy_mqtt_retained_topics.h"
+#include "yy_mqtt_state_topics.h"
+#include "yy_mqtt_topic.h"
+#include "yy_mqtt_topics.h"
+#include "yy_mqtt_util.h"
+#include "yy_mqtt_variant_state_topics.h"
+
+namespace yafiyogi::yy_mqtt::tests {
+
+class TestTopic:
+      public testing::Test
+{
+  public:
+    using Values = std::vector<int>;
+
+    void SetUp() override
+    {
+    }
+
+    void TearDown() override
+    {
+    }
+
+    static constexpr std::array<std::string_view, 13> test_filters{
+      "#", "+", "+/+", "/+", "a", "a/b", "a/+", "a/#", "a/+/c", "+/b/#", "$SYS/#", "$SYS/+", "a//c"
+    };
+
+    static constexpr std::array<std::string_view, 12> test_topics{
+      "a", "a/b", "a/b/c", "a/", "a/b/", "/a", "/", "a//c", "b/b/b", "$SYS", "$SYS/a", "x"
+    };
+
+    template<typename Payloads>
+    static Values values(Payloads p_payloads)
+    {
+      Values l_values{};
+      for(const auto payload : p_payloads)
+      {
+        l_values.emplace_back(*payload);
+      }
+      std::sort(l_values.begin(), l_values.end());
+
+      return l_values;
+    }
+
+    // find(Topic) must return what find(std::string_view) does.
+    template<typename Builder>
+    static void check_find()
+    {
+      Builder builder{};
+      int value = 0;
+      for(const auto filter : test_filters)
+      {
+        builder.add(filter, value++);
+      }
+      auto automaton = builder.create_automaton();
+
+      for(const auto topic : test_topics)
+      {
+        const auto expected = values(automaton.find(topic));
+        EXPECT_EQ(expected, values(automaton.find(Topic{topic}))) << "topic [" << topic << "]";
+      }
+    }
+};
+
+TEST_F(TestTopic, TestLevels)
+{
+  const Topic topic{"sport/tennis/player1"};
+
+  EXPECT_TRUE(topic.valid());
+  EXPECT_EQ(TopicType::Name, topic.type());
+  EXPECT_EQ("sport/tennis/player1", topic.view());
+  ASSERT_EQ(3, topic.size());
+  EXPECT_EQ("sport", topic.level(0));
+  EXPECT_EQ("tennis", topic.level(1));
+  EXPECT_EQ("player1", topic.level(2));
+  EXPECT_EQ(0, topic.level_offset(0));
+  EXPECT_EQ(6, topic.level_offset(1));
+  EXPECT_EQ(13, topic.level_offset(2));
+  EXPECT_EQ(topic_level_hash("tennis"), topic.level_hash(1));
+  EXPECT_FALSE(topic.has_wildcards());
+  EXPECT_FALSE(topic.is_sys());
+
+  const Topic trailing{"/a/"};
+  ASSERT_EQ(3, trailing.size());
+  EXPECT_EQ("", trailing.level(0));
+  EXPECT_EQ("a", trailing.level(1));
+  EXPECT_EQ("", trailing.level(2));
+  EXPECT_EQ(topic_level_hash(""), trailing.level_hash(2));
+
+  EXPECT_TRUE(Topic{""}.empty());
+  EXPECT_TRUE(Topic{"$SYS/a"}.is_sys());
+}
+
+TEST_F(TestTopic, TestAssignReuses)
+{
+  Topic topic{"a/b/c/d"};
+
+  EXPECT_EQ(TopicValidStatus::Valid, topic.assign("x/y"));
+  ASSERT_EQ(2, topic.size());
+  EXPECT_EQ("x", topic.level(0));
+  EXPECT_EQ("y", topic.level(1));
+
+  EXPECT_EQ(TopicValidStatus::Invalid, topic.assign("x/+"));
+  EXPECT_FALSE(topic.valid());
+  EXPECT_EQ(TopicValidStatus::Valid, topic.assign("x/+", TopicType::Filter));
+  EXPECT_TRUE(topic.has_single_level_wildcard());
+  EXPECT_FALSE(topic.has_multi_level_wildcard());
+}
+
+TEST_F(TestTopic, TestValidateAgrees)
+{
+  constexpr std::array<std::string_view, 17> inputs{
+    "", "a", "a/b", "+", "#", "a/+", "a/#", "+/a/#", "a+", "a/b#", "#/a", "a/#/b",
+    "/", "a/", "+/+", "++", "$SYS/#"
+  };
+
+  for(const auto input : inputs)
+  {
+    for(const auto type : {TopicType::Name, TopicType::Filter})
+    {
+      const Topic topic{input, type};
+
+      EXPECT_EQ(topic_validate(input, type), topic.status()) << "[" << input << "]";
+      if(!input.empty())
+      {
+        EXPECT_EQ(topic_tokenize_view(input), topic.levels()) << "[" << input << "]";
+      }
+    }
+  }
+
+  EXPECT_EQ(TopicValidStatus::BadParam, Topic("a", static_cast<TopicType>(255)).status());
+}
+
+TEST_F(TestTopic, TestMatchAgrees)
+{
+  for(const auto filter : test_filters)
+  {
+    const Topic filter_topic{filter, TopicType::Filter};
+
+    for(const auto topic : test_topics)
+    {
+      const Topic name{topic};
+      const auto expected = topic_match(filter, topic);
+
+      EXPECT_EQ(expected, topic_match(filter, name)) << "filter [" << filter << "] topic [" << topic << "]";
+      EXPECT_EQ(expected, topic_match(filter_topic, name)) << "filter [" << filter << "] topic [" << topic << "]";
+    }
+  }
+}
+
+TEST_F(TestTopic, TestFindAgrees)
+{
+  check_find<topics<int>>();
+  check_find<flat_topics<int>>();
+  check_find<fast_topics<int>>();
+  check_find<faster_topics<int>>();
+  check_find<state_topics<int>>();
+  check_find<variant_state_topics<int>>();
+  check_find<dfa_topics<int>>();
+  check_find<art_topics<int>>();
+  check_find<radix_topics<int>>();
+}
+
+TEST_F(TestTopic, TestRetainedFind)
+{
+  retained_topics<int> retained{};
+  int value = 0;
+  for(const auto topic : test_topics)
+  {
+    retained.set(topic, value++);
+  }
+
+  for(const auto filter : test_filters)
+  {
+    const auto expected = values(retained.find(filter));
+    EXPECT_EQ(expected, values(retained.find(Topic{filter, TopicType::Filter}))) << "filter [" << filter << "]";
+  }
+}
+
+} // namespace yafiyogi::yy_mqtt::tests
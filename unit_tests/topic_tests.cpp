@@ -165,4 +165,37 @@ TEST_F(TestTopics, TestMosquittoValidNoMatching)
   EXPECT_TRUE(test_topic({{"$BOB/bar", 888}}, "$SYS/bar", Values{}));
 }
 
+TEST_F(TestTopics, TestSingleCharLevels)
+{
+  EXPECT_TRUE(test_topic({{"a/b/c", 111}}, "a/b/c", Values{111}));
+  EXPECT_TRUE(test_topic({{"a/+/c", 222}}, "a/b/c", Values{222}));
+  EXPECT_TRUE(test_topic({{"+/b/c", 333}}, "a/b/c", Values{333}));
+  EXPECT_TRUE(test_topic({{"a/b", 444}}, "a/b/c", Values{}));
+  EXPECT_TRUE(test_topic({{"a/b/c/#", 555}}, "a/b/c", Values{555}));
+}
+
+TEST_F(TestTopics, TestRepeatedFind)
+{
+  topics l_topics{};
+  l_topics.add("sport/tennis/+", 111);
+  l_topics.add("sport/#", 222);
+  l_topics.add("finance", 333);
+
+  auto automaton = l_topics.create_automaton();
+
+  for(int idx = 0; idx < 3; ++idx)
+  {
+    auto payloads = automaton.find("sport/tennis/player1");
+    ASSERT_EQ(2, payloads.size());
+    EXPECT_EQ(222, *payloads[0]);
+    EXPECT_EQ(111, *payloads[1]);
+
+    payloads = automaton.find("finance");
+    ASSERT_EQ(1, payloads.size());
+    EXPECT_EQ(333, *payloads[0]);
+
+    EXPECT_TRUE(automaton.find("weather").empty());
+  }
+}
+
 } // namespace yafiyogi::yy_mqtt::tests
@@ -24,11 +24,14 @@
 
 */
 
+#include <array>
+
 #include "fmt/format.h"
 
 #include "gtest/gtest.h"
 
 #include "yy_mqtt_constants.h"
+#include "yy_mqtt_topic.h"
 #include "yy_mqtt_util.h"
 
 
@@ -73,6 +76,32 @@ TEST_F(TestTopicUtil, TopicTokenize)
   EXPECT_EQ((TopicLevels{"", "abc", "def"}), yy_mqtt::topic_tokenize("/abc/def"));
 }
 
+TEST_F(TestTopicUtil, TopicTokenizeBuffer)
+{
+  TopicLevelsBuffer levels{};
+
+  for(const auto topic : {"abc", "abc/", "abc/def", "/abc", "/abc/", "/abc/def",
+                          "a-long-level-that-does-not-fit-sso/another-long-level-0001/x"})
+  {
+    yy_mqtt::topic_tokenize(levels, topic);
+
+    const auto expected{yy_mqtt::topic_tokenize(topic)};
+    ASSERT_EQ(expected.size(), levels.size()) << "[" << topic << "]";
+    for(size_t idx = 0; idx < expected.size(); ++idx)
+    {
+      EXPECT_EQ(expected[idx], levels[idx]) << "[" << topic << "]";
+    }
+  }
+
+  size_t count = 0;
+  for(const auto level : yy_mqtt::topic_tokenize(levels, "x/yy/zzz"))
+  {
+    EXPECT_EQ(++count, level.size());
+  }
+  EXPECT_EQ(3, count);
+  EXPECT_EQ(6, levels.char_count());
+}
+
 TEST_F(TestTopicUtil, TestValidateSingleLevelWildcard)
 {
   EXPECT_EQ(yy_mqtt::TopicValidStatus::Valid, yy_mqtt::topic_validate("+", yy_mqtt::TopicType::Filter));
@@ -112,6 +141,18 @@ TEST_F(TestTopicUtil, TestMatchSingleLevelWildcard)
   EXPECT_EQ(yy_mqtt::TopicMatchStatus::Fail, yy_mqtt::topic_match(yy_mqtt::topic_tokenize_view("+"), yy_mqtt::topic_tokenize_view("/finance")));
 }
 
+TEST_F(TestTopicUtil, TestMatchLevelCount)
+{
+  EXPECT_EQ(yy_mqtt::TopicMatchStatus::Fail, yy_mqtt::topic_match("sport/+", "sport"));
+  EXPECT_EQ(yy_mqtt::TopicMatchStatus::Fail, yy_mqtt::topic_match("sport/tennis", "sport/tennis/player1"));
+  EXPECT_EQ(yy_mqtt::TopicMatchStatus::Fail, yy_mqtt::topic_match("sport/+", "sport/tennis/player1"));
+  EXPECT_EQ(yy_mqtt::TopicMatchStatus::Fail, yy_mqtt::topic_match("", "sport"));
+
+  EXPECT_EQ(yy_mqtt::TopicMatchStatus::Fail, yy_mqtt::topic_match(yy_mqtt::topic_tokenize_view("sport/+"), yy_mqtt::topic_tokenize_view("sport")));
+  EXPECT_EQ(yy_mqtt::TopicMatchStatus::Fail, yy_mqtt::topic_match(yy_mqtt::topic_tokenize_view("sport/tennis"), yy_mqtt::topic_tokenize_view("sport/tennis/player1")));
+  EXPECT_EQ(yy_mqtt::TopicMatchStatus::Fail, yy_mqtt::topic_match(yy_mqtt::topic_tokenize_view("sport/+"), yy_mqtt::topic_tokenize_view("sport/tennis/player1")));
+}
+
 TEST_F(TestTopicUtil, TestValidateMultiLevelWildcard)
 {
   EXPECT_EQ(yy_mqtt::TopicValidStatus::Valid, yy_mqtt::topic_validate("#", yy_mqtt::TopicType::Filter));
@@ -155,4 +196,128 @@ TEST_F(TestTopicUtil, TestDollarMatch)
   EXPECT_EQ(yy_mqtt::TopicMatchStatus::Match, yy_mqtt::topic_match(yy_mqtt::topic_tokenize_view("$SYS/monitor/+"), yy_mqtt::topic_tokenize_view("$SYS/monitor/Clients")));
 }
 
+TEST_F(TestTopicUtil, TestFilterSubsumes)
+{
+  EXPECT_TRUE(yy_mqtt::filter_subsumes("a/#", "a/b/+"));
+  EXPECT_TRUE(yy_mqtt::filter_subsumes("a/#", "a/b/c"));
+  EXPECT_TRUE(yy_mqtt::filter_subsumes("a/#", "a"));
+  EXPECT_TRUE(yy_mqtt::filter_subsumes("a/#", "a/#"));
+  EXPECT_TRUE(yy_mqtt::filter_subsumes("a/b/+", "a/b/c"));
+  EXPECT_TRUE(yy_mqtt::filter_subsumes("+/+", "a/+"));
+  EXPECT_TRUE(yy_mqtt::filter_subsumes("#", "a/b/#"));
+  EXPECT_TRUE(yy_mqtt::filter_subsumes("a/+/#", "a/+"));
+  EXPECT_TRUE(yy_mqtt::filter_subsumes("a/b", "a/b"));
+  EXPECT_TRUE(yy_mqtt::filter_subsumes("$SYS/#", "$SYS/monitor/+"));
+
+  EXPECT_FALSE(yy_mqtt::filter_subsumes("a/b/+", "a/#"));
+  EXPECT_FALSE(yy_mqtt::filter_subsumes("a/b/c", "a/b/+"));
+  EXPECT_FALSE(yy_mqtt::filter_subsumes("a/+", "a/#"));
+  EXPECT_FALSE(yy_mqtt::filter_subsumes("a/+", "a/b/c"));
+  EXPECT_FALSE(yy_mqtt::filter_subsumes("a/+/#", "a/#"));
+  EXPECT_FALSE(yy_mqtt::filter_subsumes("a/b", "a"));
+  EXPECT_FALSE(yy_mqtt::filter_subsumes("a", "a/b"));
+  EXPECT_FALSE(yy_mqtt::filter_subsumes("a/b", "a/c"));
+  EXPECT_FALSE(yy_mqtt::filter_subsumes("#", "$SYS/monitor"));
+  EXPECT_FALSE(yy_mqtt::filter_subsumes("+/monitor", "$SYS/monitor"));
+  EXPECT_FALSE(yy_mqtt::filter_subsumes("a/#/b", "a/c/b"));
+  EXPECT_FALSE(yy_mqtt::filter_subsumes("a/#", "a/b+"));
+  EXPECT_FALSE(yy_mqtt::filter_subsumes("", "a"));
+}
+
+TEST_F(TestTopicUtil, TestParseShared)
+{
+  SharedSubscription shared{};
+
+  EXPECT_TRUE(yy_mqtt::topic_parse_shared("$share/workers/iot21/#", shared));
+  EXPECT_EQ("workers", shared.share_name);
+  EXPECT_EQ("iot21/#", shared.filter);
+
+  EXPECT_TRUE(yy_mqtt::topic_parse_shared("$share/g/+", shared));
+  EXPECT_EQ("g", shared.share_name);
+  EXPECT_EQ("+", shared.filter);
+
+  EXPECT_FALSE(yy_mqtt::topic_parse_shared("iot21/#", shared));
+  EXPECT_FALSE(yy_mqtt::topic_parse_shared("$share/workers", shared));
+  EXPECT_FALSE(yy_mqtt::topic_parse_shared("$share/workers/", shared));
+  EXPECT_FALSE(yy_mqtt::topic_parse_shared("$share//iot21", shared));
+  EXPECT_FALSE(yy_mqtt::topic_parse_shared("$share/work+/iot21", shared));
+  EXPECT_FALSE(yy_mqtt::topic_parse_shared("$share/work#/iot21", shared));
+  EXPECT_FALSE(yy_mqtt::topic_parse_shared("$share/workers/iot21/#/x", shared));
+  EXPECT_FALSE(yy_mqtt::topic_parse_shared("$shared/workers/iot21", shared));
+}
+
+TEST_F(TestTopicUtil, TestMatchMany)
+{
+  const std::array<std::string_view, 10> filters{
+    "sport/tennis/+",
+    "sport/#",
+    "#",
+    "+/+/+",
+    "sport/+",
+    "sport/tennis/player1",
+    "sport/tennis/player2",
+    "finance/#",
+    "+/tennis/#",
+    "sport/tennis/player1/#"
+  };
+  TopicMatchResults results{};
+
+  yy_mqtt::topic_match_many("sport/tennis/player1", yy_quad::make_const_span(filters), results);
+
+  ASSERT_EQ(filters.size(), results.size());
+  EXPECT_EQ(yy_mqtt::TopicMatchStatus::Match, results[0]);
+  EXPECT_EQ(yy_mqtt::TopicMatchStatus::Match, results[1]);
+  EXPECT_EQ(yy_mqtt::TopicMatchStatus::Match, results[2]);
+  EXPECT_EQ(yy_mqtt::TopicMatchStatus::Match, results[3]);
+  EXPECT_EQ(yy_mqtt::TopicMatchStatus::Fail, results[4]);
+  EXPECT_EQ(yy_mqtt::TopicMatchStatus::Match, results[5]);
+  EXPECT_EQ(yy_mqtt::TopicMatchStatus::Fail, results[6]);
+  EXPECT_EQ(yy_mqtt::TopicMatchStatus::Fail, results[7]);
+  EXPECT_EQ(yy_mqtt::TopicMatchStatus::Match, results[8]);
+  EXPECT_EQ(yy_mqtt::TopicMatchStatus::Match, results[9]);
+
+  yy_mqtt::topic_match_many("$SYS/monitor", yy_quad::make_const_span(filters), results);
+
+  ASSERT_EQ(filters.size(), results.size());
+  EXPECT_EQ(yy_mqtt::TopicMatchStatus::Fail, results[2]);
+  EXPECT_EQ(yy_mqtt::TopicMatchStatus::Fail, results[3]);
+}
+
+TEST_F(TestTopicUtil, TestMatchManyAgreesWithMatch)
+{
+  const std::array<std::string_view, 22> filters{
+    "#", "+", "+/+", "+/+/+", "/+", "/#", "+/#",
+    "a", "a/b", "a/b/c", "a/+", "a/+/c", "a/#", "a/b/#", "a/+/#",
+    "+/b", "+/b/+", "a//c", "a/+/", "$SYS/#", "$SYS/+", "b/#"
+  };
+  const std::array<std::string_view, 16> topics{
+    "a", "a/b", "a/b/c", "a/b/c/d", "a/", "a/b/", "/a", "/a/",
+    "/", "//", "a//c", "b", "b/b", "$SYS", "$SYS/a", "$SYS/a/b"
+  };
+  topic_matcher matcher{};
+  TopicMatchResults results{};
+
+  for(const auto topic : topics)
+  {
+    matcher.topic(topic);
+    matcher.match_many(yy_quad::make_const_span(filters), results);
+
+    ASSERT_EQ(filters.size(), results.size());
+    for(size_t idx = 0; idx < filters.size(); ++idx)
+    {
+      EXPECT_EQ(yy_mqtt::topic_match(filters[idx], topic), results[idx])
+        << "filter [" << filters[idx] << "] topic [" << topic << "]";
+      EXPECT_EQ(yy_mqtt::topic_match(yy_mqtt::topic_tokenize_view(filters[idx]),
+                                     yy_mqtt::topic_tokenize_view(topic)),
+                results[idx])
+        << "filter [" << filters[idx] << "] topic [" << topic << "]";
+      EXPECT_EQ(yy_mqtt::topic_match(filters[idx], Topic{topic}), results[idx])
+        << "filter [" << filters[idx] << "] topic [" << topic << "]";
+      EXPECT_EQ(yy_mqtt::topic_match(Topic{filters[idx], TopicType::Filter}, Topic{topic}),
+                results[idx])
+        << "filter [" << filters[idx] << "] topic [" << topic << "]";
+    }
+  }
+}
+
 } // namespace yafiyogi::yy_mqtt::tests
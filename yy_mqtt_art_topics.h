@@ -0,0 +1,513 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include <algorithm>
+#include <array>
+#include <string_view>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "yy_cpp/yy_span.h"
+#include "yy_cpp/yy_vector.h"
+
+#include "yy_mqtt_char_trie.h"
+#include "yy_mqtt_constants.h"
+#include "yy_mqtt_topic.h"
+
+namespace yafiyogi::yy_mqtt {
+namespace art_topics_detail {
+
+using node_idx = char_trie_detail::node_idx;
+
+inline constexpr node_idx no_node = char_trie_detail::no_node;
+inline constexpr node_idx no_payload = char_trie_detail::no_payload;
+inline constexpr node_idx root_node = char_trie_detail::root_node;
+
+// Adaptive radix tree node kinds, picked by fan-out when the
+// automaton is created.
+enum class node_kind:uint8_t {Leaf, Node4, Node16, Node48, Node256};
+
+inline constexpr size_type node_kind_count = 5;
+
+struct art_node final
+{
+    node_idx payload = no_payload;
+    node_idx slot = 0; // Index into the array for kind.
+    node_kind kind = node_kind::Leaf;
+    uint8_t count = 0;
+};
+
+struct node4 final
+{
+    std::array<uint8_t, 4> keys{};
+    std::array<node_idx, 4> children{};
+};
+
+struct node16 final
+{
+    alignas(16) std::array<uint8_t, 16> keys{};
+    std::array<node_idx, 16> children{};
+};
+
+struct node48 final
+{
+    std::array<uint8_t, 256> index{}; // 0: no child, otherwise child slot + 1.
+    std::array<node_idx, 48> children{};
+};
+
+struct node256 final
+{
+    std::array<node_idx, 256> children{};
+};
+
+struct art_tables final
+{
+    yy_quad::simple_vector<art_node> nodes{};
+    yy_quad::simple_vector<node4> nodes4{};
+    yy_quad::simple_vector<node16> nodes16{};
+    yy_quad::simple_vector<node48> nodes48{};
+    yy_quad::simple_vector<node256> nodes256{};
+
+    [[nodiscard]]
+    node_idx find_edge(node_idx p_node,
+                       char p_label) const noexcept
+    {
+      const auto & node = nodes[p_node];
+      const auto label = static_cast<uint8_t>(p_label);
+
+      switch(node.kind)
+      {
+        case node_kind::Leaf:
+          break;
+
+        case node_kind::Node4:
+        {
+          const auto & edges = nodes4[node.slot];
+          for(uint8_t idx = 0; idx < node.count; ++idx)
+          {
+            if(label == edges.keys[idx])
+            {
+              return edges.children[idx];
+            }
+          }
+          break;
+        }
+
+        case node_kind::Node16:
+        {
+          const auto & edges = nodes16[node.slot];
+#if defined(__SSE2__)
+          const __m128i keys = _mm_load_si128(reinterpret_cast<const __m128i *>(edges.keys.data()));
+          const __m128i cmp = _mm_cmpeq_epi8(keys, _mm_set1_epi8(static_cast<char>(label)));
+          const auto mask = static_cast<unsigned>(_mm_movemask_epi8(cmp)) & ((1U << node.count) - 1U);
+
+          if(0 != mask)
+          {
+            return edges.children[static_cast<size_type>(__builtin_ctz(mask))];
+          }
+#else
+          const auto keys_end = edges.keys.begin() + node.count;
+          if(auto key = std::lower_bound(edges.keys.begin(), keys_end, label);
+             (keys_end != key) && (label == *key))
+          {
+            return edges.children[static_cast<size_type>(key - edges.keys.begin())];
+          }
+#endif
+          break;
+        }
+
+        case node_kind::Node48:
+        {
+          const auto & edges = nodes48[node.slot];
+          if(const auto idx = edges.index[label];
+             0 != idx)
+          {
+            return edges.children[idx - 1U];
+          }
+          break;
+        }
+
+        case node_kind::Node256:
+          return nodes256[node.slot].children[label];
+      }
+
+      return no_node;
+    }
+
+    [[nodiscard]]
+    size_type memory_size() const noexcept
+    {
+      return (nodes.size() * sizeof(art_node))
+        + (nodes4.size() * sizeof(node4))
+        + (nodes16.size() * sizeof(node16))
+        + (nodes48.size() * sizeof(node48))
+        + (nodes256.size() * sizeof(node256));
+    }
+};
+
+inline void build_tables(const char_trie & p_trie,
+                         art_tables & p_tables)
+{
+  p_tables.nodes.clear();
+  p_tables.nodes.reserve(p_trie.nodes().size());
+
+  for(const auto & build : p_trie.nodes())
+  {
+    art_node node{};
+    node.payload = build.payload;
+    node.count = static_cast<uint8_t>(std::min(build.edges.size(), size_type{255}));
+
+    const size_type count = build.edges.size();
+    if(0 == count)
+    {
+      node.kind = node_kind::Leaf;
+    }
+    else if(count <= 4)
+    {
+      node.kind = node_kind::Node4;
+      node.slot = static_cast<node_idx>(p_tables.nodes4.size());
+      auto & edges = p_tables.nodes4.emplace_back();
+      for(size_type idx = 0; idx < count; ++idx)
+      {
+        std::tie(edges.keys[idx], edges.children[idx]) = build.edges[idx];
+      }
+    }
+    else if(count <= 16)
+    {
+      node.kind = node_kind::Node16;
+      node.slot = static_cast<node_idx>(p_tables.nodes16.size());
+      auto & edges = p_tables.nodes16.emplace_back();
+      for(size_type idx = 0; idx < count; ++idx)
+      {
+        std::tie(edges.keys[idx], edges.children[idx]) = build.edges[idx];
+      }
+    }
+    else if(count <= 48)
+    {
+      node.kind = node_kind::Node48;
+      node.slot = static_cast<node_idx>(p_tables.nodes48.size());
+      auto & edges = p_tables.nodes48.emplace_back();
+      for(size_type idx = 0; idx < count; ++idx)
+      {
+        const auto [label, child] = build.edges[idx];
+        edges.index[label] = static_cast<uint8_t>(idx + 1);
+        edges.children[idx] = child;
+      }
+    }
+    else
+    {
+      node.kind = node_kind::Node256;
+      node.slot = static_cast<node_idx>(p_tables.nodes256.size());
+      auto & edges = p_tables.nodes256.emplace_back();
+      edges.children.fill(no_node);
+      for(const auto & [label, child] : build.edges)
+      {
+        edges.children[label] = child;
+      }
+    }
+
+    p_tables.nodes.emplace_back(node);
+  }
+}
+
+template<typename ValueType>
+class Query final
+{
+  public:
+    using value_type = ValueType;
+    using value_ptr = value_type *;
+    using data_vector = yy_quad::simple_vector<value_type>;
+    using payloads_type = yy_quad::simple_vector<value_ptr>;
+    using payloads_span_type = yy_quad::span<typename payloads_type::value_type>;
+    enum class search_type:uint8_t {Literal, SingleLevel, MultiLevel};
+
+    struct state_type final
+    {
+        std::string_view topic{};
+        node_idx state = root_node;
+        search_type search = search_type::Literal;
+    };
+    using queue = yy_quad::simple_vector<state_type>;
+
+    constexpr explicit Query(art_tables && p_tables,
+                             data_vector && p_data) noexcept:
+      m_tables(std::move(p_tables)),
+      m_data(std::move(p_data))
+    {
+      m_search_states.reserve(6);
+      m_payloads.reserve(3);
+    }
+
+    constexpr Query() noexcept = default;
+    Query(const Query &) = delete;
+    constexpr Query(Query &&) noexcept = default;
+    constexpr ~Query() noexcept = default;
+
+    Query & operator=(const Query &) = delete;
+    constexpr Query & operator=(Query &&) noexcept = default;
+
+    [[nodiscard]]
+    constexpr payloads_span_type find(std::string_view p_topic) noexcept
+    {
+      m_search_states.clear(yy_quad::ClearAction::Keep);
+      m_payloads.clear(yy_quad::ClearAction::Keep);
+
+      if(!p_topic.empty() && !m_tables.nodes.empty())
+      {
+        find_span(p_topic);
+      }
+
+      return yy_quad::make_span(m_payloads);
+    }
+
+    [[nodiscard]]
+    constexpr payloads_span_type find(const Topic & p_topic) noexcept
+    {
+      return find(p_topic.view());
+    }
+
+    // Bytes used by the trie nodes.
+    [[nodiscard]]
+    constexpr size_type memory_size() const noexcept
+    {
+      return m_tables.memory_size();
+    }
+
+    [[nodiscard]]
+    constexpr size_type node_count(node_kind p_kind) const noexcept
+    {
+      return static_cast<size_type>(std::count_if(m_tables.nodes.begin(), m_tables.nodes.end(),
+                                                  [p_kind](const art_node & node) {
+                                                    return p_kind == node.kind;
+                                                  }));
+    }
+
+  private:
+    constexpr void add_payload(node_idx p_node) noexcept
+    {
+      if(const auto payload = m_tables.nodes[p_node].payload;
+         no_payload != payload)
+      {
+        m_payloads.emplace_back(&m_data[payload]);
+      }
+    }
+
+    constexpr void add_sub_state(char p_label,
+                                 std::string_view p_topic,
+                                 search_type p_type,
+                                 node_idx p_node) noexcept
+    {
+      if(const auto next = m_tables.find_edge(p_node, p_label);
+         no_node != next)
+      {
+        m_search_states.emplace_back(p_topic, next, p_type);
+      }
+    }
+
+    constexpr void add_wildcards(node_idx p_node,
+                                 std::string_view p_topic) noexcept
+    {
+      add_sub_state(mqtt_detail::TopicSingleLevelWildcardChar, p_topic, search_type::SingleLevel, p_node);
+      add_sub_state(mqtt_detail::TopicMultiLevelWildcardChar, p_topic, search_type::MultiLevel, p_node);
+    }
+
+    // 'abc/#' matches 'abc'.
+    constexpr void add_parent_multi_level(node_idx p_node) noexcept
+    {
+      if(const auto separator = m_tables.find_edge(p_node, mqtt_detail::TopicLevelSeparatorChar);
+         no_node != separator)
+      {
+        add_sub_state(mqtt_detail::TopicMultiLevelWildcardChar, std::string_view{}, search_type::MultiLevel, separator);
+      }
+    }
+
+    constexpr void literal_find(std::string_view p_topic,
+                                node_idx p_state) noexcept
+    {
+      for(size_type idx = 0; idx < p_topic.size(); ++idx)
+      {
+        const char ch = p_topic[idx];
+
+        p_state = m_tables.find_edge(p_state, ch);
+        if(no_node == p_state)
+        {
+          return;
+        }
+
+        if(mqtt_detail::TopicLevelSeparatorChar == ch)
+        {
+          // Topic is 'abc/cde/', try to match 'abc/cde/+' & 'abc/cde/#'
+          add_wildcards(p_state, p_topic.substr(idx + 1));
+        }
+      }
+
+      // Topic is 'abc/cde' or 'abc/cde/', add any payloads.
+      add_payload(p_state);
+      // 'abc/cde/#' matches 'abc/cde', 'abc/cde//#' matches 'abc/cde/'.
+      add_parent_multi_level(p_state);
+    }
+
+    constexpr void single_level_find(std::string_view p_topic,
+                                     node_idx p_state) noexcept
+    {
+      const auto pos = p_topic.find(mqtt_detail::TopicLevelSeparatorChar);
+
+      if(std::string_view::npos == pos)
+      {
+        // Topic is 'abc/+'.
+        add_payload(p_state);
+        add_parent_multi_level(p_state);
+        return;
+      }
+
+      const auto rest_topic{p_topic.substr(pos + 1)};
+      if(rest_topic.empty())
+      {
+        // Topic 'abc/cde/' matches 'abc/+'.
+        add_payload(p_state);
+      }
+
+      if(const auto separator = m_tables.find_edge(p_state, mqtt_detail::TopicLevelSeparatorChar);
+         no_node != separator)
+      {
+        if(rest_topic.empty())
+        {
+          // Topic 'abc/cde/' matches 'abc/+/' and 'abc/+//#'.
+          add_payload(separator);
+          add_parent_multi_level(separator);
+        }
+        else
+        {
+          // Try to match 'abc/+/cde'.
+          m_search_states.emplace_back(rest_topic, separator, search_type::Literal);
+        }
+        // Try to match 'abc/+/+' and 'abc/+/#'.
+        add_wildcards(separator, rest_topic);
+      }
+    }
+
+    constexpr void find_span(std::string_view p_topic) noexcept
+    {
+      m_search_states.emplace_back(p_topic, root_node, search_type::Literal);
+      if(mqtt_detail::TopicSysChar != p_topic[0])
+      {
+        add_wildcards(root_node, p_topic);
+      }
+
+      for(size_type head = 0; head < m_search_states.size(); ++head)
+      {
+        const auto [search_topic, state, type] = m_search_states[head];
+
+        switch(type)
+        {
+          case search_type::Literal:
+            literal_find(search_topic, state);
+            break;
+
+          case search_type::SingleLevel:
+            single_level_find(search_topic, state);
+            break;
+
+          case search_type::MultiLevel:
+            add_payload(state);
+            break;
+        }
+      }
+    }
+
+    art_tables m_tables{};
+    data_vector m_data{};
+    queue m_search_states{};
+    payloads_type m_payloads{};
+};
+
+} // namespace art_topics_detail
+
+// Character level filter trie. Nodes are built as a simple trie and
+// converted to adaptive radix tree nodes (4/16/48/256 way) by
+// create_automaton(), so sparse nodes stay small and dense nodes
+// are a direct index.
+template<typename ValueType>
+class art_topics final
+{
+  public:
+    using value_type = ValueType;
+    using automaton_type = art_topics_detail::Query<value_type>;
+    using data_vector = typename automaton_type::data_vector;
+    using node_idx = art_topics_detail::node_idx;
+
+    art_topics() = default;
+    art_topics(const art_topics &) = default;
+    art_topics(art_topics &&) noexcept = default;
+    ~art_topics() = default;
+
+    art_topics & operator=(const art_topics &) = default;
+    art_topics & operator=(art_topics &&) noexcept = default;
+
+    void add(std::string_view p_filter,
+             value_type p_value)
+    {
+      if(auto & payload = m_trie[m_trie.add(p_filter)].payload;
+         art_topics_detail::no_payload == payload)
+      {
+        payload = static_cast<node_idx>(m_values.size());
+        m_values.emplace_back(std::move(p_value));
+      }
+      else
+      {
+        m_values[payload] = std::move(p_value);
+      }
+    }
+
+    [[nodiscard]]
+    automaton_type create_automaton() const
+    {
+      art_topics_detail::art_tables tables{};
+      art_topics_detail::build_tables(m_trie, tables);
+
+      data_vector data{};
+      data.reserve(m_values.size());
+      for(const auto & value : m_values)
+      {
+        data.emplace_back(value);
+      }
+
+      return automaton_type{std::move(tables), std::move(data)};
+    }
+
+  private:
+    char_trie m_trie{};
+    std::vector<value_type> m_values{};
+};
+
+} // namespace yafiyogi::yy_mqtt
@@ -0,0 +1,443 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "yy_cpp/yy_span.h"
+#include "yy_cpp/yy_vector.h"
+
+#include "yy_mqtt_constants.h"
+#include "yy_mqtt_roaring.h"
+#include "yy_mqtt_topic.h"
+#include "yy_mqtt_util.h"
+
+namespace yafiyogi::yy_mqtt {
+namespace bitmap_topics_detail {
+
+using filter_idx = uint32_t;
+
+struct token_hash final
+{
+    using is_transparent = void;
+
+    [[nodiscard]]
+    std::size_t operator()(std::string_view p_token) const noexcept
+    {
+      return std::hash<std::string_view>{}(p_token);
+    }
+};
+
+// Bitmaps of the filters at one depth.
+struct bitmap_level final
+{
+    std::unordered_map<std::string, roaring_range, token_hash, std::equal_to<>> literals{};
+    roaring_range single{}; // '+' at this depth.
+    roaring_range multi{}; // '#' at this depth.
+    roaring_range length{}; // Filters of exactly this many levels, no '#'.
+};
+
+using levels_type = std::vector<bitmap_level>;
+
+// Filters in literal or in single.
+struct term final
+{
+    roaring_view literal{};
+    roaring_view single{};
+    size_type size = 0;
+};
+
+using terms_type = yy_quad::simple_vector<term>;
+
+template<typename ValueType>
+class Query final
+{
+  public:
+    using value_type = ValueType;
+    using value_ptr = value_type *;
+    using data_vector = yy_quad::simple_vector<value_type>;
+    using payloads_type = yy_quad::simple_vector<value_ptr>;
+    using payloads_span_type = yy_quad::span<typename payloads_type::value_type>;
+
+    Query(roaring_bitmap && p_bitmaps,
+          levels_type && p_levels,
+          data_vector && p_data) noexcept:
+      m_bitmaps(std::move(p_bitmaps)),
+      m_levels(std::move(p_levels)),
+      m_data(std::move(p_data))
+    {
+      m_payloads.reserve(3);
+    }
+
+    Query() noexcept = default;
+    Query(const Query &) = delete;
+    Query(Query &&) noexcept = default;
+    ~Query() noexcept = default;
+
+    Query & operator=(const Query &) = delete;
+    Query & operator=(Query &&) noexcept = default;
+
+    [[nodiscard]]
+    payloads_span_type find(std::string_view p_topic) noexcept
+    {
+      m_payloads.clear(yy_quad::ClearAction::Keep);
+
+      if(!p_topic.empty())
+      {
+        find_levels(topic_tokenize_view(m_levels_view, p_topic), mqtt_detail::TopicSysChar == p_topic[0]);
+      }
+
+      return yy_quad::make_span(m_payloads);
+    }
+
+    [[nodiscard]]
+    payloads_span_type find(const Topic & p_topic) noexcept
+    {
+      m_payloads.clear(yy_quad::ClearAction::Keep);
+
+      if(!p_topic.empty())
+      {
+        find_levels(p_topic.levels(), p_topic.is_sys());
+      }
+
+      return yy_quad::make_span(m_payloads);
+    }
+
+    // Bytes used by the bitmaps, the per-depth literal dictionaries
+    // and the values. A dictionary node is counted as its entry, a next
+    // pointer and a cached hash; a key's buffer only counts when it is
+    // too long for the string's own storage.
+    [[nodiscard]]
+    size_type memory_size() const noexcept
+    {
+      using literal_entry = typename decltype(bitmap_level::literals)::value_type;
+      constexpr size_type node_size = sizeof(literal_entry) + sizeof(void *) + sizeof(size_t);
+      const size_type inline_capacity = std::string{}.capacity();
+
+      size_type literals_size = 0;
+      for(const auto & level : m_levels)
+      {
+        literals_size += (level.literals.bucket_count() * sizeof(void *))
+          + (level.literals.size() * node_size);
+
+        for(const auto & [literal, range] : level.literals)
+        {
+          if(literal.capacity() > inline_capacity)
+          {
+            literals_size += literal.capacity() + 1;
+          }
+        }
+      }
+
+      return m_bitmaps.memory_size()
+        + (m_levels.size() * sizeof(bitmap_level))
+        + literals_size
+        + (m_data.size() * sizeof(value_type));
+    }
+
+  private:
+    [[nodiscard]]
+    roaring_view bitmap(roaring_range p_range) const noexcept
+    {
+      return m_bitmaps.view(p_range);
+    }
+
+    // A filter matches when it is in every term of one of the topic's
+    // conjunctions. A term is a bitmap, or the union of the literal and
+    // '+' bitmaps at a depth, which is never built whole.
+    template<typename LevelsType>
+    void find_levels(const LevelsType & p_topic_levels,
+                     bool p_sys) noexcept
+    {
+      m_result.clear();
+      m_depth_terms.clear(yy_quad::ClearAction::Keep);
+
+      const auto size = p_topic_levels.size();
+      const auto depths = std::min(size, m_levels.size());
+
+      for(size_type depth = 0; depth < depths; ++depth)
+      {
+        const auto & level = m_levels[depth];
+        roaring_view literal{};
+        if(auto found = level.literals.find(p_topic_levels[depth]);
+           level.literals.end() != found)
+        {
+          literal = bitmap(found->second);
+        }
+
+        // mqtt-v5.0 4.7.2 Topics beginning with $
+        // Wildcards at the first level do not match topics beginning with '$'.
+        m_depth_terms.emplace_back(make_term(literal, wildcards(p_sys, depth) ? bitmap(level.single) : roaring_view{}));
+      }
+
+      for(size_type depth = 0; depth <= depths; ++depth)
+      {
+        // 'abc/#' matches 'abc/cde' and 'abc'.
+        if((depth < m_levels.size()) && wildcards(p_sys, depth))
+        {
+          conjunction(depth, make_term(bitmap(m_levels[depth].multi), roaring_view{}));
+        }
+      }
+
+      if(size < m_levels.size())
+      {
+        conjunction(size, make_term(bitmap(m_levels[size].length), roaring_view{}));
+      }
+
+      // Topic is 'abc/cde/', 'abc/+' matches it.
+      if((size > 1) && (size <= m_levels.size()) && p_topic_levels[size - 1].empty() && wildcards(p_sys, size - 2))
+      {
+        const auto single = make_term(bitmap(m_levels[size - 2].single), roaring_view{});
+        conjunction(size - 2, make_term(bitmap(m_levels[size - 1].length), roaring_view{}), &single);
+      }
+
+      m_result.view().for_each([this](filter_idx p_filter) {
+        m_payloads.emplace_back(&m_data[p_filter]);
+      });
+    }
+
+    [[nodiscard]]
+    static bool wildcards(bool p_sys,
+                          size_type p_depth) noexcept
+    {
+      return !p_sys || (0 != p_depth);
+    }
+
+    [[nodiscard]]
+    static term make_term(roaring_view p_literal,
+                          roaring_view p_single) noexcept
+    {
+      return term{p_literal, p_single, p_literal.cardinality() + p_single.cardinality()};
+    }
+
+    // Adds to the result the filters in p_last and in the terms of
+    // the first p_depths depths (and p_extra), intersecting the
+    // smallest terms first.
+    void conjunction(size_type p_depths,
+                     const term & p_last,
+                     const term * p_extra = nullptr)
+    {
+      m_terms.clear(yy_quad::ClearAction::Keep);
+      m_terms.emplace_back(p_last);
+      for(size_type depth = 0; depth < p_depths; ++depth)
+      {
+        m_terms.emplace_back(m_depth_terms[depth]);
+      }
+      if(nullptr != p_extra)
+      {
+        m_terms.emplace_back(*p_extra);
+      }
+
+      std::sort(m_terms.begin(), m_terms.end(), [](const term & p_lhs, const term & p_rhs) {
+        return p_lhs.size < p_rhs.size;
+      });
+
+      if(0 == m_terms[0].size)
+      {
+        return;
+      }
+
+      m_alive.assign_or(m_terms[0].literal, m_terms[0].single);
+      for(size_type idx = 1; idx < m_terms.size(); ++idx)
+      {
+        const auto & next = m_terms[idx];
+
+        m_both.assign_and(m_alive.view(), next.literal);
+        if(next.single.empty())
+        {
+          std::swap(m_alive, m_both);
+        }
+        else
+        {
+          m_found.assign_and(m_alive.view(), next.single);
+          m_alive.assign_or(m_both.view(), m_found.view());
+        }
+
+        if(m_alive.empty())
+        {
+          return;
+        }
+      }
+
+      m_both.assign_or(m_result.view(), m_alive.view());
+      std::swap(m_result, m_both);
+    }
+
+    roaring_bitmap m_bitmaps{};
+    levels_type m_levels{};
+    data_vector m_data{};
+    roaring_bitmap m_alive{};
+    roaring_bitmap m_result{};
+    roaring_bitmap m_both{};
+    roaring_bitmap m_found{};
+    terms_type m_depth_terms{};
+    terms_type m_terms{};
+    TopicLevelsView m_levels_view{};
+    payloads_type m_payloads{};
+};
+
+} // namespace bitmap_topics_detail
+
+// Inverted index of filters: for each depth, a roaring bitmap of the
+// filters with each literal level there, plus bitmaps of those with
+// '+' or '#' there. A lookup intersects, per topic level, the literal
+// and '+' bitmaps starting from the most selective level, so its cost
+// follows the fewest filters any level selects rather than the shape
+// of a trie.
+template<typename ValueType>
+class bitmap_topics final
+{
+  public:
+    using value_type = ValueType;
+    using automaton_type = bitmap_topics_detail::Query<value_type>;
+    using data_vector = typename automaton_type::data_vector;
+
+    bitmap_topics() = default;
+    bitmap_topics(const bitmap_topics &) = delete;
+    bitmap_topics(bitmap_topics &&) noexcept = default;
+    ~bitmap_topics() = default;
+
+    bitmap_topics & operator=(const bitmap_topics &) = delete;
+    bitmap_topics & operator=(bitmap_topics &&) noexcept = default;
+
+    // Filters that are not valid, or have no levels, are ignored.
+    void add(std::string_view p_filter,
+             value_type p_value)
+    {
+      if((TopicValidStatus::Valid != topic_validate(p_filter, TopicType::Filter))
+         || topic_tokenize_view(p_filter).empty())
+      {
+        return;
+      }
+
+      auto [found, added] = m_index.try_emplace(std::string{p_filter}, static_cast<bitmap_topics_detail::filter_idx>(m_filters.size()));
+      if(!added)
+      {
+        m_values[found->second] = std::move(p_value);
+        return;
+      }
+
+      m_filters.emplace_back(p_filter);
+      m_values.emplace_back(std::move(p_value));
+    }
+
+    [[nodiscard]]
+    automaton_type create_automaton() const
+    {
+      using bitmap_topics_detail::filter_idx;
+
+      struct level_ids final
+      {
+          std::unordered_map<std::string_view, std::vector<filter_idx>> literals{};
+          std::vector<filter_idx> single{};
+          std::vector<filter_idx> multi{};
+          std::vector<filter_idx> length{};
+      };
+
+      // Ids are added in ascending order, as roaring_bitmap::append() needs.
+      std::vector<level_ids> ids{};
+      TopicLevelsView levels{};
+      for(size_type idx = 0; idx < m_filters.size(); ++idx)
+      {
+        const auto filter = static_cast<filter_idx>(idx);
+        topic_tokenize_view(levels, m_filters[idx]);
+
+        if(ids.size() <= levels.size())
+        {
+          ids.resize(levels.size() + 1);
+        }
+
+        for(size_type depth = 0; depth < levels.size(); ++depth)
+        {
+          const std::string_view level = levels[depth];
+
+          if(mqtt_detail::TopicSingleLevelWildcard == level)
+          {
+            ids[depth].single.emplace_back(filter);
+          }
+          else if(mqtt_detail::TopicMultiLevelWildcard == level)
+          {
+            ids[depth].multi.emplace_back(filter);
+          }
+          else
+          {
+            ids[depth].literals[level].emplace_back(filter);
+          }
+        }
+
+        if(levels.empty())
+        {
+          continue;
+        }
+
+        if(mqtt_detail::TopicMultiLevelWildcard != levels[levels.size() - 1])
+        {
+          ids[levels.size()].length.emplace_back(filter);
+        }
+      }
+
+      roaring_bitmap bitmaps{};
+      bitmap_topics_detail::levels_type bitmap_levels(ids.size());
+      for(size_type depth = 0; depth < ids.size(); ++depth)
+      {
+        auto & level = bitmap_levels[depth];
+
+        level.literals.reserve(ids[depth].literals.size());
+        for(const auto & [literal, literal_ids] : ids[depth].literals)
+        {
+          level.literals.emplace(literal, bitmaps.append(yy_quad::make_const_span(literal_ids)));
+        }
+        level.single = bitmaps.append(yy_quad::make_const_span(ids[depth].single));
+        level.multi = bitmaps.append(yy_quad::make_const_span(ids[depth].multi));
+        level.length = bitmaps.append(yy_quad::make_const_span(ids[depth].length));
+      }
+
+      data_vector data{};
+      data.reserve(m_values.size());
+      for(const auto & value : m_values)
+      {
+        data.emplace_back(value);
+      }
+
+      return automaton_type{std::move(bitmaps), std::move(bitmap_levels), std::move(data)};
+    }
+
+  private:
+    std::unordered_map<std::string, bitmap_topics_detail::filter_idx> m_index{};
+    std::vector<std::string> m_filters{};
+    std::vector<value_type> m_values{};
+};
+
+} // namespace yafiyogi::yy_mqtt
@@ -0,0 +1,131 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include <algorithm>
+#include <limits>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+namespace yafiyogi::yy_mqtt {
+namespace char_trie_detail {
+
+using node_idx = uint32_t;
+
+inline constexpr node_idx no_node = std::numeric_limits<node_idx>::max();
+inline constexpr node_idx no_payload = std::numeric_limits<node_idx>::max();
+inline constexpr node_idx root_node = 0;
+
+struct char_node final
+{
+    std::vector<std::tuple<uint8_t, node_idx>> edges{}; // Sorted by label.
+    node_idx payload = no_payload;
+};
+
+} // namespace char_trie_detail
+
+// Filter trie with one edge per character. Used as the build-time
+// trie for the character level engines.
+class char_trie final
+{
+  public:
+    using node_idx = char_trie_detail::node_idx;
+    using node_type = char_trie_detail::char_node;
+    using nodes_type = std::vector<node_type>;
+
+    char_trie():
+      m_nodes(1)
+    {
+    }
+
+    char_trie(const char_trie &) = default;
+    char_trie(char_trie &&) noexcept = default;
+    ~char_trie() = default;
+
+    char_trie & operator=(const char_trie &) = default;
+    char_trie & operator=(char_trie &&) noexcept = default;
+
+    // Returns the node matching the last character of p_filter.
+    node_idx add(std::string_view p_filter)
+    {
+      node_idx node = char_trie_detail::root_node;
+
+      for(const char ch : p_filter)
+      {
+        node = add_edge(node, static_cast<uint8_t>(ch));
+      }
+
+      return node;
+    }
+
+    [[nodiscard]]
+    node_type & operator[](node_idx p_idx) noexcept
+    {
+      return m_nodes[p_idx];
+    }
+
+    [[nodiscard]]
+    const node_type & operator[](node_idx p_idx) const noexcept
+    {
+      return m_nodes[p_idx];
+    }
+
+    [[nodiscard]]
+    const nodes_type & nodes() const noexcept
+    {
+      return m_nodes;
+    }
+
+  private:
+    node_idx add_edge(node_idx p_node,
+                      uint8_t p_label)
+    {
+      auto & edges = m_nodes[p_node].edges;
+      auto edge = std::lower_bound(edges.begin(), edges.end(), p_label,
+                                   [](const auto & e, uint8_t label) {
+                                     return std::get<0>(e) < label;
+                                   });
+
+      if((edges.end() != edge) && (std::get<0>(*edge) == p_label))
+      {
+        return std::get<1>(*edge);
+      }
+
+      const auto child = static_cast<node_idx>(m_nodes.size());
+      edges.emplace(edge, p_label, child);
+      m_nodes.emplace_back();
+
+      return child;
+    }
+
+    nodes_type m_nodes;
+};
+
+} // namespace yafiyogi::yy_mqtt
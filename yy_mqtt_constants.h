@@ -41,6 +41,8 @@ inline constexpr std::string_view TopicMultiLevelWildcard{"#"};
 inline constexpr std::string_view::value_type TopicMultiLevelWildcardChar{TopicMultiLevelWildcard[0]};
 inline constexpr std::string_view TopicSys{"$"};
 inline constexpr std::string_view::value_type TopicSysChar{TopicSys[0]};
+// mqtt-v5.0-os 4.8.2 Shared Subscriptions
+inline constexpr std::string_view TopicSharePrefix{"$share/"};
 
 } // namespace yafiyogi::yy_mqtt
 
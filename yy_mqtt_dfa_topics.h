@@ -0,0 +1,747 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "yy_cpp/yy_span.h"
+#include "yy_cpp/yy_vector.h"
+
+#include "yy_mqtt_constants.h"
+#include "yy_mqtt_level_trie.h"
+#include "yy_mqtt_perfect_hash.h"
+#include "yy_mqtt_topic.h"
+#include "yy_mqtt_state_topics.h"
+
+namespace yafiyogi::yy_mqtt {
+namespace dfa_topics_detail {
+
+using state_idx = uint32_t;
+
+inline constexpr state_idx dead_state = 0;
+inline constexpr state_idx root_state = 1;
+inline constexpr state_idx sys_root_state = 2;
+
+// States with at least this many edges look labels up with a perfect
+// hash instead of a binary search.
+inline constexpr size_type default_hash_min_edges = 32;
+
+struct dfa_edge final
+{
+    uint32_t label_offset = 0;
+    uint32_t label_size = 0;
+    state_idx target = dead_state;
+};
+
+struct dfa_state final
+{
+    uint32_t edges_begin = 0;
+    uint32_t edges_end = 0;
+    state_idx other = dead_state; // Transition for any level without an edge ('+').
+    uint32_t accept_begin = 0;
+    uint32_t accept_end = 0;
+    // Payloads when the topic ends with a trailing separator after this state.
+    uint32_t trailing_begin = 0;
+    uint32_t trailing_end = 0;
+    // Perfect hash seeds. If empty the edges are sorted by label,
+    // otherwise edge i is the label whose slot is i.
+    uint32_t seeds_begin = 0;
+    uint32_t seeds_end = 0;
+};
+
+struct dfa_tables final
+{
+    yy_quad::simple_vector<dfa_state> states{};
+    yy_quad::simple_vector<dfa_edge> edges{};
+    yy_quad::simple_vector<uint32_t> accepts{};
+    yy_quad::simple_vector<uint32_t> seeds{};
+    std::string labels{};
+};
+
+// Subset construction over the level trie. Each DFA state is the
+// set of level trie nodes active after matching the same topic
+// levels, so a topic is matched with one transition per level.
+class dfa_builder final
+{
+  public:
+    using node_set = std::vector<uint32_t>;
+
+    dfa_builder(const level_trie & p_trie,
+                size_type p_max_states,
+                size_type p_hash_min_edges = default_hash_min_edges) noexcept:
+      m_trie(p_trie),
+      m_max_states(p_max_states),
+      m_hash_min_edges(p_hash_min_edges)
+    {
+    }
+
+    dfa_builder() = delete;
+    dfa_builder(const dfa_builder &) = delete;
+    dfa_builder(dfa_builder &&) = delete;
+    ~dfa_builder() = default;
+
+    dfa_builder & operator=(const dfa_builder &) = delete;
+    dfa_builder & operator=(dfa_builder &&) = delete;
+
+    // Returns false if the DFA would need more than p_max_states states.
+    [[nodiscard]]
+    bool build(dfa_tables & p_tables)
+    {
+      m_sets.clear();
+      m_pending.clear();
+      m_ids.clear();
+
+      std::ignore = intern(node_set{});
+      std::ignore = intern(node_set{static_cast<uint32_t>(level_trie::root_idx)});
+      m_sets.emplace_back();  // sys_root_state
+      m_raw.resize(m_sets.size());
+
+      build_sys_root();
+
+      while(!m_pending.empty())
+      {
+        if(m_sets.size() > m_max_states)
+        {
+          return false;
+        }
+
+        const state_idx state = m_pending.back();
+        m_pending.pop_back();
+        build_state(state);
+      }
+
+      if(m_sets.size() > m_max_states)
+      {
+        return false;
+      }
+
+      emit(p_tables);
+
+      return true;
+    }
+
+  private:
+    struct raw_edge final
+    {
+        std::string_view label{};
+        state_idx target = dead_state;
+    };
+
+    struct raw_state final
+    {
+        std::vector<raw_edge> edges{};
+        state_idx other = dead_state;
+        std::vector<uint32_t> accept{};
+        std::vector<uint32_t> trailing{};
+    };
+
+    state_idx intern(node_set && p_set)
+    {
+      if(auto found = m_ids.find(p_set);
+         m_ids.end() != found)
+      {
+        return found->second;
+      }
+
+      const auto state = static_cast<state_idx>(m_sets.size());
+      m_ids.emplace(p_set, state);
+      m_sets.emplace_back(std::move(p_set));
+      m_raw.resize(m_sets.size());
+      if(dead_state != state)
+      {
+        m_pending.emplace_back(state);
+      }
+
+      return state;
+    }
+
+    static void sort_unique(std::vector<uint32_t> & p_set)
+    {
+      std::sort(p_set.begin(), p_set.end());
+      p_set.erase(std::unique(p_set.begin(), p_set.end()), p_set.end());
+    }
+
+    void build_sys_root()
+    {
+      // mqtt-v5.0 4.7.2 Topics beginning with $
+      // Wildcards at the first level do not match topics beginning with '$'.
+      raw_state raw{};
+      for(const auto & edge : m_trie[level_trie::root_idx].literals)
+      {
+        if(!edge.label.empty()
+           && (mqtt_detail::TopicSysChar == edge.label[0]))
+        {
+          raw.edges.emplace_back(edge.label, intern(node_set{static_cast<uint32_t>(edge.node)}));
+        }
+      }
+
+      m_raw[sys_root_state] = std::move(raw);
+    }
+
+    void build_state(state_idx p_state)
+    {
+      // Copy, intern() may reallocate m_sets.
+      const node_set nodes{m_sets[p_state]};
+      raw_state raw{};
+
+      // Nodes reached by any level.
+      node_set wild{};
+      std::vector<std::tuple<std::string_view, uint32_t>> literals{};
+
+      for(const auto node_idx : nodes)
+      {
+        const auto & node = m_trie[node_idx];
+
+        if(level_trie::no_index != node.single_level)
+        {
+          wild.emplace_back(static_cast<uint32_t>(node.single_level));
+        }
+        if(level_trie::no_index != node.multi_level)
+        {
+          wild.emplace_back(static_cast<uint32_t>(node.multi_level));
+          // 'abc/#' matches 'abc'.
+          add_accept(node.multi_level, raw.accept);
+        }
+        if(node.is_multi_level)
+        {
+          wild.emplace_back(node_idx);
+        }
+
+        add_accept(node_idx, raw.accept);
+        if(node.is_single_level)
+        {
+          add_accept(node_idx, raw.trailing);
+        }
+
+        for(const auto & edge : node.literals)
+        {
+          literals.emplace_back(edge.label, static_cast<uint32_t>(edge.node));
+        }
+      }
+
+      sort_unique(wild);
+      sort_unique(raw.accept);
+      sort_unique(raw.trailing);
+      std::sort(literals.begin(), literals.end());
+
+      auto literal = literals.begin();
+      while(literals.end() != literal)
+      {
+        const auto label = std::get<0>(*literal);
+        node_set target{wild};
+
+        for(; (literals.end() != literal) && (std::get<0>(*literal) == label); ++literal)
+        {
+          target.emplace_back(std::get<1>(*literal));
+        }
+
+        sort_unique(target);
+        raw.edges.emplace_back(label, intern(std::move(target)));
+      }
+
+      raw.other = intern(std::move(wild));
+      m_raw[p_state] = std::move(raw);
+    }
+
+    void add_accept(size_type p_node,
+                    std::vector<uint32_t> & p_accept) const
+    {
+      if(const auto payload = m_trie[p_node].payload;
+         level_trie::no_index != payload)
+      {
+        p_accept.emplace_back(static_cast<uint32_t>(payload));
+      }
+    }
+
+    state_idx next(state_idx p_state,
+                   std::string_view p_label) const noexcept
+    {
+      const auto & edges = m_raw[p_state].edges;
+      for(const auto & edge : edges)
+      {
+        if(edge.label == p_label)
+        {
+          return edge.target;
+        }
+      }
+
+      return m_raw[p_state].other;
+    }
+
+    uint32_t add_label(std::string_view p_label,
+                       std::string & p_labels)
+    {
+      if(auto found = m_label_offsets.find(p_label);
+         m_label_offsets.end() != found)
+      {
+        return found->second;
+      }
+
+      const auto offset = static_cast<uint32_t>(p_labels.size());
+      p_labels.append(p_label);
+      m_label_offsets.emplace(p_label, offset);
+
+      return offset;
+    }
+
+    void emit(dfa_tables & p_tables)
+    {
+      p_tables.states.clear();
+      p_tables.edges.clear();
+      p_tables.accepts.clear();
+      p_tables.seeds.clear();
+      p_tables.labels.clear();
+      m_label_offsets.clear();
+
+      p_tables.states.reserve(m_raw.size());
+
+      for(size_type idx = 0; idx < m_raw.size(); ++idx)
+      {
+        const auto & raw = m_raw[idx];
+        dfa_state state{};
+
+        state.edges_begin = static_cast<uint32_t>(p_tables.edges.size());
+        for(const auto & edge : raw.edges)
+        {
+          p_tables.edges.emplace_back(add_label(edge.label, p_tables.labels),
+                                      static_cast<uint32_t>(edge.label.size()),
+                                      edge.target);
+        }
+        state.edges_end = static_cast<uint32_t>(p_tables.edges.size());
+        state.other = raw.other;
+
+        state.accept_begin = static_cast<uint32_t>(p_tables.accepts.size());
+        for(const auto payload : raw.accept)
+        {
+          p_tables.accepts.emplace_back(payload);
+        }
+        state.accept_end = static_cast<uint32_t>(p_tables.accepts.size());
+
+        // Topic 'abc/' matches 'abc/+' (the empty level) and 'abc/+' where
+        // the '+' matched 'abc'.
+        std::vector<uint32_t> trailing{m_raw[next(static_cast<state_idx>(idx), std::string_view{})].accept};
+        trailing.insert(trailing.end(), raw.trailing.begin(), raw.trailing.end());
+        sort_unique(trailing);
+
+        state.trailing_begin = static_cast<uint32_t>(p_tables.accepts.size());
+        for(const auto payload : trailing)
+        {
+          p_tables.accepts.emplace_back(payload);
+        }
+        state.trailing_end = static_cast<uint32_t>(p_tables.accepts.size());
+
+        p_tables.states.emplace_back(state);
+      }
+
+      // Label lookup in Query uses binary search, or a perfect hash
+      // for high fan-out states.
+      for(auto & state : p_tables.states)
+      {
+        std::sort(p_tables.edges.begin() + state.edges_begin,
+                  p_tables.edges.begin() + state.edges_end,
+                  [&p_tables](const dfa_edge & lhs, const dfa_edge & rhs) {
+                    return std::string_view{p_tables.labels.data() + lhs.label_offset, lhs.label_size}
+                    < std::string_view{p_tables.labels.data() + rhs.label_offset, rhs.label_size};
+                  });
+
+        if((state.edges_end - state.edges_begin) >= m_hash_min_edges)
+        {
+          hash_edges(state, p_tables);
+        }
+      }
+    }
+
+    // Reorders the edges of p_state by perfect hash slot. Leaves them
+    // sorted if no perfect hash is found.
+    void hash_edges(dfa_state & p_state,
+                    dfa_tables & p_tables)
+    {
+      const auto edges_begin = p_tables.edges.begin() + p_state.edges_begin;
+      const auto edge_count = p_state.edges_end - p_state.edges_begin;
+
+      m_hashes.clear();
+      for(uint32_t idx = 0; idx < edge_count; ++idx)
+      {
+        const auto & edge = edges_begin[idx];
+        m_hashes.emplace_back(topic_level_hash(std::string_view{p_tables.labels.data() + edge.label_offset, edge.label_size}));
+      }
+
+      if(!perfect_hash_build(yy_quad::make_const_span(m_hashes), m_seeds, m_slots))
+      {
+        return;
+      }
+
+      m_hashed.assign(edge_count, dfa_edge{});
+      for(uint32_t idx = 0; idx < edge_count; ++idx)
+      {
+        m_hashed[m_slots[idx]] = edges_begin[idx];
+      }
+      std::copy(m_hashed.begin(), m_hashed.end(), edges_begin);
+
+      p_state.seeds_begin = static_cast<uint32_t>(p_tables.seeds.size());
+      for(const auto seed : m_seeds)
+      {
+        p_tables.seeds.emplace_back(seed);
+      }
+      p_state.seeds_end = static_cast<uint32_t>(p_tables.seeds.size());
+    }
+
+    const level_trie & m_trie;
+    size_type m_max_states = 0;
+    size_type m_hash_min_edges = default_hash_min_edges;
+    std::vector<node_set> m_sets{};
+    std::vector<raw_state> m_raw{};
+    std::vector<state_idx> m_pending{};
+    std::map<node_set, state_idx> m_ids{};
+    std::map<std::string_view, uint32_t> m_label_offsets{};
+    std::vector<uint64_t> m_hashes{};
+    std::vector<uint32_t> m_seeds{};
+    std::vector<uint32_t> m_slots{};
+    std::vector<dfa_edge> m_hashed{};
+};
+
+template<typename ValueType>
+class Query final
+{
+  public:
+    using fallback_type = typename state_topics<ValueType>::automaton_type;
+    using value_type = ValueType;
+    using value_ptr = typename fallback_type::value_ptr;
+    using data_vector = yy_quad::simple_vector<value_type>;
+    using payloads_type = yy_quad::simple_vector<value_ptr>;
+    using payloads_span_type = typename fallback_type::payloads_span_type;
+
+    constexpr explicit Query(dfa_tables && p_tables,
+                             data_vector && p_data) noexcept:
+      m_states(std::move(p_tables.states)),
+      m_edges(std::move(p_tables.edges)),
+      m_accepts(std::move(p_tables.accepts)),
+      m_seeds(std::move(p_tables.seeds)),
+      m_labels(std::move(p_tables.labels)),
+      m_data(std::move(p_data))
+    {
+      m_payloads.reserve(3);
+    }
+
+    constexpr explicit Query(fallback_type && p_fallback) noexcept:
+      m_fallback(std::move(p_fallback)),
+      m_use_fallback(true)
+    {
+    }
+
+    constexpr Query() noexcept = default;
+    Query(const Query &) = delete;
+    constexpr Query(Query &&) noexcept = default;
+    constexpr ~Query() noexcept = default;
+
+    Query & operator=(const Query &) = delete;
+    constexpr Query & operator=(Query &&) noexcept = default;
+
+    [[nodiscard]]
+    constexpr payloads_span_type find(std::string_view p_topic) noexcept
+    {
+      if(m_use_fallback)
+      {
+        return m_fallback.find(p_topic);
+      }
+
+      m_payloads.clear(yy_quad::ClearAction::Keep);
+
+      if(!p_topic.empty() && !m_states.empty())
+      {
+        find_levels(p_topic);
+      }
+
+      return yy_quad::make_span(m_payloads);
+    }
+
+    // Walks the levels already split by the Topic.
+    [[nodiscard]]
+    constexpr payloads_span_type find(const Topic & p_topic) noexcept
+    {
+      if(m_use_fallback)
+      {
+        return m_fallback.find(p_topic);
+      }
+
+      m_payloads.clear(yy_quad::ClearAction::Keep);
+
+      if(!p_topic.empty() && !m_states.empty())
+      {
+        find_levels(p_topic);
+      }
+
+      return yy_quad::make_span(m_payloads);
+    }
+
+    // True if the filter set was too large to determinize and
+    // matching is done by state_topics instead.
+    [[nodiscard]]
+    constexpr bool fallback() const noexcept
+    {
+      return m_use_fallback;
+    }
+
+    [[nodiscard]]
+    constexpr size_type state_count() const noexcept
+    {
+      return m_states.size();
+    }
+
+  private:
+    [[nodiscard]]
+    constexpr std::string_view label(const dfa_edge & p_edge) const noexcept
+    {
+      return std::string_view{m_labels.data() + p_edge.label_offset, p_edge.label_size};
+    }
+
+    [[nodiscard]]
+    constexpr state_idx next(state_idx p_state,
+                             std::string_view p_level) const noexcept
+    {
+      const auto & state = m_states[p_state];
+      if(state.seeds_begin != state.seeds_end)
+      {
+        return hashed_next(state, p_level, topic_level_hash(p_level));
+      }
+
+      return sorted_next(state, p_level);
+    }
+
+    // As above, with the level hash already computed by Topic.
+    [[nodiscard]]
+    constexpr state_idx next(state_idx p_state,
+                             std::string_view p_level,
+                             uint64_t p_hash) const noexcept
+    {
+      const auto & state = m_states[p_state];
+      if(state.seeds_begin != state.seeds_end)
+      {
+        return hashed_next(state, p_level, p_hash);
+      }
+
+      return sorted_next(state, p_level);
+    }
+
+    [[nodiscard]]
+    constexpr state_idx hashed_next(const dfa_state & p_state,
+                                    std::string_view p_level,
+                                    uint64_t p_hash) const noexcept
+    {
+      const auto bucket_count = p_state.seeds_end - p_state.seeds_begin;
+      const auto edge_count = p_state.edges_end - p_state.edges_begin;
+      const auto seed = m_seeds[p_state.seeds_begin + perfect_hash_bucket(p_hash, bucket_count)];
+      const auto & edge = m_edges[p_state.edges_begin + perfect_hash_slot(p_hash, seed, edge_count)];
+
+      // Levels that are not labels also land on some edge.
+      return (label(edge) == p_level) ? edge.target : p_state.other;
+    }
+
+    [[nodiscard]]
+    constexpr state_idx sorted_next(const dfa_state & p_state,
+                                    std::string_view p_level) const noexcept
+    {
+      const auto begin = m_edges.begin() + p_state.edges_begin;
+      const auto end = m_edges.begin() + p_state.edges_end;
+
+      auto edge = std::lower_bound(begin, end, p_level,
+                                   [this](const dfa_edge & e, std::string_view level) {
+                                     return label(e) < level;
+                                   });
+
+      if((end != edge) && (label(*edge) == p_level))
+      {
+        return edge->target;
+      }
+
+      return p_state.other;
+    }
+
+    constexpr void add_payloads(uint32_t p_begin,
+                                uint32_t p_end) noexcept
+    {
+      for(uint32_t idx = p_begin; idx < p_end; ++idx)
+      {
+        m_payloads.emplace_back(&m_data[m_accepts[idx]]);
+      }
+    }
+
+    constexpr void find_levels(std::string_view p_topic) noexcept
+    {
+      state_idx state = (mqtt_detail::TopicSysChar == p_topic[0]) ? sys_root_state : root_state;
+
+      while(dead_state != state)
+      {
+        const auto pos = p_topic.find(mqtt_detail::TopicLevelSeparatorChar);
+
+        if(std::string_view::npos == pos)
+        {
+          // Last level.
+          state = next(state, p_topic);
+          add_payloads(m_states[state].accept_begin, m_states[state].accept_end);
+          break;
+        }
+
+        state = next(state, p_topic.substr(0, pos));
+        p_topic.remove_prefix(pos + 1);
+
+        if(p_topic.empty())
+        {
+          // Topic is 'abc/cde/'.
+          add_payloads(m_states[state].trailing_begin, m_states[state].trailing_end);
+          break;
+        }
+      }
+    }
+
+    constexpr void find_levels(const Topic & p_topic) noexcept
+    {
+      state_idx state = p_topic.is_sys() ? sys_root_state : root_state;
+      const auto & levels = p_topic.levels();
+      const size_type max = levels.size();
+
+      for(size_type idx = 0; (idx < max) && (dead_state != state); ++idx)
+      {
+        if(((idx + 1) == max) && (idx > 0) && levels[idx].empty())
+        {
+          // Topic is 'abc/cde/'.
+          add_payloads(m_states[state].trailing_begin, m_states[state].trailing_end);
+          break;
+        }
+
+        state = next(state, levels[idx], p_topic.level_hash(idx));
+
+        if((idx + 1) == max)
+        {
+          add_payloads(m_states[state].accept_begin, m_states[state].accept_end);
+        }
+      }
+    }
+
+    yy_quad::simple_vector<dfa_state> m_states{};
+    yy_quad::simple_vector<dfa_edge> m_edges{};
+    yy_quad::simple_vector<uint32_t> m_accepts{};
+    yy_quad::simple_vector<uint32_t> m_seeds{};
+    std::string m_labels{};
+    data_vector m_data{};
+    payloads_type m_payloads{};
+    fallback_type m_fallback{};
+    bool m_use_fallback = false;
+};
+
+} // namespace dfa_topics_detail
+
+// Filter set compiled into a DFA over topic levels. Intended for
+// mostly static filter sets: add() is cheap, create_automaton()
+// determinizes the whole set. If the DFA needs more than
+// max_states states the automaton falls back to state_topics. States
+// with hash_min_edges or more edges are looked up by perfect hash.
+template<typename ValueType>
+class dfa_topics final
+{
+  public:
+    using value_type = ValueType;
+    using automaton_type = dfa_topics_detail::Query<value_type>;
+    using data_vector = typename automaton_type::data_vector;
+    static constexpr size_type default_max_states = size_type{1} << 16;
+
+    static constexpr size_type default_hash_min_edges = dfa_topics_detail::default_hash_min_edges;
+
+    constexpr explicit dfa_topics(size_type p_max_states = default_max_states,
+                                  size_type p_hash_min_edges = default_hash_min_edges) noexcept:
+      m_max_states(p_max_states),
+      m_hash_min_edges(p_hash_min_edges)
+    {
+    }
+
+    dfa_topics(const dfa_topics &) = default;
+    dfa_topics(dfa_topics &&) noexcept = default;
+    ~dfa_topics() = default;
+
+    dfa_topics & operator=(const dfa_topics &) = default;
+    dfa_topics & operator=(dfa_topics &&) noexcept = default;
+
+    void add(std::string_view p_filter,
+             value_type p_value)
+    {
+      auto & node = m_trie[m_trie.add(p_filter)];
+
+      if(level_trie::no_index == node.payload)
+      {
+        node.payload = m_values.size();
+        m_filters.emplace_back(p_filter);
+        m_values.emplace_back(std::move(p_value));
+      }
+      else
+      {
+        m_values[node.payload] = std::move(p_value);
+      }
+    }
+
+    [[nodiscard]]
+    automaton_type create_automaton() const
+    {
+      dfa_topics_detail::dfa_tables tables{};
+      dfa_topics_detail::dfa_builder builder{m_trie, m_max_states, m_hash_min_edges};
+
+      if(!builder.build(tables))
+      {
+        state_topics<value_type> fallback{};
+
+        for(size_type idx = 0; idx < m_filters.size(); ++idx)
+        {
+          fallback.add(m_filters[idx], m_values[idx]);
+        }
+
+        return automaton_type{fallback.create_automaton()};
+      }
+
+      data_vector data{};
+      data.reserve(m_values.size());
+      for(const auto & value : m_values)
+      {
+        data.emplace_back(value);
+      }
+
+      return automaton_type{std::move(tables), std::move(data)};
+    }
+
+  private:
+    size_type m_max_states = default_max_states;
+    size_type m_hash_min_edges = default_hash_min_edges;
+    level_trie m_trie{};
+    std::vector<std::string> m_filters{};
+    std::vector<value_type> m_values{};
+};
+
+} // namespace yafiyogi::yy_mqtt
@@ -36,6 +36,7 @@
 #include "yy_cpp/yy_vector.h"
 
 #include "yy_mqtt_constants.h"
+#include "yy_mqtt_topic.h"
 
 namespace yafiyogi::yy_mqtt {
 namespace fast_topics_detail {
@@ -97,6 +98,12 @@ class Query final
       return yy_quad::make_span(m_payloads);
     }
 
+    [[nodiscard]]
+    constexpr payloads_span_type find(const Topic & p_topic) noexcept
+    {
+      return find(p_topic.view());
+    }
+
   private:
     static constexpr void add_sub_state(const label_type p_label,
                                         topic_type p_topic,
@@ -28,6 +28,7 @@
 
 #include <cstdint>
 
+#include <algorithm>
 #include <string>
 #include <string_view>
 
@@ -39,6 +40,8 @@
 #include "yy_cpp/yy_vector.h"
 
 #include "yy_mqtt_constants.h"
+#include "yy_mqtt_topic.h"
+#include "yy_mqtt_types.h"
 
 namespace yafiyogi::yy_mqtt {
 namespace faster_topics_detail {
@@ -76,6 +79,7 @@ class Query final
     {
       m_search_states.reserve(8);
       m_payloads.reserve(3);
+      m_visited.resize(m_nodes.size() * search_type_count, 0);
     }
 
     constexpr Query() noexcept = default;
@@ -91,27 +95,97 @@ class Query final
     {
       m_search_states.clear(yy_quad::ClearAction::Keep);
       m_payloads.clear(yy_quad::ClearAction::Keep);
+      m_status = TopicSearchStatus::Ok;
 
       if(!topic.empty())
       {
-        find_span(yy_quad::make_const_span(topic));
+        if((0 != m_limits.max_levels)
+           && (static_cast<size_type>(std::count(topic.begin(), topic.end(), mqtt_detail::TopicLevelSeparatorChar)) >= m_limits.max_levels))
+        {
+          m_status = TopicSearchStatus::LevelLimit;
+        }
+        else
+        {
+          next_generation();
+          find_span(yy_quad::make_const_span(topic));
+        }
       }
 
       return yy_quad::make_span(m_payloads);
     }
 
+    [[nodiscard]]
+    constexpr payloads_span_type find(const Topic & p_topic) noexcept
+    {
+      return find(p_topic.view());
+    }
+
+    constexpr void limits(const TopicSearchLimits & p_limits) noexcept
+    {
+      m_limits = p_limits;
+    }
+
+    [[nodiscard]]
+    constexpr const TopicSearchLimits & limits() const noexcept
+    {
+      return m_limits;
+    }
+
+    // Status of the last find(). If a limit was hit no payloads are returned.
+    [[nodiscard]]
+    constexpr TopicSearchStatus status() const noexcept
+    {
+      return m_status;
+    }
+
   private:
-    static constexpr void add_sub_state(const topic_type p_label,
-                                        topic_type p_topic,
-                                        search_type p_type,
-                                        node_ptr p_state,
-                                        queue & p_states_list)
+    static constexpr size_type search_type_count = 3;
+
+    constexpr void next_generation() noexcept
+    {
+      ++m_generation;
+      if(0 == m_generation)
+      {
+        std::fill(m_visited.begin(), m_visited.end(), 0);
+        m_generation = 1;
+      }
+    }
+
+    // A node is only reached at one topic level, so a (node, search type)
+    // pair seen before in this lookup is a duplicate.
+    constexpr void add_state(topic_type p_topic,
+                             node_ptr p_state,
+                             search_type p_type) noexcept
+    {
+      const auto idx = static_cast<size_type>(p_state - nodes_root()) * search_type_count
+                       + static_cast<size_type>(p_type);
+
+      if(m_generation != m_visited[idx])
+      {
+        // The cap is on the queue, so it bounds memory and not only
+        // the states processed.
+        if((0 != m_limits.max_states)
+           && (m_search_states.size() >= m_limits.max_states))
+        {
+          m_status = TopicSearchStatus::StateLimit;
+          return;
+        }
+
+        m_visited[idx] = m_generation;
+        m_search_states.emplace_back(p_topic, p_state, p_type);
+      }
+    }
+
+    constexpr void add_sub_state(const topic_type p_label,
+                                 topic_type p_topic,
+                                 search_type p_type,
+                                 node_ptr p_state) noexcept
     {
       YY_ASSERT(p_state);
 
-      auto sub_state_do = [p_label, p_topic, p_type, &p_states_list]
+      auto sub_state_do = [this, p_topic, p_type]
                           (auto edge_node, size_type /* pos */) {
-        p_states_list.emplace_back(p_topic, *edge_node, p_type);
+        add_state(p_topic, *edge_node, p_type);
       };
 
       std::ignore = p_state->find_edge(sub_state_do, p_label);
@@ -120,14 +194,13 @@ class Query final
     static constexpr auto single_level_wildcard{yy_quad::make_const_span(mqtt_detail::TopicSingleLevelWildcard)};
     static constexpr auto multi_level_wildcard{yy_quad::make_const_span(mqtt_detail::TopicMultiLevelWildcard)};
 
-    static constexpr void add_wildcards(node_ptr p_node,
-                                        topic_type p_topic,
-                                        queue & p_states_list) noexcept
+    constexpr void add_wildcards(node_ptr p_node,
+                                 topic_type p_topic) noexcept
     {
       YY_ASSERT(p_node);
 
-      add_sub_state(single_level_wildcard, p_topic, search_type::SingleLevelWild, p_node, p_states_list);
-      add_sub_state(multi_level_wildcard, p_topic, search_type::MultiLevelWild, p_node, p_states_list);
+      add_sub_state(single_level_wildcard, p_topic, search_type::SingleLevelWild, p_node);
+      add_sub_state(multi_level_wildcard, p_topic, search_type::MultiLevelWild, p_node);
     }
 
     static constexpr bool add_payload(node_ptr p_node,
@@ -152,17 +225,18 @@ class Query final
 
     constexpr void find_span(topic_type p_topic) noexcept
     {
-      m_search_states.emplace_back(p_topic, nodes_root(), search_type::Literal);
+      add_state(p_topic, nodes_root(), search_type::Literal);
       if(mqtt_detail::TopicSysChar != p_topic[0])
       {
-        add_sub_state(single_level_wildcard, p_topic, search_type::SingleLevelWild, nodes_root(), m_search_states);
-        add_sub_state(multi_level_wildcard, p_topic, search_type::MultiLevelWild, nodes_root(), m_search_states);
+        add_wildcards(nodes_root(), p_topic);
       }
 
-      while(!m_search_states.empty())
+      // Queue head is an index, popping from the front is O(n).
+      for(size_type head = 0;
+          (head < m_search_states.size()) && (TopicSearchStatus::Ok == m_status);
+          ++head)
       {
-        auto [search_topic, state, type] = m_search_states.front();
-        m_search_states.erase(m_search_states.begin(), yy_quad::ClearAction::Keep);
+        auto [search_topic, state, type] = m_search_states[head];
 
         switch(type)
         {
@@ -190,10 +264,10 @@ class Query final
                 // mqtt-v5.0 4.7.1.3 Single-level wildcard
                 // 2979: "sport/+” does not match “sport” but it does match “sport/”.
                 // Topic is 'abc/cde/', try to match 'abc/cde/+'
-                add_sub_state(single_level_wildcard, rest_topic, search_type::SingleLevelWild, state, m_search_states);
+                add_sub_state(single_level_wildcard, rest_topic, search_type::SingleLevelWild, state);
               }
               // Topic is 'abc/cde' or 'abc/cde/', so try to match 'abc/cde/#'
-              add_sub_state(multi_level_wildcard, rest_topic, search_type::MultiLevelWild, state, m_search_states);
+              add_sub_state(multi_level_wildcard, rest_topic, search_type::MultiLevelWild, state);
             }
 
             if(found)
@@ -218,7 +292,7 @@ class Query final
             else
             {
               // Try to match 'abc/+/cde
-              m_search_states.emplace_back(topic, state, search_type::Literal);
+              add_state(topic, state, search_type::Literal);
             }
 
             auto rest_topic{topic_tokens.source()};
@@ -227,10 +301,10 @@ class Query final
               // mqtt-v5.0 4.7.1.3 Single-level wildcard
               // 2979: "sport/+” does not match “sport” but it does match “sport/”.
               // Topic is 'abc/cde/', try to match 'abc/cde/+'
-              add_sub_state(single_level_wildcard, rest_topic, search_type::SingleLevelWild, state, m_search_states);
+              add_sub_state(single_level_wildcard, rest_topic, search_type::SingleLevelWild, state);
             }
             // Topic is 'abc/cde' or 'abc/cde/', so try to match 'abc/cde/#'
-            add_sub_state(multi_level_wildcard, rest_topic, search_type::MultiLevelWild, state, m_search_states);
+            add_sub_state(multi_level_wildcard, rest_topic, search_type::MultiLevelWild, state);
             break;
           }
 
@@ -239,12 +313,21 @@ class Query final
             break;
         }
       }
+
+      if(TopicSearchStatus::StateLimit == m_status)
+      {
+        m_payloads.clear(yy_quad::ClearAction::Keep);
+      }
     }
 
     trie_vector m_nodes{};
     data_vector m_data{};
     queue m_search_states{};
     payloads_type m_payloads{};
+    yy_quad::simple_vector<uint32_t> m_visited{};
+    uint32_t m_generation = 0;
+    TopicSearchLimits m_limits{};
+    TopicSearchStatus m_status = TopicSearchStatus::Ok;
 };
 
 template<typename LabelType>
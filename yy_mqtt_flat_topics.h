@@ -33,6 +33,7 @@
 #include "yy_cpp/yy_vector.h"
 
 #include "yy_mqtt_constants.h"
+#include "yy_mqtt_topic.h"
 
 namespace yafiyogi::yy_mqtt {
 namespace flat_topics_detail {
@@ -99,6 +100,12 @@ class Query final
       return yy_quad::make_span(m_payloads);
     }
 
+    [[nodiscard]]
+    constexpr payloads_span_type find(const Topic & p_topic) noexcept
+    {
+      return find(p_topic.view());
+    }
+
   private:
     constexpr void add_wildcards(node_ptr const p_node,
                                  queue & p_states_list) noexcept
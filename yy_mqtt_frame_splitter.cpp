@@ -0,0 +1,151 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <cstdint>
+#include <cstring>
+
+#include <algorithm>
+#include <bit>
+#include <string_view>
+
+#include "yy_mqtt_frame_splitter.h"
+#include "yy_mqtt_packet.h"
+
+namespace yafiyogi::yy_mqtt {
+
+frame_splitter::frame_splitter(size_type p_capacity):
+  m_buffer(std::bit_ceil(std::max(p_capacity, size_type{16}))),
+  m_mask(m_buffer.size() - 1)
+{
+}
+
+frame_splitter::write_span_type frame_splitter::prepare() noexcept
+{
+  // The packet last returned by next() keeps its space until next()
+  // is called again, so its view stays valid while reading more.
+  const auto free = capacity() - size();
+  const auto start = offset(m_write);
+  const auto contiguous = std::min(free, capacity() - start);
+
+  return yy_quad::make_span(m_buffer.data() + start, contiguous);
+}
+
+void frame_splitter::commit(size_type p_size) noexcept
+{
+  m_write += std::min(p_size, capacity() - size());
+}
+
+size_type frame_splitter::write(std::string_view p_bytes) noexcept
+{
+  size_type written = 0;
+
+  // At most two copies, either side of the end of the ring.
+  while(written < p_bytes.size())
+  {
+    auto space = prepare();
+    if(space.empty())
+    {
+      break;
+    }
+
+    const auto count = std::min(space.size(), p_bytes.size() - written);
+    std::memcpy(space.data(), p_bytes.data() + written, count);
+    commit(count);
+    written += count;
+  }
+
+  return written;
+}
+
+void frame_splitter::release() noexcept
+{
+  m_read += m_pending;
+  m_pending = 0;
+}
+
+FrameStatus frame_splitter::next(std::string_view & p_packet)
+{
+  release();
+
+  const auto buffered = size();
+  if(buffered < 2)
+  {
+    return FrameStatus::NeedMore;
+  }
+
+  // The Remaining Length starts after the first byte, and may wrap.
+  uint8_t length_bytes[4] = {0, 0, 0, 0};
+  const auto available = std::min(buffered - 1, size_type{4});
+  for(size_type idx = 0; idx < available; ++idx)
+  {
+    length_bytes[idx] = static_cast<uint8_t>(m_buffer[offset(m_read + 1 + idx)]);
+  }
+
+  uint32_t remaining_length = 0;
+  size_type length_size = 0;
+  switch(decode_variable_byte_integer(length_bytes, available, remaining_length, length_size))
+  {
+    case DecodeStatus::Ok:
+      break;
+
+    case DecodeStatus::Incomplete:
+      return FrameStatus::NeedMore;
+
+    default:
+      return FrameStatus::Malformed;
+  }
+
+  const size_type packet_size = 1 + length_size + remaining_length;
+  if(packet_size > capacity())
+  {
+    return FrameStatus::TooLarge;
+  }
+
+  if(packet_size > buffered)
+  {
+    return FrameStatus::NeedMore;
+  }
+
+  const auto start = offset(m_read);
+  if((start + packet_size) <= capacity())
+  {
+    p_packet = std::string_view{m_buffer.data() + start, packet_size};
+  }
+  else
+  {
+    const auto first = capacity() - start;
+    m_straddle.assign(m_buffer.data() + start, first);
+    m_straddle.append(m_buffer.data(), packet_size - first);
+    p_packet = m_straddle;
+    ++m_straddled;
+  }
+
+  m_pending = packet_size;
+
+  return FrameStatus::Ok;
+}
+
+} // namespace yafiyogi::yy_mqtt
@@ -0,0 +1,128 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "yy_cpp/yy_span.h"
+
+#include "yy_mqtt_packet.h"
+#include "yy_mqtt_types.h"
+
+namespace yafiyogi::yy_mqtt {
+
+enum class FrameStatus:uint8_t {
+  Ok,
+  NeedMore,     // No complete packet buffered.
+  Malformed,    // Remaining Length longer than four bytes.
+  TooLarge      // Packet does not fit in the ring buffer.
+};
+
+// Splits a byte stream into MQTT control packets across arbitrary
+// read boundaries. Bytes are read straight into a ring buffer and
+// complete packets are returned as views into it. Only a packet that
+// straddles the end of the ring is copied, into a reused buffer.
+//
+//   auto space = splitter.prepare();
+//   splitter.commit(::read(fd, space.data(), space.size()));
+//   std::string_view packet;
+//   while(FrameStatus::Ok == splitter.next(packet)) { ... }
+class frame_splitter final
+{
+  public:
+    using write_span_type = yy_quad::span<char>;
+
+    // p_capacity is rounded up to a power of two.
+    explicit frame_splitter(size_type p_capacity);
+
+    frame_splitter() = delete;
+    frame_splitter(const frame_splitter &) = delete;
+    frame_splitter(frame_splitter &&) noexcept = default;
+    ~frame_splitter() = default;
+
+    frame_splitter & operator=(const frame_splitter &) = delete;
+    frame_splitter & operator=(frame_splitter &&) noexcept = default;
+
+    // Contiguous free space to read into, up to the end of the ring.
+    // Empty if the ring is full.
+    [[nodiscard]]
+    write_span_type prepare() noexcept;
+
+    // Mark p_size bytes written into the space from prepare().
+    void commit(size_type p_size) noexcept;
+
+    // Copy p_bytes into the ring. Returns the number copied, less
+    // than p_bytes.size() if the ring fills.
+    size_type write(std::string_view p_bytes) noexcept;
+
+    // The next complete packet, fixed header included. The view is
+    // valid until the next call to next(), which releases its space.
+    FrameStatus next(std::string_view & p_packet);
+
+    [[nodiscard]]
+    size_type capacity() const noexcept
+    {
+      return m_buffer.size();
+    }
+
+    // Bytes buffered and not yet returned by next().
+    [[nodiscard]]
+    size_type size() const noexcept
+    {
+      return static_cast<size_type>(m_write - m_read);
+    }
+
+    // Packets copied because they straddled the end of the ring.
+    [[nodiscard]]
+    size_type straddled() const noexcept
+    {
+      return m_straddled;
+    }
+
+  private:
+    [[nodiscard]]
+    size_type offset(uint64_t p_pos) const noexcept
+    {
+      return static_cast<size_type>(p_pos) & m_mask;
+    }
+
+    void release() noexcept;
+
+    std::vector<char> m_buffer;
+    size_type m_mask = 0;
+    uint64_t m_read = 0;      // Free running, masked on access.
+    uint64_t m_write = 0;
+    size_type m_pending = 0;  // Size of the packet last returned.
+    std::string m_straddle{};
+    size_type m_straddled = 0;
+};
+
+} // namespace yafiyogi::yy_mqtt
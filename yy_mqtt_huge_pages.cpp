@@ -0,0 +1,166 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <utility>
+
+#include "yy_mqtt_huge_pages.h"
+
+namespace yafiyogi::yy_mqtt {
+namespace {
+
+constexpr size_type round_up(size_type p_size,
+                             size_type p_page) noexcept
+{
+  return ((p_size + p_page - 1) / p_page) * p_page;
+}
+
+void * map_anonymous(size_type p_size,
+                     int p_flags) noexcept
+{
+  void * data = ::mmap(nullptr, p_size, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | p_flags, -1, 0);
+
+  return (MAP_FAILED == data) ? nullptr : data;
+}
+
+// Transparent huge pages are only used for 2 MB aligned ranges, so
+// over map by one huge page and trim the ends.
+void * map_huge_aligned(size_type p_size) noexcept
+{
+  auto * mapped = static_cast<char *>(map_anonymous(p_size + huge_page_size, 0));
+  if(nullptr == mapped)
+  {
+    return nullptr;
+  }
+
+  const auto addr = reinterpret_cast<std::uintptr_t>(mapped);
+  auto * aligned = mapped + (round_up(addr, huge_page_size) - addr);
+  const auto head = static_cast<size_type>(aligned - mapped);
+  const auto tail = huge_page_size - head;
+
+  if(0 != head)
+  {
+    ::munmap(mapped, head);
+  }
+  if(0 != tail)
+  {
+    ::munmap(aligned + p_size, tail);
+  }
+
+  return aligned;
+}
+
+} // namespace
+
+huge_page_region::huge_page_region(size_type p_size,
+                                   HugePages p_pages) noexcept
+{
+  if(0 == p_size)
+  {
+    return;
+  }
+
+#if defined(MAP_HUGETLB)
+  if(HugePages::HugeTlb == p_pages)
+  {
+    const auto size = round_up(p_size, huge_page_size);
+    if(m_data = map_anonymous(size, MAP_HUGETLB);
+       nullptr != m_data)
+    {
+      m_size = size;
+      m_backing = HugePages::HugeTlb;
+      return;
+    }
+  }
+#endif
+
+#if defined(MADV_HUGEPAGE)
+  if(HugePages::Off != p_pages)
+  {
+    const auto size = round_up(p_size, huge_page_size);
+    if(m_data = map_huge_aligned(size);
+       nullptr != m_data)
+    {
+      m_size = size;
+      m_backing = (0 == ::madvise(m_data, size, MADV_HUGEPAGE)) ? HugePages::Advise : HugePages::Off;
+      return;
+    }
+  }
+#endif
+
+  const auto size = round_up(p_size, static_cast<size_type>(::sysconf(_SC_PAGESIZE)));
+  if(m_data = map_anonymous(size, 0);
+     nullptr != m_data)
+  {
+    m_size = size;
+#if defined(MADV_NOHUGEPAGE)
+    // With transparent huge pages set to 'always' the kernel may
+    // still back this with huge pages, which Off asks it not to.
+    ::madvise(m_data, size, MADV_NOHUGEPAGE);
+#endif
+  }
+}
+
+huge_page_region::huge_page_region(huge_page_region && p_other) noexcept:
+  m_data(std::exchange(p_other.m_data, nullptr)),
+  m_size(std::exchange(p_other.m_size, 0)),
+  m_backing(std::exchange(p_other.m_backing, HugePages::Off))
+{
+}
+
+huge_page_region::~huge_page_region() noexcept
+{
+  release();
+}
+
+huge_page_region & huge_page_region::operator=(huge_page_region && p_other) noexcept
+{
+  if(this != &p_other)
+  {
+    release();
+    m_data = std::exchange(p_other.m_data, nullptr);
+    m_size = std::exchange(p_other.m_size, 0);
+    m_backing = std::exchange(p_other.m_backing, HugePages::Off);
+  }
+
+  return *this;
+}
+
+void huge_page_region::release() noexcept
+{
+  if(nullptr != m_data)
+  {
+    ::munmap(m_data, m_size);
+    m_data = nullptr;
+    m_size = 0;
+  }
+}
+
+} // namespace yafiyogi::yy_mqtt
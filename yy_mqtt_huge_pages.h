@@ -0,0 +1,96 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include "yy_mqtt_types.h"
+
+namespace yafiyogi::yy_mqtt {
+
+// How a huge_page_region is backed.
+//   Off     - normal pages, transparent huge pages refused.
+//   Advise  - transparent huge pages requested with madvise().
+//   HugeTlb - pages from the reserved hugetlbfs pool (MAP_HUGETLB).
+enum class HugePages:uint8_t {Off, Advise, HugeTlb};
+
+inline constexpr size_type huge_page_size = size_type{2} * 1024 * 1024;
+
+// Anonymous mapping for read mostly tables. Huge pages are a request,
+// not a guarantee: HugeTlb falls back to Advise when the pool is
+// empty, and Advise falls back to Off when the kernel has no
+// transparent huge pages. backing() reports what was obtained. Huge
+// page regions are rounded up to whole 2 MB pages, so only large
+// tables should ask for them.
+class huge_page_region final
+{
+  public:
+    huge_page_region(size_type p_size,
+                     HugePages p_pages) noexcept;
+
+    constexpr huge_page_region() noexcept = default;
+    huge_page_region(const huge_page_region &) = delete;
+    huge_page_region(huge_page_region && p_other) noexcept;
+    ~huge_page_region() noexcept;
+
+    huge_page_region & operator=(const huge_page_region &) = delete;
+    huge_page_region & operator=(huge_page_region && p_other) noexcept;
+
+    [[nodiscard]]
+    constexpr void * data() const noexcept
+    {
+      return m_data;
+    }
+
+    // Bytes mapped, at least the size asked for.
+    [[nodiscard]]
+    constexpr size_type size() const noexcept
+    {
+      return m_size;
+    }
+
+    [[nodiscard]]
+    constexpr bool empty() const noexcept
+    {
+      return nullptr == m_data;
+    }
+
+    [[nodiscard]]
+    constexpr HugePages backing() const noexcept
+    {
+      return m_backing;
+    }
+
+  private:
+    void release() noexcept;
+
+    void * m_data = nullptr;
+    size_type m_size = 0;
+    HugePages m_backing = HugePages::Off;
+};
+
+} // namespace yafiyogi::yy_mqtt
@@ -0,0 +1,205 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "yy_cpp/yy_vector.h"
+
+#include "yy_mqtt_constants.h"
+#include "yy_mqtt_types.h"
+#include "yy_mqtt_util.h"
+
+namespace yafiyogi::yy_mqtt {
+namespace level_trie_detail {
+
+inline constexpr size_type no_index = std::numeric_limits<size_type>::max();
+
+struct level_edge final
+{
+    std::string label{};
+    size_type node = no_index;
+};
+
+struct level_node final
+{
+    std::vector<level_edge> literals{}; // Sorted by label.
+    size_type single_level = no_index;  // '+' child.
+    size_type multi_level = no_index;   // '#' child.
+    size_type payload = no_index;
+    size_type depth = 0;
+    bool is_single_level = false;
+    bool is_multi_level = false;
+};
+
+} // namespace level_trie_detail
+
+// Filter trie with one edge per topic level. Used as the
+// build-time NFA for the level based engines.
+class level_trie final
+{
+  public:
+    using node_type = level_trie_detail::level_node;
+    using edge_type = level_trie_detail::level_edge;
+    using nodes_type = std::vector<node_type>;
+    static constexpr size_type no_index = level_trie_detail::no_index;
+    static constexpr size_type root_idx = 0;
+
+    level_trie():
+      m_nodes(1)
+    {
+    }
+
+    level_trie(const level_trie &) = default;
+    level_trie(level_trie &&) noexcept = default;
+    ~level_trie() = default;
+
+    level_trie & operator=(const level_trie &) = default;
+    level_trie & operator=(level_trie &&) noexcept = default;
+
+    // Returns the node matching the last level of p_filter.
+    size_type add(std::string_view p_filter)
+    {
+      size_type node_idx = root_idx;
+
+      topic_tokenize_view(m_levels, p_filter);
+      for(const auto level : m_levels)
+      {
+        node_idx = add_level(node_idx, level);
+      }
+
+      return node_idx;
+    }
+
+    [[nodiscard]]
+    size_type find_literal(size_type p_node,
+                           std::string_view p_label) const noexcept
+    {
+      const auto & literals = m_nodes[p_node].literals;
+      auto edge = std::lower_bound(literals.begin(), literals.end(), p_label,
+                                   [](const edge_type & e, std::string_view label) {
+                                     return e.label < label;
+                                   });
+
+      if((literals.end() != edge) && (edge->label == p_label))
+      {
+        return edge->node;
+      }
+
+      return no_index;
+    }
+
+    [[nodiscard]]
+    constexpr node_type & operator[](size_type p_idx) noexcept
+    {
+      return m_nodes[p_idx];
+    }
+
+    [[nodiscard]]
+    constexpr const node_type & operator[](size_type p_idx) const noexcept
+    {
+      return m_nodes[p_idx];
+    }
+
+    [[nodiscard]]
+    constexpr size_type size() const noexcept
+    {
+      return m_nodes.size();
+    }
+
+    [[nodiscard]]
+    constexpr const nodes_type & nodes() const noexcept
+    {
+      return m_nodes;
+    }
+
+  private:
+    size_type new_node(size_type p_parent)
+    {
+      const size_type idx = m_nodes.size();
+      auto & node = m_nodes.emplace_back();
+      node.depth = m_nodes[p_parent].depth + 1;
+
+      return idx;
+    }
+
+    size_type add_level(size_type p_node,
+                        std::string_view p_level)
+    {
+      if(mqtt_detail::TopicSingleLevelWildcard == p_level)
+      {
+        if(no_index == m_nodes[p_node].single_level)
+        {
+          const size_type idx = new_node(p_node);
+          m_nodes[idx].is_single_level = true;
+          m_nodes[p_node].single_level = idx;
+        }
+        return m_nodes[p_node].single_level;
+      }
+
+      if(mqtt_detail::TopicMultiLevelWildcard == p_level)
+      {
+        if(no_index == m_nodes[p_node].multi_level)
+        {
+          const size_type idx = new_node(p_node);
+          m_nodes[idx].is_multi_level = true;
+          m_nodes[p_node].multi_level = idx;
+        }
+        return m_nodes[p_node].multi_level;
+      }
+
+      auto & literals = m_nodes[p_node].literals;
+      auto edge = std::lower_bound(literals.begin(), literals.end(), p_level,
+                                   [](const edge_type & e, std::string_view label) {
+                                     return e.label < label;
+                                   });
+
+      if((literals.end() != edge) && (edge->label == p_level))
+      {
+        return edge->node;
+      }
+
+      const auto pos = edge - literals.begin();
+      const size_type idx = new_node(p_node);
+      // new_node() may reallocate m_nodes, so re-fetch the edge list.
+      auto & node_literals = m_nodes[p_node].literals;
+      node_literals.emplace(node_literals.begin() + pos, edge_type{std::string{p_level}, idx});
+
+      return idx;
+    }
+
+    nodes_type m_nodes;
+    TopicLevelsView m_levels{};
+};
+
+} // namespace yafiyogi::yy_mqtt
@@ -0,0 +1,789 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include <algorithm>
+#include <bit>
+#include <istream>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include "yy_cpp/yy_span.h"
+#include "yy_cpp/yy_vector.h"
+
+#include "yy_mqtt_constants.h"
+#include "yy_mqtt_topic.h"
+#include "yy_mqtt_types.h"
+#include "yy_mqtt_util.h"
+
+namespace yafiyogi::yy_mqtt {
+namespace louds_topics_detail {
+
+using node_idx = uint32_t;
+
+inline constexpr node_idx root_node = 0;
+inline constexpr node_idx no_node = std::numeric_limits<node_idx>::max();
+
+// Bits with rank and select0 over 512 bit blocks. The rank samples
+// add 1/8 to the size of the bits.
+class bit_vector final
+{
+  public:
+    static constexpr size_type word_bits = 64;
+    static constexpr size_type block_words = 8;
+    static constexpr size_type block_bits = word_bits * block_words;
+
+    void push_back(bool p_bit)
+    {
+      if(0 == (m_size % word_bits))
+      {
+        m_words.emplace_back(0);
+      }
+
+      if(p_bit)
+      {
+        m_words[m_size / word_bits] |= uint64_t{1} << (m_size % word_bits);
+      }
+      ++m_size;
+    }
+
+    [[nodiscard]]
+    bool operator[](size_type p_pos) const noexcept
+    {
+      return 0 != ((m_words[p_pos / word_bits] >> (p_pos % word_bits)) & 1);
+    }
+
+    [[nodiscard]]
+    size_type size() const noexcept
+    {
+      return m_size;
+    }
+
+    // Needed before rank1() or select0().
+    void build_index()
+    {
+      m_ranks.clear();
+
+      uint64_t ones = 0;
+      for(size_type word = 0; word < m_words.size(); ++word)
+      {
+        if(0 == (word % block_words))
+        {
+          m_ranks.emplace_back(ones);
+        }
+        ones += static_cast<uint64_t>(std::popcount(m_words[word]));
+      }
+      m_ranks.emplace_back(ones);
+    }
+
+    // Ones in [0, p_pos).
+    [[nodiscard]]
+    size_type rank1(size_type p_pos) const noexcept
+    {
+      const auto word = p_pos / word_bits;
+      auto ones = static_cast<size_type>(m_ranks[word / block_words]);
+
+      for(auto idx = word - (word % block_words); idx < word; ++idx)
+      {
+        ones += static_cast<size_type>(std::popcount(m_words[idx]));
+      }
+
+      if(const auto bits = p_pos % word_bits;
+         0 != bits)
+      {
+        ones += static_cast<size_type>(std::popcount(m_words[word] & ((uint64_t{1} << bits) - 1)));
+      }
+
+      return ones;
+    }
+
+    // Position of zero number p_zero, counting from 0.
+    [[nodiscard]]
+    size_type select0(size_type p_zero) const noexcept
+    {
+      // Last block with at most p_zero zeros before it.
+      size_type low = 0;
+      size_type high = m_ranks.size() - 1;
+      while((high - low) > 1)
+      {
+        const auto mid = low + ((high - low) / 2);
+        if(zeros_before(mid) <= p_zero)
+        {
+          low = mid;
+        }
+        else
+        {
+          high = mid;
+        }
+      }
+
+      auto remaining = p_zero - zeros_before(low);
+      for(auto word = low * block_words; ; ++word)
+      {
+        auto zeros = ~m_words[word];
+        const auto count = static_cast<size_type>(std::popcount(zeros));
+
+        if(remaining < count)
+        {
+          for(; 0 != remaining; --remaining)
+          {
+            zeros &= zeros - 1;
+          }
+          return (word * word_bits) + static_cast<size_type>(std::countr_zero(zeros));
+        }
+        remaining -= count;
+      }
+    }
+
+    [[nodiscard]]
+    size_type memory_size() const noexcept
+    {
+      return (m_words.size() + m_ranks.size()) * sizeof(uint64_t);
+    }
+
+  private:
+    [[nodiscard]]
+    size_type zeros_before(size_type p_block) const noexcept
+    {
+      return (p_block * block_bits) - static_cast<size_type>(m_ranks[p_block]);
+    }
+
+    yy_quad::simple_vector<uint64_t> m_words{};
+    yy_quad::simple_vector<uint64_t> m_ranks{};
+    size_type m_size = 0;
+};
+
+// Labels front coded in buckets of 16: the first label of a bucket
+// is stored whole, the rest as the length of the prefix shared with
+// the previous label plus the remaining suffix. Siblings are sorted,
+// so device ids under one parent mostly share long prefixes.
+class front_coded_labels final
+{
+  public:
+    static constexpr size_type bucket_size = 16;
+
+    void push_back(std::string_view p_label)
+    {
+      if(0 == (m_size % bucket_size))
+      {
+        m_buckets.emplace_back(m_bytes.size());
+        put_varint(p_label.size());
+        m_bytes.append(p_label);
+      }
+      else
+      {
+        const auto limit = std::min(p_label.size(), m_previous.size());
+        size_type prefix = 0;
+        while((prefix < limit) && (p_label[prefix] == m_previous[prefix]))
+        {
+          ++prefix;
+        }
+
+        put_varint(prefix);
+        put_varint(p_label.size() - prefix);
+        m_bytes.append(p_label.substr(prefix));
+      }
+
+      m_previous.assign(p_label);
+      ++m_size;
+    }
+
+    // Decodes label p_idx into p_label.
+    void get(size_type p_idx,
+             std::string & p_label) const
+    {
+      const char * pos = m_bytes.data() + m_buckets[p_idx / bucket_size];
+
+      const auto size = get_varint(pos);
+      p_label.assign(pos, size);
+      pos += size;
+
+      for(size_type idx = 0; idx < (p_idx % bucket_size); ++idx)
+      {
+        const auto prefix = get_varint(pos);
+        const auto suffix = get_varint(pos);
+        p_label.resize(prefix);
+        p_label.append(pos, suffix);
+        pos += suffix;
+      }
+    }
+
+    [[nodiscard]]
+    size_type size() const noexcept
+    {
+      return m_size;
+    }
+
+    // Only needed while pushing labels.
+    void finish()
+    {
+      m_previous.clear();
+      m_previous.shrink_to_fit();
+    }
+
+    [[nodiscard]]
+    size_type memory_size() const noexcept
+    {
+      return m_bytes.size() + (m_buckets.size() * sizeof(uint64_t));
+    }
+
+  private:
+    void put_varint(size_type p_value)
+    {
+      while(p_value >= 0x80)
+      {
+        m_bytes.push_back(static_cast<char>((p_value & 0x7f) | 0x80));
+        p_value >>= 7;
+      }
+      m_bytes.push_back(static_cast<char>(p_value));
+    }
+
+    static size_type get_varint(const char *& p_pos) noexcept
+    {
+      size_type value = 0;
+      for(unsigned shift = 0; ; shift += 7)
+      {
+        const auto byte = static_cast<uint8_t>(*p_pos++);
+        value |= static_cast<size_type>(byte & 0x7f) << shift;
+        if(0 == (byte & 0x80))
+        {
+          return value;
+        }
+      }
+    }
+
+    std::string m_bytes{};
+    yy_quad::simple_vector<uint64_t> m_buckets{};
+    std::string m_previous{};
+    size_type m_size = 0;
+};
+
+// Order of siblings: '#', then '+', then literal levels by byte.
+[[nodiscard]]
+constexpr bool level_less(std::string_view p_lhs,
+                          std::string_view p_rhs) noexcept
+{
+  auto rank = [](std::string_view level) {
+    return (mqtt_detail::TopicMultiLevelWildcard == level) ? 0
+      : (mqtt_detail::TopicSingleLevelWildcard == level) ? 1 : 2;
+  };
+
+  const auto lhs_rank = rank(p_lhs);
+  const auto rhs_rank = rank(p_rhs);
+
+  return (lhs_rank != rhs_rank) ? (lhs_rank < rhs_rank) : (p_lhs < p_rhs);
+}
+
+// Level by level order of filters, a filter before its extensions.
+[[nodiscard]]
+constexpr bool filter_less(std::string_view p_lhs,
+                           std::string_view p_rhs) noexcept
+{
+  while(true)
+  {
+    const auto lhs_pos = p_lhs.find(mqtt_detail::TopicLevelSeparatorChar);
+    const auto rhs_pos = p_rhs.find(mqtt_detail::TopicLevelSeparatorChar);
+    const auto lhs_level = p_lhs.substr(0, lhs_pos);
+    const auto rhs_level = p_rhs.substr(0, rhs_pos);
+
+    if(lhs_level != rhs_level)
+    {
+      return level_less(lhs_level, rhs_level);
+    }
+
+    if((std::string_view::npos == lhs_pos) || (std::string_view::npos == rhs_pos))
+    {
+      return (std::string_view::npos == lhs_pos) && (std::string_view::npos != rhs_pos);
+    }
+
+    p_lhs.remove_prefix(lhs_pos + 1);
+    p_rhs.remove_prefix(rhs_pos + 1);
+  }
+}
+
+// Nodes in breadth first order. louds holds, for each node, a one per
+// child then a zero, so the children of node n are the nodes after
+// the ones preceding the n'th zero. Node n > 0 has label n - 1.
+// '#' and '+' children, when present, are a node's first children,
+// flagged by multi and single so no label is decoded to find them.
+struct louds_tables final
+{
+    bit_vector louds{};
+    bit_vector accept{};
+    bit_vector multi{};
+    bit_vector single{};
+    front_coded_labels labels{};
+};
+
+template<typename ValueType>
+class Query final
+{
+  public:
+    using value_type = ValueType;
+    using value_ptr = value_type *;
+    using data_vector = yy_quad::simple_vector<value_type>;
+    using payloads_type = yy_quad::simple_vector<value_ptr>;
+    using payloads_span_type = yy_quad::span<typename payloads_type::value_type>;
+
+    struct state_type final
+    {
+        node_idx node = root_node;
+        bool single = false; // Reached through '+'.
+    };
+    using states_type = yy_quad::simple_vector<state_type>;
+
+    Query(louds_tables && p_tables,
+          data_vector && p_data) noexcept:
+      m_tables(std::move(p_tables)),
+      m_data(std::move(p_data))
+    {
+      m_active.reserve(4);
+      m_next.reserve(4);
+      m_payloads.reserve(3);
+    }
+
+    Query() noexcept = default;
+    Query(const Query &) = delete;
+    Query(Query &&) noexcept = default;
+    ~Query() noexcept = default;
+
+    Query & operator=(const Query &) = delete;
+    Query & operator=(Query &&) noexcept = default;
+
+    // Payloads are in no particular order.
+    [[nodiscard]]
+    payloads_span_type find(std::string_view p_topic) noexcept
+    {
+      m_payloads.clear(yy_quad::ClearAction::Keep);
+
+      if(!p_topic.empty() && (0 != node_count()))
+      {
+        find_levels(topic_tokenize_view(m_levels, p_topic), mqtt_detail::TopicSysChar == p_topic[0]);
+      }
+
+      return yy_quad::make_span(m_payloads);
+    }
+
+    [[nodiscard]]
+    payloads_span_type find(const Topic & p_topic) noexcept
+    {
+      m_payloads.clear(yy_quad::ClearAction::Keep);
+
+      if(!p_topic.empty() && (0 != node_count()))
+      {
+        find_levels(p_topic.levels(), p_topic.is_sys());
+      }
+
+      return yy_quad::make_span(m_payloads);
+    }
+
+    [[nodiscard]]
+    size_type node_count() const noexcept
+    {
+      return m_tables.accept.size();
+    }
+
+    // Bytes used by the trie, excluding values.
+    [[nodiscard]]
+    size_type memory_size() const noexcept
+    {
+      return m_tables.louds.memory_size()
+        + m_tables.accept.memory_size()
+        + m_tables.multi.memory_size()
+        + m_tables.single.memory_size()
+        + m_tables.labels.memory_size();
+    }
+
+  private:
+    // First child and one past the last child of p_node.
+    [[nodiscard]]
+    std::tuple<node_idx, node_idx> children(node_idx p_node) const noexcept
+    {
+      const auto begin = (root_node == p_node) ? 0 : m_tables.louds.select0(p_node - 1) + 1;
+      const auto end = m_tables.louds.select0(p_node);
+      // Ones before begin, plus the root.
+      const auto first = static_cast<node_idx>(begin - p_node + 1);
+
+      return {first, static_cast<node_idx>(first + (end - begin))};
+    }
+
+    [[nodiscard]]
+    node_idx find_literal(node_idx p_begin,
+                          node_idx p_end,
+                          std::string_view p_level) noexcept
+    {
+      while(p_begin < p_end)
+      {
+        const auto mid = p_begin + ((p_end - p_begin) / 2);
+        m_tables.labels.get(mid - 1, m_label);
+
+        if(m_label == p_level)
+        {
+          return mid;
+        }
+
+        if(std::string_view{m_label} < p_level)
+        {
+          p_begin = mid + 1;
+        }
+        else
+        {
+          p_end = mid;
+        }
+      }
+
+      return no_node;
+    }
+
+    void add_payload(node_idx p_node) noexcept
+    {
+      if(m_tables.accept[p_node])
+      {
+        m_payloads.emplace_back(&m_data[m_tables.accept.rank1(p_node)]);
+      }
+    }
+
+    void find_levels(const TopicLevelsView & p_levels,
+                     bool p_sys) noexcept
+    {
+      m_active.clear(yy_quad::ClearAction::Keep);
+      m_active.emplace_back(root_node, false);
+
+      const auto size = p_levels.size();
+      for(size_type idx = 0; (idx < size) && !m_active.empty(); ++idx)
+      {
+        const auto level = p_levels[idx];
+        // Topic is 'abc/cde/'.
+        const bool trailing = (idx > 0) && ((idx + 1) == size) && level.empty();
+
+        m_next.clear(yy_quad::ClearAction::Keep);
+        for(const auto & [node, single] : m_active)
+        {
+          // mqtt-v5.0 4.7.2 Topics beginning with $
+          // Wildcards at the first level do not match topics beginning with '$'.
+          const bool wildcards = !p_sys || (root_node != node);
+          auto [child, end] = children(node);
+
+          if(m_tables.multi[node])
+          {
+            // 'abc/#' matches 'abc/cde'.
+            if(wildcards)
+            {
+              add_payload(child);
+            }
+            ++child;
+          }
+
+          if(trailing && single)
+          {
+            // 'abc/+' matches 'abc/cde/'.
+            add_payload(node);
+          }
+
+          if(m_tables.single[node])
+          {
+            if(wildcards)
+            {
+              m_next.emplace_back(child, true);
+            }
+            ++child;
+          }
+
+          if(const auto literal = find_literal(child, end, level);
+             no_node != literal)
+          {
+            m_next.emplace_back(literal, false);
+          }
+        }
+
+        std::swap(m_active, m_next);
+      }
+
+      for(const auto & state : m_active)
+      {
+        add_payload(state.node);
+
+        if(m_tables.multi[state.node])
+        {
+          // 'abc/#' matches 'abc'.
+          add_payload(std::get<0>(children(state.node)));
+        }
+      }
+    }
+
+    louds_tables m_tables{};
+    data_vector m_data{};
+    TopicLevelsView m_levels{};
+    std::string m_label{};
+    states_type m_active{};
+    states_type m_next{};
+    payloads_type m_payloads{};
+};
+
+// Builds louds_tables from filters given in filter_less() order, one
+// depth of the trie at a time: in sorted input the nodes at each depth
+// appear in breadth first order, so no pointer trie is needed.
+template<typename ValueType>
+class louds_builder final
+{
+  public:
+    using value_type = ValueType;
+    using automaton_type = Query<value_type>;
+    using data_vector = typename automaton_type::data_vector;
+
+    louds_builder():
+      m_depths(1)
+    {
+      m_depths[0].add_node(std::string_view{}, false);
+    }
+
+    louds_builder(const louds_builder &) = delete;
+    louds_builder(louds_builder &&) noexcept = default;
+    ~louds_builder() = default;
+
+    louds_builder & operator=(const louds_builder &) = delete;
+    louds_builder & operator=(louds_builder &&) noexcept = default;
+
+    // False if p_filter is empty or sorts before the previous filter.
+    // A repeated filter replaces the previous value.
+    bool add_sorted(std::string_view p_filter,
+                    value_type p_value)
+    {
+      topic_tokenize_view(m_levels, p_filter);
+
+      const auto size = m_levels.size();
+      const auto previous = m_previous.size();
+      if(0 == size)
+      {
+        return false;
+      }
+
+      size_type common = 0;
+      while((common < size) && (common < previous) && (m_levels[common] == m_previous[common]))
+      {
+        ++common;
+      }
+
+      if((common == size) && (common == previous))
+      {
+        m_depths[size].values.back() = std::move(p_value);
+        return true;
+      }
+
+      if((common == size)
+         || ((common < previous) && !level_less(m_previous[common], m_levels[common])))
+      {
+        return false;
+      }
+
+      if(m_depths.size() <= size)
+      {
+        m_depths.resize(size + 1);
+      }
+
+      for(size_type depth = common; depth < size; ++depth)
+      {
+        const auto level = m_levels[depth];
+        auto & parent = m_depths[depth];
+
+        ++parent.children.back();
+        if(mqtt_detail::TopicMultiLevelWildcard == level)
+        {
+          parent.multi.back() = true;
+        }
+        else if(mqtt_detail::TopicSingleLevelWildcard == level)
+        {
+          parent.single.back() = true;
+        }
+
+        const bool accept = (depth + 1) == size;
+        auto & child = m_depths[depth + 1];
+        child.add_node(level, accept);
+        if(accept)
+        {
+          child.values.emplace_back(std::move(p_value));
+        }
+      }
+
+      m_previous.clear();
+      for(const auto level : m_levels)
+      {
+        m_previous.emplace_back(level);
+      }
+
+      return true;
+    }
+
+    // One filter per line in filter_less() order. p_value(filter, line)
+    // gives the value for each. False at the first line out of order.
+    template<typename ValueFn>
+    bool read_sorted(std::istream & p_input,
+                     ValueFn && p_value)
+    {
+      std::string filter{};
+
+      for(size_type line = 0; std::getline(p_input, filter); ++line)
+      {
+        if(!add_sorted(filter, p_value(std::string_view{filter}, line)))
+        {
+          return false;
+        }
+      }
+
+      return true;
+    }
+
+    [[nodiscard]]
+    automaton_type create_automaton()
+    {
+      louds_tables tables{};
+      data_vector data{};
+
+      for(size_type depth = 0; depth < m_depths.size(); ++depth)
+      {
+        auto & nodes = m_depths[depth];
+
+        for(size_type idx = 0; idx < nodes.children.size(); ++idx)
+        {
+          for(uint32_t child = 0; child < nodes.children[idx]; ++child)
+          {
+            tables.louds.push_back(true);
+          }
+          tables.louds.push_back(false);
+          tables.accept.push_back(nodes.accept[idx]);
+          tables.multi.push_back(nodes.multi[idx]);
+          tables.single.push_back(nodes.single[idx]);
+        }
+
+        if(0 != depth)
+        {
+          for(const auto label : nodes.labels)
+          {
+            tables.labels.push_back(label);
+          }
+        }
+
+        for(auto & value : nodes.values)
+        {
+          data.emplace_back(std::move(value));
+        }
+      }
+
+      tables.louds.build_index();
+      tables.accept.build_index();
+      tables.labels.finish();
+
+      return automaton_type{std::move(tables), std::move(data)};
+    }
+
+  private:
+    struct depth_nodes final
+    {
+        void add_node(std::string_view p_label,
+                      bool p_accept)
+        {
+          children.emplace_back(0);
+          labels.emplace_back(p_label);
+          accept.push_back(p_accept);
+          multi.push_back(false);
+          single.push_back(false);
+        }
+
+        std::vector<uint32_t> children{};
+        TopicLevelsBuffer labels{};
+        std::vector<bool> accept{};
+        std::vector<bool> multi{};
+        std::vector<bool> single{};
+        std::vector<value_type> values{};
+    };
+
+    std::vector<depth_nodes> m_depths;
+    TopicLevelsView m_levels{};
+    TopicLevelsBuffer m_previous{};
+};
+
+} // namespace louds_topics_detail
+
+// Read-only succinct filter trie for very large, mostly literal
+// filter sets: about two bits per node for the structure plus the
+// front coded labels. Lookups decode labels while binary searching
+// siblings, so are slower than the pointer engines. For sorted input
+// use louds_builder directly, which never holds the whole filter set.
+template<typename ValueType>
+class louds_topics final
+{
+  public:
+    using value_type = ValueType;
+    using builder_type = louds_topics_detail::louds_builder<value_type>;
+    using automaton_type = typename builder_type::automaton_type;
+
+    louds_topics() = default;
+    louds_topics(const louds_topics &) = default;
+    louds_topics(louds_topics &&) noexcept = default;
+    ~louds_topics() = default;
+
+    louds_topics & operator=(const louds_topics &) = default;
+    louds_topics & operator=(louds_topics &&) noexcept = default;
+
+    void add(std::string_view p_filter,
+             value_type p_value)
+    {
+      m_filters.emplace_back(p_filter);
+      m_values.emplace_back(std::move(p_value));
+    }
+
+    [[nodiscard]]
+    automaton_type create_automaton() const
+    {
+      std::vector<size_type> order(m_filters.size());
+      std::iota(order.begin(), order.end(), size_type{0});
+      // Stable, so the last value added for a filter wins.
+      std::stable_sort(order.begin(), order.end(), [this](size_type lhs, size_type rhs) {
+        return louds_topics_detail::filter_less(m_filters[lhs], m_filters[rhs]);
+      });
+
+      builder_type builder{};
+      for(const auto idx : order)
+      {
+        std::ignore = builder.add_sorted(m_filters[idx], m_values[idx]);
+      }
+
+      return builder.create_automaton();
+    }
+
+  private:
+    std::vector<std::string> m_filters{};
+    std::vector<value_type> m_values{};
+};
+
+} // namespace yafiyogi::yy_mqtt
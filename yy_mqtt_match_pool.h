@@ -0,0 +1,395 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <latch>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "yy_mqtt_mpmc_queue.h"
+#include "yy_mqtt_numa.h"
+#include "yy_mqtt_types.h"
+
+namespace yafiyogi::yy_mqtt {
+
+struct match_pool_options final
+{
+    size_type workers = 4;
+    // Topics are hashed onto strands; many more strands than workers
+    // lets a busy worker's backlog be stolen in small pieces.
+    size_type strands_per_worker = 64;
+    // Messages taken from a strand before it is requeued.
+    size_type batch_size = 32;
+    // Idle workers take strands queued on other workers.
+    bool steal = true;
+    // Spread workers round robin over the NUMA nodes, each pinned to
+    // its node's CPUs. No effect on a single node machine.
+    bool numa_pin = false;
+};
+
+// Work-stealing match and dispatch executor. post() hashes the topic
+// onto a strand, and each strand is queued on the worker it hashes to.
+// A worker runs find() with its own automaton Query over a batch of
+// the strand's messages, hands each message and its payloads to the
+// dispatch function, then requeues the strand if more arrived. An
+// idle worker steals queued strands from its peers.
+//
+// A strand is run by one worker at a time and its messages are taken
+// in order, so messages with the same topic are dispatched in the
+// order they were posted, whichever worker runs them.
+//
+// Each worker builds its Query on its own thread, after any NUMA
+// pinning, so first touch places the automaton's nodes in memory local
+// to the worker that reads them.
+template<typename QueryType,
+         typename MessageType>
+class match_pool final
+{
+  public:
+    using query_type = QueryType;
+    using message_type = MessageType;
+    using payloads_span_type = decltype(std::declval<query_type &>().find(std::string_view{}));
+    using query_factory = std::function<query_type()>;
+    using dispatch_type = std::function<void(std::string_view /* topic */,
+                                             const message_type &,
+                                             payloads_span_type)>;
+
+    // p_make_query is called once on each worker thread, before the
+    // constructor returns. p_dispatch is called from every worker thread.
+    match_pool(const query_factory & p_make_query,
+               dispatch_type p_dispatch,
+               match_pool_options p_options = match_pool_options{}):
+      m_options(p_options),
+      m_dispatch(std::move(p_dispatch)),
+      m_strand_mask(std::bit_ceil(std::max(p_options.workers, size_type{1})
+                                  * std::max(p_options.strands_per_worker, size_type{1})) - 1),
+      m_strands(m_strand_mask + 1)
+    {
+      const size_type workers = std::max(m_options.workers, size_type{1});
+
+      m_workers.reserve(workers);
+      for(size_type idx = 0; idx < workers; ++idx)
+      {
+        // Every strand may be queued on one worker at once.
+        m_workers.emplace_back(std::make_unique<worker>(m_strands.size()));
+      }
+
+      std::latch started{static_cast<std::ptrdiff_t>(workers)};
+      for(size_type idx = 0; idx < workers; ++idx)
+      {
+        m_workers[idx]->thread = std::thread{[this, idx, &p_make_query, &started]() {
+          start(idx, p_make_query);
+          started.count_down();
+          run(idx);
+        }};
+      }
+      started.wait();
+    }
+
+    match_pool() = delete;
+    match_pool(const match_pool &) = delete;
+    match_pool(match_pool &&) = delete;
+
+    ~match_pool()
+    {
+      {
+        std::lock_guard lock{m_wait_mutex};
+        m_stop = true;
+      }
+      m_wait.notify_all();
+
+      for(auto & l_worker : m_workers)
+      {
+        l_worker->thread.join();
+      }
+    }
+
+    match_pool & operator=(const match_pool &) = delete;
+    match_pool & operator=(match_pool &&) = delete;
+
+    void post(std::string p_topic,
+              message_type p_message)
+    {
+      const size_type strand_idx = std::hash<std::string_view>{}(p_topic) & m_strand_mask;
+      auto & l_strand = m_strands[strand_idx];
+
+      m_pending.fetch_add(1, std::memory_order_relaxed);
+
+      bool schedule = false;
+      {
+        std::lock_guard lock{l_strand.mutex};
+        l_strand.messages.emplace_back(std::move(p_topic), std::move(p_message));
+        schedule = !std::exchange(l_strand.scheduled, true);
+      }
+
+      if(schedule)
+      {
+        enqueue(strand_idx % m_workers.size(), strand_idx);
+      }
+    }
+
+    // Blocks until every message posted so far has been dispatched.
+    void flush()
+    {
+      std::unique_lock lock{m_wait_mutex};
+      m_idle.wait(lock, [this]() {
+        return 0 == m_pending.load(std::memory_order_acquire);
+      });
+    }
+
+    [[nodiscard]]
+    size_type worker_count() const noexcept
+    {
+      return m_workers.size();
+    }
+
+    // Strands a worker took from a peer's queue.
+    [[nodiscard]]
+    size_type steals() const noexcept
+    {
+      size_type total = 0;
+      for(const auto & l_worker : m_workers)
+      {
+        total += l_worker->steals.load(std::memory_order_relaxed);
+      }
+
+      return total;
+    }
+
+  private:
+    struct item final
+    {
+        item() = default;
+        item(std::string p_topic,
+             message_type p_message):
+          topic(std::move(p_topic)),
+          message(std::move(p_message))
+        {
+        }
+
+        std::string topic{};
+        message_type message{};
+    };
+
+    struct strand final
+    {
+        std::mutex mutex{};
+        std::deque<item> messages{};
+        bool scheduled = false;
+    };
+
+    struct worker final
+    {
+        explicit worker(size_type p_capacity):
+          ready(p_capacity)
+        {
+        }
+
+        std::unique_ptr<query_type> query{};
+        mpmc_queue<size_type> ready;
+        std::atomic<size_type> queued{0};
+        std::deque<item> batch{};
+        std::atomic<size_type> steals{0};
+        std::thread thread{};
+    };
+
+    void enqueue(size_type p_worker,
+                 size_type p_strand)
+    {
+      // Never full: a strand is queued at most once and every queue
+      // can hold all the strands.
+      auto & l_worker = *m_workers[p_worker];
+      std::ignore = l_worker.ready.try_push(p_strand);
+      l_worker.queued.fetch_add(1, std::memory_order_release);
+      m_queued.fetch_add(1, std::memory_order_release);
+
+      {
+        // Pairs with the predicate check in run(), so the wake-up
+        // cannot fall between a worker's check and its wait.
+        std::lock_guard lock{m_wait_mutex};
+      }
+
+      if(m_options.steal)
+      {
+        m_wait.notify_one();
+      }
+      else
+      {
+        // Only the owning worker may take the strand.
+        m_wait.notify_all();
+      }
+    }
+
+    bool take(size_type p_worker,
+              size_type & p_strand)
+    {
+      auto & self = *m_workers[p_worker];
+
+      if(self.ready.try_pop(p_strand))
+      {
+        self.queued.fetch_sub(1, std::memory_order_acq_rel);
+        m_queued.fetch_sub(1, std::memory_order_acq_rel);
+        return true;
+      }
+
+      if(m_options.steal)
+      {
+        const size_type workers = m_workers.size();
+        for(size_type offset = 1; offset < workers; ++offset)
+        {
+          auto & peer = *m_workers[(p_worker + offset) % workers];
+          if(peer.ready.try_pop(p_strand))
+          {
+            peer.queued.fetch_sub(1, std::memory_order_acq_rel);
+            m_queued.fetch_sub(1, std::memory_order_acq_rel);
+            self.steals.fetch_add(1, std::memory_order_relaxed);
+            return true;
+          }
+        }
+      }
+
+      return false;
+    }
+
+    void run_strand(worker & p_worker,
+                    size_type p_worker_idx,
+                    size_type p_strand)
+    {
+      auto & l_strand = m_strands[p_strand];
+      auto & batch = p_worker.batch;
+
+      {
+        std::lock_guard lock{l_strand.mutex};
+        const auto count = std::min(l_strand.messages.size(), m_options.batch_size);
+        std::move(l_strand.messages.begin(), l_strand.messages.begin() + static_cast<std::ptrdiff_t>(count),
+                  std::back_inserter(batch));
+        l_strand.messages.erase(l_strand.messages.begin(), l_strand.messages.begin() + static_cast<std::ptrdiff_t>(count));
+      }
+
+      for(const auto & l_item : batch)
+      {
+        m_dispatch(l_item.topic, l_item.message, p_worker.query->find(l_item.topic));
+      }
+
+      const auto done = batch.size();
+      batch.clear();
+
+      bool requeue = false;
+      {
+        std::lock_guard lock{l_strand.mutex};
+        requeue = !l_strand.messages.empty();
+        l_strand.scheduled = requeue;
+      }
+
+      if(requeue)
+      {
+        // Back of this worker's queue, behind strands already waiting.
+        enqueue(p_worker_idx, p_strand);
+      }
+
+      if(done == m_pending.fetch_sub(done, std::memory_order_acq_rel))
+      {
+        std::lock_guard lock{m_wait_mutex};
+        m_idle.notify_all();
+      }
+    }
+
+    void start(size_type p_worker_idx,
+               const query_factory & p_make_query)
+    {
+      if(m_options.numa_pin)
+      {
+        const auto & topology = numa_topology::system();
+        if(topology.node_count() > 1)
+        {
+          std::ignore = topology.pin_to_node(p_worker_idx % topology.node_count());
+        }
+      }
+
+      // Built in place, so the Query need not be movable.
+      m_workers[p_worker_idx]->query.reset(new query_type(p_make_query()));
+    }
+
+    void run(size_type p_worker_idx)
+    {
+      auto & self = *m_workers[p_worker_idx];
+      size_type strand_idx = 0;
+
+      while(true)
+      {
+        if(take(p_worker_idx, strand_idx))
+        {
+          run_strand(self, p_worker_idx, strand_idx);
+          continue;
+        }
+
+        std::unique_lock lock{m_wait_mutex};
+        if(m_stop)
+        {
+          break;
+        }
+
+        m_wait.wait(lock, [this, &self]() {
+          return m_stop
+            || (0 != (m_options.steal ? m_queued : self.queued).load(std::memory_order_acquire));
+        });
+
+        if(m_stop)
+        {
+          break;
+        }
+      }
+    }
+
+    const match_pool_options m_options;
+    dispatch_type m_dispatch;
+    const size_type m_strand_mask;
+    std::vector<strand> m_strands;
+    std::vector<std::unique_ptr<worker>> m_workers{};
+    std::atomic<size_type> m_pending{0};
+    std::atomic<size_type> m_queued{0};
+    std::mutex m_wait_mutex{};
+    std::condition_variable m_wait{};
+    std::condition_variable m_idle{};
+    bool m_stop = false;
+};
+
+} // namespace yafiyogi::yy_mqtt
@@ -0,0 +1,195 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <cstddef>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <utility>
+
+#include "yy_mqtt_types.h"
+
+namespace yafiyogi::yy_mqtt {
+namespace mpmc_queue_detail {
+
+// Fixed rather than std::hardware_destructive_interference_size, whose
+// value may differ between translation units.
+inline constexpr std::size_t cache_line_size = 64;
+
+} // namespace mpmc_queue_detail
+
+// Bounded multi-producer multi-consumer queue (D. Vyukov's bounded
+// MPMC queue). Each cell carries a sequence number telling producers
+// and consumers whose turn it is, so a push or pop is one CAS on the
+// shared position plus one release store on the cell. Cells and the
+// two positions sit on their own cache lines.
+//
+// try_push() fails when the queue is full and try_pop() when it is
+// empty; neither blocks. ValueType must be default constructible and
+// move assignable. A popped cell is left moved-from, so a handle such
+// as a std::shared_ptr releases its reference when popped.
+template<typename ValueType>
+class mpmc_queue final
+{
+  public:
+    using value_type = ValueType;
+
+    // p_capacity is rounded up to a power of two, at least 2.
+    explicit mpmc_queue(size_type p_capacity):
+      m_mask(std::bit_ceil(std::max(p_capacity, size_type{2})) - 1),
+      m_cells(std::make_unique<cell[]>(m_mask + 1))
+    {
+      for(size_type idx = 0; idx <= m_mask; ++idx)
+      {
+        m_cells[idx].sequence.store(idx, std::memory_order_relaxed);
+      }
+    }
+
+    mpmc_queue() = delete;
+    mpmc_queue(const mpmc_queue &) = delete;
+    mpmc_queue(mpmc_queue &&) = delete;
+    ~mpmc_queue() = default;
+
+    mpmc_queue & operator=(const mpmc_queue &) = delete;
+    mpmc_queue & operator=(mpmc_queue &&) = delete;
+
+    template<typename Value>
+    [[nodiscard]]
+    bool try_push(Value && p_value) noexcept
+    {
+      size_type pos = m_enqueue_pos.load(std::memory_order_relaxed);
+
+      while(true)
+      {
+        cell & l_cell = m_cells[pos & m_mask];
+        const size_type sequence = l_cell.sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+
+        if(0 == diff)
+        {
+          // Cell is free for this position, claim it.
+          if(m_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+          {
+            l_cell.value = std::forward<Value>(p_value);
+            l_cell.sequence.store(pos + 1, std::memory_order_release);
+            return true;
+          }
+        }
+        else if(diff < 0)
+        {
+          // Cell not yet consumed from the previous lap: full.
+          return false;
+        }
+        else
+        {
+          pos = m_enqueue_pos.load(std::memory_order_relaxed);
+        }
+      }
+    }
+
+    [[nodiscard]]
+    bool try_pop(value_type & p_value) noexcept
+    {
+      size_type pos = m_dequeue_pos.load(std::memory_order_relaxed);
+
+      while(true)
+      {
+        cell & l_cell = m_cells[pos & m_mask];
+        const size_type sequence = l_cell.sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1);
+
+        if(0 == diff)
+        {
+          // Cell holds the value for this position, claim it.
+          if(m_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+          {
+            p_value = std::move(l_cell.value);
+            l_cell.value = value_type{};
+            l_cell.sequence.store(pos + m_mask + 1, std::memory_order_release);
+            return true;
+          }
+        }
+        else if(diff < 0)
+        {
+          // Cell not yet filled: empty.
+          return false;
+        }
+        else
+        {
+          pos = m_dequeue_pos.load(std::memory_order_relaxed);
+        }
+      }
+    }
+
+    [[nodiscard]]
+    size_type capacity() const noexcept
+    {
+      return m_mask + 1;
+    }
+
+    // Only a snapshot while other threads push or pop.
+    [[nodiscard]]
+    size_type size_approx() const noexcept
+    {
+      const size_type enqueue_pos = m_enqueue_pos.load(std::memory_order_relaxed);
+      const size_type dequeue_pos = m_dequeue_pos.load(std::memory_order_relaxed);
+
+      return (enqueue_pos > dequeue_pos) ? (enqueue_pos - dequeue_pos) : 0;
+    }
+
+  private:
+    struct alignas(mpmc_queue_detail::cache_line_size) cell final
+    {
+        std::atomic<size_type> sequence{0};
+        value_type value{};
+    };
+
+    const size_type m_mask;
+    std::unique_ptr<cell[]> m_cells;
+    alignas(mpmc_queue_detail::cache_line_size) std::atomic<size_type> m_enqueue_pos{0};
+    alignas(mpmc_queue_detail::cache_line_size) std::atomic<size_type> m_dequeue_pos{0};
+};
+
+// One matched delivery handed to an I/O worker: the payload the
+// automaton's find() returned and a reference counted message handle,
+// e.g. std::shared_ptr<const Message>.
+template<typename ValuePtr,
+         typename MessageHandle>
+struct delivery final
+{
+    ValuePtr value{};
+    MessageHandle message{};
+};
+
+template<typename ValuePtr,
+         typename MessageHandle>
+using delivery_queue = mpmc_queue<delivery<ValuePtr, MessageHandle>>;
+
+} // namespace yafiyogi::yy_mqtt
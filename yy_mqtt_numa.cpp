@@ -0,0 +1,179 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#include "yy_mqtt_numa.h"
+
+namespace yafiyogi::yy_mqtt {
+namespace {
+
+bool parse_int(std::string_view p_value,
+               int & p_int)
+{
+  const auto [ptr, ec] = std::from_chars(p_value.data(), p_value.data() + p_value.size(), p_int);
+
+  return (std::errc{} == ec) && (p_value.data() + p_value.size() == ptr);
+}
+
+bool read_cpu_list(const std::string & p_path,
+                   cpu_list & p_cpus)
+{
+  std::ifstream file{p_path};
+  std::string line{};
+
+  return std::getline(file, line) && numa_parse_cpu_list(line, p_cpus);
+}
+
+} // namespace
+
+bool numa_parse_cpu_list(std::string_view p_list,
+                         cpu_list & p_cpus)
+{
+  p_cpus.clear();
+
+  while(!p_list.empty() && (('\n' == p_list.back()) || (' ' == p_list.back())))
+  {
+    p_list.remove_suffix(1);
+  }
+
+  while(!p_list.empty())
+  {
+    const auto comma = p_list.find(',');
+    const auto range = p_list.substr(0, comma);
+    p_list = (std::string_view::npos == comma) ? std::string_view{} : p_list.substr(comma + 1);
+
+    const auto dash = range.find('-');
+    int first = 0;
+    int last = 0;
+
+    if(!parse_int(range.substr(0, dash), first)
+       || !parse_int((std::string_view::npos == dash) ? range : range.substr(dash + 1), last)
+       || (last < first))
+    {
+      p_cpus.clear();
+      return false;
+    }
+
+    for(int cpu = first; cpu <= last; ++cpu)
+    {
+      p_cpus.emplace_back(cpu);
+    }
+  }
+
+  return true;
+}
+
+numa_topology::numa_topology(std::string_view p_sysfs_root)
+{
+  const std::string root{p_sysfs_root};
+  cpu_list online{};
+
+  if(read_cpu_list(root + "/online", online))
+  {
+    for(const auto node : online)
+    {
+      if(static_cast<size_type>(node) >= m_nodes.size())
+      {
+        m_nodes.resize(static_cast<size_type>(node) + 1);
+      }
+
+      read_cpu_list(root + "/node" + std::to_string(node) + "/cpulist", m_nodes[static_cast<size_type>(node)]);
+    }
+  }
+
+  if(m_nodes.empty())
+  {
+    m_nodes.resize(1);
+  }
+}
+
+const numa_topology & numa_topology::system()
+{
+  static const numa_topology topology{};
+
+  return topology;
+}
+
+size_type numa_topology::current_node() const noexcept
+{
+  if(1 == m_nodes.size())
+  {
+    return 0;
+  }
+
+  unsigned cpu = 0;
+  unsigned node = 0;
+  if((0 != ::getcpu(&cpu, &node))
+     || (node >= m_nodes.size()))
+  {
+    return 0;
+  }
+
+  return node;
+}
+
+bool numa_topology::pin_to_node(size_type p_node) const noexcept
+{
+  if((p_node >= m_nodes.size())
+     || m_nodes[p_node].empty())
+  {
+    return false;
+  }
+
+  // sysfs may list CPUs past CPU_SETSIZE, so the set is sized to the
+  // node's highest CPU rather than using a fixed cpu_set_t.
+  const auto & cpus = m_nodes[p_node];
+  const auto max_cpu = *std::max_element(cpus.begin(), cpus.end());
+  const auto cpu_count = max_cpu + 1;
+
+  cpu_set_t * set = CPU_ALLOC(cpu_count);
+  if(nullptr == set)
+  {
+    return false;
+  }
+
+  const auto set_size = CPU_ALLOC_SIZE(cpu_count);
+  CPU_ZERO_S(set_size, set);
+  for(const auto cpu : cpus)
+  {
+    CPU_SET_S(cpu, set_size, set);
+  }
+
+  const bool pinned = 0 == ::pthread_setaffinity_np(::pthread_self(), set_size, set);
+  CPU_FREE(set);
+
+  return pinned;
+}
+
+} // namespace yafiyogi::yy_mqtt
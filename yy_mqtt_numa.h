@@ -0,0 +1,86 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+#include "yy_mqtt_types.h"
+
+namespace yafiyogi::yy_mqtt {
+
+using cpu_list = std::vector<int>;
+
+// Parses a sysfs CPU list such as '0-3,8,10-11'. False if malformed.
+bool numa_parse_cpu_list(std::string_view p_list,
+                         cpu_list & p_cpus);
+
+// NUMA nodes and their CPUs, read from sysfs. Where sysfs has no node
+// information the machine is treated as a single node, and pinning
+// does nothing, so callers need no special case for it.
+class numa_topology final
+{
+  public:
+    static constexpr std::string_view default_sysfs_root{"/sys/devices/system/node"};
+
+    explicit numa_topology(std::string_view p_sysfs_root = default_sysfs_root);
+    numa_topology(const numa_topology &) = default;
+    numa_topology(numa_topology &&) noexcept = default;
+    ~numa_topology() = default;
+
+    numa_topology & operator=(const numa_topology &) = default;
+    numa_topology & operator=(numa_topology &&) noexcept = default;
+
+    // Topology of this machine, read once.
+    static const numa_topology & system();
+
+    [[nodiscard]]
+    size_type node_count() const noexcept
+    {
+      return m_nodes.size();
+    }
+
+    // Empty for the single node fallback.
+    [[nodiscard]]
+    const cpu_list & cpus(size_type p_node) const noexcept
+    {
+      return m_nodes[p_node];
+    }
+
+    // Node the calling thread is running on, 0 if unknown.
+    [[nodiscard]]
+    size_type current_node() const noexcept;
+
+    // Restricts the calling thread to the CPUs of p_node, so memory it
+    // touches first is allocated on that node. False if not pinned.
+    bool pin_to_node(size_type p_node) const noexcept;
+
+  private:
+    std::vector<cpu_list> m_nodes{};
+};
+
+} // namespace yafiyogi::yy_mqtt
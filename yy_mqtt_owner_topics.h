@@ -0,0 +1,218 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include <algorithm>
+#include <limits>
+#include <string_view>
+#include <utility>
+
+#include "yy_cpp/yy_span.h"
+#include "yy_cpp/yy_vector.h"
+
+#include "yy_mqtt_topic.h"
+
+namespace yafiyogi::yy_mqtt {
+
+using owner_id_type = uint32_t;
+
+// How to get the owner (client) of a payload. Owner ids should be
+// small and dense, as they index the dedup stamps. Specialise for
+// payload types without an owner_id member.
+template<typename ValueType>
+struct owner_traits final
+{
+    [[nodiscard]]
+    static constexpr owner_id_type owner_id(const ValueType & p_value) noexcept
+    {
+      return p_value.owner_id;
+    }
+};
+
+namespace owner_topics_detail {
+
+template<typename AutomatonType,
+         typename OwnerTraits>
+class Query final
+{
+  public:
+    using automaton_type = AutomatonType;
+    using value_type = typename automaton_type::value_type;
+    using value_ptr = value_type *;
+    using payloads_type = yy_quad::simple_vector<value_ptr>;
+    using payloads_span_type = yy_quad::span<typename payloads_type::value_type>;
+    using stamps_type = yy_quad::simple_vector<uint32_t>;
+    using size_type = typename stamps_type::size_type;
+
+    // p_owner_count is one more than the largest owner id added, so
+    // find() never has to grow the stamps.
+    template<typename TopicsType>
+    Query(const TopicsType & p_topics,
+          size_type p_owner_count):
+      m_automaton(p_topics.create_automaton())
+    {
+      m_stamps.resize(p_owner_count);
+      m_payloads.reserve(3);
+    }
+
+    Query() = delete;
+    Query(const Query &) = delete;
+    Query(Query &&) noexcept = default;
+    ~Query() = default;
+
+    Query & operator=(const Query &) = delete;
+    Query & operator=(Query &&) noexcept = default;
+
+    // Matching payloads, at most one per owner: the first found.
+    // Each owner's stamp is compared with the lookup's generation, so
+    // nothing is cleared between lookups and the work is O(matches).
+    [[nodiscard]]
+    payloads_span_type find(std::string_view p_topic) noexcept
+    {
+      return first_per_owner(m_automaton.find(p_topic));
+    }
+
+    [[nodiscard]]
+    payloads_span_type find(const Topic & p_topic) noexcept
+    {
+      return first_per_owner(m_automaton.find(p_topic));
+    }
+
+    // Every matching payload, as the wrapped automaton returns them.
+    [[nodiscard]]
+    auto find_all(std::string_view p_topic) noexcept
+    {
+      return m_automaton.find(p_topic);
+    }
+
+    [[nodiscard]]
+    auto find_all(const Topic & p_topic) noexcept
+    {
+      return m_automaton.find(p_topic);
+    }
+
+    [[nodiscard]]
+    automaton_type & automaton() noexcept
+    {
+      return m_automaton;
+    }
+
+  private:
+    template<typename Found>
+    payloads_span_type first_per_owner(Found p_found) noexcept
+    {
+      m_payloads.clear(yy_quad::ClearAction::Keep);
+      next_generation();
+
+      for(auto payload : p_found)
+      {
+        const auto owner = OwnerTraits::owner_id(*payload);
+        if(owner >= m_stamps.size())
+        {
+          // Not seen when the stamps were sized, e.g. a payload's owner
+          // changed after add(). Passed through, not deduplicated.
+          m_payloads.emplace_back(payload);
+          continue;
+        }
+
+        if(auto & stamp = m_stamps[owner];
+           m_generation != stamp)
+        {
+          stamp = m_generation;
+          m_payloads.emplace_back(payload);
+        }
+      }
+
+      return yy_quad::make_span(m_payloads);
+    }
+
+    void next_generation() noexcept
+    {
+      if(std::numeric_limits<uint32_t>::max() == m_generation)
+      {
+        for(auto & stamp : m_stamps)
+        {
+          stamp = 0;
+        }
+        m_generation = 0;
+      }
+      ++m_generation;
+    }
+
+    automaton_type m_automaton;
+    stamps_type m_stamps{};
+    uint32_t m_generation = 0;
+    payloads_type m_payloads{};
+};
+
+} // namespace owner_topics_detail
+
+// Builder wrapper whose automaton emits each owner at most once per
+// lookup, as MQTT delivers a message once per client however many of
+// its subscriptions match.
+template<typename TopicsType,
+         typename OwnerTraits = owner_traits<typename TopicsType::automaton_type::value_type>>
+class owner_topics final
+{
+  public:
+    using topics_type = TopicsType;
+    using value_type = typename topics_type::automaton_type::value_type;
+    using automaton_type = owner_topics_detail::Query<typename topics_type::automaton_type,
+                                                      OwnerTraits>;
+
+    owner_topics() = default;
+    owner_topics(const owner_topics &) = delete;
+    owner_topics(owner_topics &&) noexcept = default;
+    ~owner_topics() = default;
+
+    owner_topics & operator=(const owner_topics &) = delete;
+    owner_topics & operator=(owner_topics &&) noexcept = default;
+
+    void add(std::string_view p_filter,
+             value_type p_value)
+    {
+      const auto owner_count = static_cast<size_type>(OwnerTraits::owner_id(p_value)) + 1;
+      m_topics.add(p_filter, std::move(p_value));
+      m_owner_count = std::max(m_owner_count, owner_count);
+    }
+
+    [[nodiscard]]
+    automaton_type create_automaton() const
+    {
+      return automaton_type{m_topics, m_owner_count};
+    }
+
+  private:
+    using size_type = typename automaton_type::size_type;
+
+    topics_type m_topics{};
+    size_type m_owner_count = 0;
+};
+
+} // namespace yafiyogi::yy_mqtt
@@ -0,0 +1,478 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <cstdint>
+#include <cstring>
+
+#include <algorithm>
+#include <string_view>
+
+#include "yy_mqtt_constants.h"
+#include "yy_mqtt_packet.h"
+#include "yy_mqtt_types.h"
+#include "yy_mqtt_util.h"
+
+namespace yafiyogi::yy_mqtt {
+namespace {
+
+// Bounds checked reads from a packet. Any read past the end marks the
+// reader as failed, and reads return zero from then on.
+class packet_reader final
+{
+  public:
+    constexpr explicit packet_reader(std::string_view p_buffer) noexcept:
+      m_buffer(p_buffer)
+    {
+    }
+
+    [[nodiscard]]
+    constexpr bool ok() const noexcept
+    {
+      return m_ok;
+    }
+
+    [[nodiscard]]
+    constexpr size_type remaining() const noexcept
+    {
+      return m_buffer.size() - m_pos;
+    }
+
+    [[nodiscard]]
+    constexpr std::string_view rest() const noexcept
+    {
+      return m_buffer.substr(m_pos);
+    }
+
+    constexpr uint8_t read_u8() noexcept
+    {
+      if(!check(1))
+      {
+        return 0;
+      }
+
+      return static_cast<uint8_t>(m_buffer[m_pos++]);
+    }
+
+    // mqtt-v5.0-os 1.5.2 Two Byte Integer, big endian.
+    constexpr uint16_t read_u16() noexcept
+    {
+      if(!check(2))
+      {
+        return 0;
+      }
+
+      const auto value = static_cast<uint16_t>((static_cast<uint8_t>(m_buffer[m_pos]) << 8)
+                                               | static_cast<uint8_t>(m_buffer[m_pos + 1]));
+      m_pos += 2;
+
+      return value;
+    }
+
+    // mqtt-v5.0-os 1.5.3 Four Byte Integer, big endian.
+    constexpr uint32_t read_u32() noexcept
+    {
+      const uint32_t high = read_u16();
+      const uint32_t low = read_u16();
+
+      return (high << 16) | low;
+    }
+
+    uint32_t read_variable_byte_integer() noexcept
+    {
+      uint32_t value = 0;
+      if(!m_ok
+         || (DecodeStatus::Ok != decode_variable_byte_integer(m_buffer, m_pos, value)))
+      {
+        m_ok = false;
+        return 0;
+      }
+
+      return value;
+    }
+
+    constexpr std::string_view read_bytes(size_type p_size) noexcept
+    {
+      if(!check(p_size))
+      {
+        return std::string_view{};
+      }
+
+      const auto bytes{m_buffer.substr(m_pos, p_size)};
+      m_pos += p_size;
+
+      return bytes;
+    }
+
+    // mqtt-v5.0-os 1.5.4 UTF-8 Encoded String and 1.5.6 Binary Data,
+    // both prefixed by a Two Byte Integer length.
+    constexpr std::string_view read_string() noexcept
+    {
+      const auto size = read_u16();
+
+      return read_bytes(size);
+    }
+
+  private:
+    constexpr bool check(size_type p_size) noexcept
+    {
+      m_ok = m_ok && (p_size <= remaining());
+
+      return m_ok;
+    }
+
+    std::string_view m_buffer;
+    size_type m_pos = 0;
+    bool m_ok = true;
+};
+
+// Splits a whole packet into its fixed header and the remaining
+// bytes, checking the packet type.
+DecodeStatus packet_body(std::string_view p_packet,
+                         PacketType p_type,
+                         FixedHeader & p_header,
+                         std::string_view & p_body) noexcept
+{
+  if(auto status = decode_fixed_header(p_packet, p_header);
+     DecodeStatus::Ok != status)
+  {
+    return status;
+  }
+
+  if(p_type != p_header.type)
+  {
+    return DecodeStatus::WrongType;
+  }
+
+  if(p_packet.size() < p_header.packet_size())
+  {
+    return DecodeStatus::Incomplete;
+  }
+
+  p_body = p_packet.substr(p_header.header_size, p_header.remaining_length);
+
+  return DecodeStatus::Ok;
+}
+
+// mqtt-v5.0-os 1.5.4 UTF-8 Encoded String
+// A UTF-8 Encoded String MUST NOT include an encoding of the null
+// character U+0000.
+bool has_null(std::string_view p_string) noexcept
+{
+  return std::string_view::npos != p_string.find('\0');
+}
+
+} // namespace
+
+DecodeStatus decode_variable_byte_integer(std::string_view p_buffer,
+                                          size_type & p_pos,
+                                          uint32_t & p_value) noexcept
+{
+  const size_type available = (p_pos < p_buffer.size()) ? std::min(p_buffer.size() - p_pos, size_type{4}) : 0;
+  uint8_t bytes[4] = {0, 0, 0, 0};
+  if(0 != available)
+  {
+    std::memcpy(bytes, p_buffer.data() + p_pos, available);
+  }
+
+  uint32_t value = 0;
+  size_type size = 0;
+  const auto status = decode_variable_byte_integer(bytes, available, value, size);
+
+  if(DecodeStatus::Ok == status)
+  {
+    p_pos += size;
+    p_value = value;
+  }
+
+  return status;
+}
+
+DecodeStatus decode_fixed_header(std::string_view p_buffer,
+                                 FixedHeader & p_header) noexcept
+{
+  if(p_buffer.empty())
+  {
+    return DecodeStatus::Incomplete;
+  }
+
+  const auto byte = static_cast<uint8_t>(p_buffer[0]);
+  size_type pos = 1;
+  uint32_t remaining_length = 0;
+
+  if(auto status = decode_variable_byte_integer(p_buffer, pos, remaining_length);
+     DecodeStatus::Ok != status)
+  {
+    return status;
+  }
+
+  p_header.type = static_cast<PacketType>(byte >> 4);
+  p_header.flags = byte & 0x0F;
+  p_header.remaining_length = remaining_length;
+  p_header.header_size = static_cast<uint8_t>(pos);
+
+  return DecodeStatus::Ok;
+}
+
+DecodeStatus decode_property(std::string_view & p_properties,
+                             Property & p_property) noexcept
+{
+  packet_reader reader{p_properties};
+
+  const auto id = reader.read_variable_byte_integer();
+  p_property = Property{};
+  p_property.id = static_cast<uint8_t>(id);
+
+  // mqtt-v5.0-os 2.2.2.2 Property, table 2-4.
+  switch(id)
+  {
+    // Byte
+    case 0x01: case 0x17: case 0x19: case 0x24: case 0x25: case 0x28: case 0x29: case 0x2A:
+      p_property.value = reader.read_u8();
+      break;
+
+    // Two Byte Integer
+    case 0x13: case 0x21: case 0x22: case 0x23:
+      p_property.value = reader.read_u16();
+      break;
+
+    // Four Byte Integer
+    case 0x02: case 0x11: case 0x18: case 0x27:
+      p_property.value = reader.read_u32();
+      break;
+
+    // Variable Byte Integer
+    case 0x0B:
+      p_property.value = reader.read_variable_byte_integer();
+      break;
+
+    // UTF-8 Encoded String
+    case 0x03: case 0x08: case 0x12: case 0x15: case 0x1A: case 0x1C: case 0x1F:
+      p_property.data = reader.read_string();
+      if(has_null(p_property.data))
+      {
+        return DecodeStatus::Malformed;
+      }
+      break;
+
+    // Binary Data
+    case 0x09: case 0x16:
+      p_property.data = reader.read_string();
+      break;
+
+    // UTF-8 String Pair
+    case 0x26:
+      p_property.data = reader.read_string();
+      p_property.pair_value = reader.read_string();
+      break;
+
+    default:
+      return DecodeStatus::Malformed;
+  }
+
+  if(!reader.ok())
+  {
+    return DecodeStatus::Malformed;
+  }
+
+  p_properties = reader.rest();
+
+  return DecodeStatus::Ok;
+}
+
+DecodeStatus decode_publish(std::string_view p_packet,
+                            ProtocolVersion p_version,
+                            PublishPacket & p_publish) noexcept
+{
+  FixedHeader header{};
+  std::string_view body{};
+
+  if(auto status = packet_body(p_packet, PacketType::Publish, header, body);
+     DecodeStatus::Ok != status)
+  {
+    return status;
+  }
+
+  // mqtt-v5.0-os 3.3.1 PUBLISH Fixed Header
+  p_publish = PublishPacket{};
+  p_publish.dup = 0 != (header.flags & 0x08);
+  p_publish.qos = (header.flags >> 1) & 0x03;
+  p_publish.retain = 0 != (header.flags & 0x01);
+
+  // A PUBLISH Packet MUST NOT have both QoS bits set to 1, and the
+  // DUP flag MUST be set to 0 for all QoS 0 messages.
+  if((3 == p_publish.qos)
+     || (p_publish.dup && (0 == p_publish.qos)))
+  {
+    return DecodeStatus::Malformed;
+  }
+
+  packet_reader reader{body};
+
+  // mqtt-v5.0-os 3.3.2 PUBLISH Variable Header
+  p_publish.topic = reader.read_string();
+  if(0 != p_publish.qos)
+  {
+    p_publish.packet_id = reader.read_u16();
+  }
+
+  if(ProtocolVersion::V5 == p_version)
+  {
+    const auto properties_size = reader.read_variable_byte_integer();
+    p_publish.properties = reader.read_bytes(properties_size);
+  }
+
+  if(!reader.ok()
+     || ((0 != p_publish.qos) && (0 == p_publish.packet_id)))
+  {
+    return DecodeStatus::Malformed;
+  }
+
+  auto properties{p_publish.properties};
+  while(!properties.empty())
+  {
+    Property property{};
+    if(auto status = decode_property(properties, property);
+       DecodeStatus::Ok != status)
+    {
+      return status;
+    }
+
+    if(static_cast<uint8_t>(PropertyId::TopicAlias) == property.id)
+    {
+      // A Topic Alias value of 0 is not permitted.
+      if(0 == property.value)
+      {
+        return DecodeStatus::Malformed;
+      }
+      p_publish.topic_alias = static_cast<uint16_t>(property.value);
+    }
+  }
+
+  // An empty topic is only allowed when a Topic Alias is used.
+  if(p_publish.topic.empty())
+  {
+    if(0 == p_publish.topic_alias)
+    {
+      return DecodeStatus::InvalidTopic;
+    }
+  }
+  else if(has_null(p_publish.topic)
+          || (TopicValidStatus::Valid != topic_validate(p_publish.topic, TopicType::Name)))
+  {
+    return DecodeStatus::InvalidTopic;
+  }
+
+  p_publish.payload = reader.rest();
+
+  return DecodeStatus::Ok;
+}
+
+DecodeStatus decode_subscribe(std::string_view p_packet,
+                              ProtocolVersion p_version,
+                              SubscribePacket & p_subscribe)
+{
+  FixedHeader header{};
+  std::string_view body{};
+
+  if(auto status = packet_body(p_packet, PacketType::Subscribe, header, body);
+     DecodeStatus::Ok != status)
+  {
+    return status;
+  }
+
+  // mqtt-v5.0-os 3.8.1 SUBSCRIBE Fixed Header, flags are 0b0010.
+  if(0x02 != header.flags)
+  {
+    return DecodeStatus::Malformed;
+  }
+
+  packet_reader reader{body};
+
+  p_subscribe.filters.clear();
+  p_subscribe.properties = std::string_view{};
+  p_subscribe.packet_id = reader.read_u16();
+
+  if(ProtocolVersion::V5 == p_version)
+  {
+    const auto properties_size = reader.read_variable_byte_integer();
+    p_subscribe.properties = reader.read_bytes(properties_size);
+  }
+
+  if(!reader.ok()
+     || (0 == p_subscribe.packet_id))
+  {
+    return DecodeStatus::Malformed;
+  }
+
+  // Reserved bits: 2-7 for MQTT 3.1.1, 6-7 for MQTT 5.
+  const uint8_t reserved = (ProtocolVersion::V5 == p_version) ? 0xC0 : 0xFC;
+
+  // mqtt-v5.0-os 3.8.3 SUBSCRIBE Payload
+  while(0 != reader.remaining())
+  {
+    SubscribeFilter filter{};
+    filter.filter = reader.read_string();
+    filter.options = reader.read_u8();
+
+    if(!reader.ok()
+       || (0 != (filter.options & reserved))
+       || (3 == filter.qos())
+       || (0x30 == (filter.options & 0x30))) // Retain Handling 3.
+    {
+      return DecodeStatus::Malformed;
+    }
+
+    if(filter.filter.empty()
+       || has_null(filter.filter)
+       || (TopicValidStatus::Valid != topic_validate(filter.filter, TopicType::Filter)))
+    {
+      return DecodeStatus::InvalidTopic;
+    }
+
+    p_subscribe.filters.emplace_back(filter);
+  }
+
+  // The payload MUST contain at least one Topic Filter.
+  if(p_subscribe.filters.empty())
+  {
+    return DecodeStatus::Malformed;
+  }
+
+  auto properties{p_subscribe.properties};
+  while(!properties.empty())
+  {
+    Property property{};
+    if(auto status = decode_property(properties, property);
+       DecodeStatus::Ok != status)
+    {
+      return status;
+    }
+  }
+
+  return DecodeStatus::Ok;
+}
+
+} // namespace yafiyogi::yy_mqtt
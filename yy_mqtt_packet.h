@@ -0,0 +1,194 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include <string_view>
+
+#include "yy_cpp/yy_vector.h"
+
+#include "yy_mqtt_types.h"
+
+namespace yafiyogi::yy_mqtt {
+
+// mqtt-v5.0-os 2.1.2 MQTT Control Packet type
+enum class PacketType:uint8_t {
+  Reserved = 0,
+  Connect = 1,
+  ConnAck = 2,
+  Publish = 3,
+  PubAck = 4,
+  PubRec = 5,
+  PubRel = 6,
+  PubComp = 7,
+  Subscribe = 8,
+  SubAck = 9,
+  Unsubscribe = 10,
+  UnsubAck = 11,
+  PingReq = 12,
+  PingResp = 13,
+  Disconnect = 14,
+  Auth = 15
+};
+
+// Protocol Level of the CONNECT packet.
+enum class ProtocolVersion:uint8_t {
+  V311 = 4,
+  V5 = 5
+};
+
+enum class DecodeStatus:uint8_t {
+  Ok,
+  Incomplete,    // More bytes are needed.
+  Malformed,
+  InvalidTopic,
+  WrongType
+};
+
+// mqtt-v5.0-os 2.2.3 Property
+enum class PropertyId:uint8_t {
+  PayloadFormatIndicator = 0x01,
+  MessageExpiryInterval = 0x02,
+  ContentType = 0x03,
+  ResponseTopic = 0x08,
+  CorrelationData = 0x09,
+  SubscriptionIdentifier = 0x0B,
+  TopicAlias = 0x23,
+  UserProperty = 0x26
+};
+
+struct FixedHeader final
+{
+    PacketType type = PacketType::Reserved;
+    uint8_t flags = 0;
+    uint32_t remaining_length = 0;
+    uint8_t header_size = 0;    // Fixed header bytes.
+
+    [[nodiscard]]
+    constexpr size_type packet_size() const noexcept
+    {
+      return static_cast<size_type>(header_size) + remaining_length;
+    }
+};
+
+// A decoded property. Integer properties set value, string and binary
+// properties set data, and a User Property also sets pair_value.
+struct Property final
+{
+    uint8_t id = 0;
+    uint32_t value = 0;
+    std::string_view data{};
+    std::string_view pair_value{};
+};
+
+// All views point into the decoded buffer, which must outlive them.
+struct PublishPacket final
+{
+    std::string_view topic{};
+    std::string_view properties{};  // Encoded properties, MQTT 5 only.
+    std::string_view payload{};
+    uint16_t packet_id = 0;
+    uint16_t topic_alias = 0;        // 0 if not set.
+    uint8_t qos = 0;
+    bool dup = false;
+    bool retain = false;
+};
+
+struct SubscribeFilter final
+{
+    std::string_view filter{};
+    uint8_t options = 0;            // Subscription Options byte.
+
+    [[nodiscard]]
+    constexpr uint8_t qos() const noexcept
+    {
+      return options & 0x03;
+    }
+};
+
+struct SubscribePacket final
+{
+    using filters_type = yy_quad::simple_vector<SubscribeFilter, yy_quad::ClearAction::Keep>;
+
+    std::string_view properties{};  // Encoded properties, MQTT 5 only.
+    filters_type filters{};         // Reused between decodes.
+    uint16_t packet_id = 0;
+};
+
+// mqtt-v5.0-os 1.5.5 Variable Byte Integer
+// Decodes up to four bytes without branching on the continuation
+// bits. p_bytes past p_available must be zero. Sets p_size to the
+// encoded size, which is more than p_available if bytes are missing.
+[[nodiscard]]
+constexpr DecodeStatus decode_variable_byte_integer(const uint8_t (&p_bytes)[4],
+                                                    size_type p_available,
+                                                    uint32_t & p_value,
+                                                    size_type & p_size) noexcept
+{
+  const uint32_t more_0 = p_bytes[0] >> 7;
+  const uint32_t more_1 = more_0 & (p_bytes[1] >> 7);
+  const uint32_t more_2 = more_1 & (p_bytes[2] >> 7);
+  const uint32_t more_3 = more_2 & (p_bytes[3] >> 7);
+
+  p_size = 1 + more_0 + more_1 + more_2;
+  p_value = (p_bytes[0] & 0x7FU)
+    | (((p_bytes[1] & 0x7FU) << 7) * more_0)
+    | (((p_bytes[2] & 0x7FU) << 14) * more_1)
+    | (((p_bytes[3] & 0x7FU) << 21) * more_2);
+
+  // A missing byte reads as zero, so the size stops one past the
+  // available bytes.
+  const uint32_t incomplete = p_size > p_available ? 1 : 0;
+  constexpr DecodeStatus status[2][2] = {{DecodeStatus::Ok, DecodeStatus::Incomplete},
+                                         {DecodeStatus::Malformed, DecodeStatus::Malformed}};
+
+  return status[more_3][incomplete];
+}
+
+// mqtt-v5.0-os 1.5.5 Variable Byte Integer
+DecodeStatus decode_variable_byte_integer(std::string_view p_buffer,
+                                          size_type & p_pos,
+                                          uint32_t & p_value) noexcept;
+
+DecodeStatus decode_fixed_header(std::string_view p_buffer,
+                                 FixedHeader & p_header) noexcept;
+
+// Decode the next property in p_properties and advance past it.
+DecodeStatus decode_property(std::string_view & p_properties,
+                             Property & p_property) noexcept;
+
+// p_packet holds a whole packet, starting at its fixed header.
+DecodeStatus decode_publish(std::string_view p_packet,
+                            ProtocolVersion p_version,
+                            PublishPacket & p_publish) noexcept;
+
+DecodeStatus decode_subscribe(std::string_view p_packet,
+                              ProtocolVersion p_version,
+                              SubscribePacket & p_subscribe);
+
+} // namespace yafiyogi::yy_mqtt
@@ -0,0 +1,144 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include "yy_mqtt_perfect_hash.h"
+
+namespace yafiyogi::yy_mqtt {
+namespace {
+
+// Enough for the last singleton buckets of a 100k key table, which
+// need about n tries each to hit one of the few free slots.
+constexpr uint32_t max_seed = uint32_t{1} << 24;
+
+bool has_duplicates(yy_quad::const_span<uint64_t> p_hashes)
+{
+  std::vector<uint64_t> sorted{p_hashes.begin(), p_hashes.end()};
+  std::sort(sorted.begin(), sorted.end());
+
+  return sorted.end() != std::adjacent_find(sorted.begin(), sorted.end());
+}
+
+} // namespace
+
+bool perfect_hash_build(yy_quad::const_span<uint64_t> p_hashes,
+                        std::vector<uint32_t> & p_seeds,
+                        std::vector<uint32_t> & p_slots)
+{
+  const auto size = static_cast<uint32_t>(p_hashes.size());
+  const auto bucket_count = perfect_hash_bucket_count(size);
+
+  p_seeds.assign(bucket_count, 0);
+  p_slots.assign(size, 0);
+
+  if(0 == size)
+  {
+    return true;
+  }
+
+  if(has_duplicates(p_hashes))
+  {
+    return false;
+  }
+
+  // Keys grouped by bucket, counting sort.
+  std::vector<uint32_t> bucket_begin(bucket_count + 1, 0);
+  for(const auto hash : p_hashes)
+  {
+    ++bucket_begin[perfect_hash_bucket(hash, bucket_count) + 1];
+  }
+  std::partial_sum(bucket_begin.begin(), bucket_begin.end(), bucket_begin.begin());
+
+  std::vector<uint32_t> keys(size);
+  {
+    std::vector<uint32_t> fill{bucket_begin.begin(), bucket_begin.end() - 1};
+    for(uint32_t key = 0; key < size; ++key)
+    {
+      keys[fill[perfect_hash_bucket(p_hashes[key], bucket_count)]++] = key;
+    }
+  }
+
+  // Largest buckets first, while most slots are free.
+  std::vector<uint32_t> order(bucket_count);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&bucket_begin](uint32_t lhs, uint32_t rhs) {
+    return (bucket_begin[lhs + 1] - bucket_begin[lhs]) > (bucket_begin[rhs + 1] - bucket_begin[rhs]);
+  });
+
+  std::vector<bool> taken(size, false);
+  std::vector<uint32_t> candidate{};
+
+  for(const auto bucket : order)
+  {
+    const auto begin = bucket_begin[bucket];
+    const auto end = bucket_begin[bucket + 1];
+    if(begin == end)
+    {
+      break;
+    }
+
+    uint32_t seed = 0;
+    for(; seed < max_seed; ++seed)
+    {
+      candidate.clear();
+      for(auto idx = begin; idx < end; ++idx)
+      {
+        const auto slot = perfect_hash_slot(p_hashes[keys[idx]], seed, size);
+        if(taken[slot]
+           || (candidate.end() != std::find(candidate.begin(), candidate.end(), slot)))
+        {
+          break;
+        }
+        candidate.emplace_back(slot);
+      }
+
+      if(candidate.size() == (end - begin))
+      {
+        break;
+      }
+    }
+
+    if(max_seed == seed)
+    {
+      return false;
+    }
+
+    p_seeds[bucket] = seed;
+    for(auto idx = begin; idx < end; ++idx)
+    {
+      const auto slot = candidate[idx - begin];
+      taken[slot] = true;
+      p_slots[keys[idx]] = slot;
+    }
+  }
+
+  return true;
+}
+
+} // namespace yafiyogi::yy_mqtt
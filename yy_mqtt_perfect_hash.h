@@ -0,0 +1,99 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include <vector>
+
+#include "yy_cpp/yy_span.h"
+
+#include "yy_mqtt_types.h"
+
+namespace yafiyogi::yy_mqtt {
+namespace perfect_hash_detail {
+
+inline constexpr uint64_t seed_step = 0x9e3779b97f4a7c15ULL;
+
+// Keys per displacement bucket, trades build time for seed storage.
+inline constexpr size_type keys_per_bucket = 4;
+
+// splitmix64 finalizer, spreads the weak low bits of FNV-1a.
+[[nodiscard]]
+constexpr uint64_t mix(uint64_t p_hash) noexcept
+{
+  p_hash = (p_hash ^ (p_hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  p_hash = (p_hash ^ (p_hash >> 27)) * 0x94d049bb133111ebULL;
+
+  return p_hash ^ (p_hash >> 31);
+}
+
+// Maps the top 32 bits of p_hash onto [0, p_size) without a division.
+[[nodiscard]]
+constexpr uint32_t reduce(uint64_t p_hash,
+                          uint32_t p_size) noexcept
+{
+  return static_cast<uint32_t>(((p_hash >> 32) * p_size) >> 32);
+}
+
+} // namespace perfect_hash_detail
+
+// Hash and displace minimal perfect hash (after CHD). Keys are
+// grouped into buckets by hash, and each bucket stores the seed that
+// sends all its keys to distinct free slots, so n keys fill exactly n
+// slots. Keys not in the build set also map to some slot, so a
+// lookup must compare the key stored there.
+[[nodiscard]]
+constexpr uint32_t perfect_hash_bucket_count(size_type p_keys) noexcept
+{
+  return static_cast<uint32_t>((p_keys + perfect_hash_detail::keys_per_bucket - 1) / perfect_hash_detail::keys_per_bucket);
+}
+
+[[nodiscard]]
+constexpr uint32_t perfect_hash_bucket(uint64_t p_hash,
+                                       uint32_t p_buckets) noexcept
+{
+  return perfect_hash_detail::reduce(perfect_hash_detail::mix(p_hash), p_buckets);
+}
+
+[[nodiscard]]
+constexpr uint32_t perfect_hash_slot(uint64_t p_hash,
+                                     uint32_t p_seed,
+                                     uint32_t p_size) noexcept
+{
+  return perfect_hash_detail::reduce(perfect_hash_detail::mix(p_hash + (p_seed * perfect_hash_detail::seed_step)), p_size);
+}
+
+// Finds a seed per bucket for p_hashes. On success p_seeds has
+// perfect_hash_bucket_count() entries and p_slots[i] is the slot of
+// p_hashes[i]. False if two keys share a hash or no seed was found,
+// in which case the caller keeps its ordinary lookup.
+bool perfect_hash_build(yy_quad::const_span<uint64_t> p_hashes,
+                        std::vector<uint32_t> & p_seeds,
+                        std::vector<uint32_t> & p_slots);
+
+} // namespace yafiyogi::yy_mqtt
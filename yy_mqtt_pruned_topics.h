@@ -0,0 +1,154 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "yy_mqtt_types.h"
+#include "yy_mqtt_util.h"
+
+namespace yafiyogi::yy_mqtt {
+
+// Builder wrapper that drops filters subsumed by another filter with
+// an equal value before building TopicsType. For one owner
+// subscribed to 'a/#', 'a/b/+' and 'a/b/c' only 'a/#' is kept, so a
+// matching topic yields one payload instead of three.
+//
+// Filters are pruned as they are added. Only filters with an equal
+// value can subsume each other, so a new filter is compared with the
+// kept filters of its value only.
+template<typename TopicsType,
+         typename ValueHash = std::hash<typename TopicsType::value_type>,
+         typename ValueEqual = std::equal_to<typename TopicsType::value_type>>
+class pruned_topics final
+{
+  public:
+    using topics_type = TopicsType;
+    using value_type = typename topics_type::value_type;
+    using automaton_type = typename topics_type::automaton_type;
+
+    struct filter_type final
+    {
+        std::string filter{};
+        TopicLevelsView levels{};
+        value_type value{};
+        bool pruned = false;
+    };
+    // A deque, so levels viewing a filter survive later additions.
+    using filters_type = std::deque<filter_type>;
+
+    pruned_topics() = default;
+    pruned_topics(const pruned_topics &) = delete;
+    pruned_topics(pruned_topics &&) noexcept = default;
+    ~pruned_topics() = default;
+
+    pruned_topics & operator=(const pruned_topics &) = delete;
+    pruned_topics & operator=(pruned_topics &&) noexcept = default;
+
+    // Of several equal filters with equal values the first is kept.
+    void add(std::string_view p_filter,
+             value_type p_value)
+    {
+      const auto added_idx = m_filters.size();
+      auto & added = m_filters.emplace_back(std::string{p_filter}, TopicLevelsView{}, std::move(p_value), false);
+      topic_tokenize_view(added.levels, added.filter);
+
+      auto & kept = m_kept[added.value];
+      for(const auto kept_idx : kept)
+      {
+        if(filter_subsumes(m_filters[kept_idx].levels, added.levels))
+        {
+          added.pruned = true;
+          ++m_pruned_count;
+          return;
+        }
+      }
+
+      // No kept filter is equal to the added one, so any it subsumes
+      // are strictly more specific.
+      std::erase_if(kept, [this, &added](size_type p_kept_idx) {
+        auto & general = m_filters[p_kept_idx];
+        if(!filter_subsumes(added.levels, general.levels))
+        {
+          return false;
+        }
+
+        general.pruned = true;
+        ++m_pruned_count;
+        return true;
+      });
+
+      kept.emplace_back(added_idx);
+    }
+
+    [[nodiscard]]
+    automaton_type create_automaton() const
+    {
+      topics_type topics{};
+      for(const auto & filter : m_filters)
+      {
+        if(!filter.pruned)
+        {
+          topics.add(filter.filter, filter.value);
+        }
+      }
+
+      return topics.create_automaton();
+    }
+
+    [[nodiscard]]
+    const filters_type & filters() const noexcept
+    {
+      return m_filters;
+    }
+
+    [[nodiscard]]
+    size_type size() const noexcept
+    {
+      return m_filters.size();
+    }
+
+    // Number of filters dropped so far.
+    [[nodiscard]]
+    size_type pruned_count() const noexcept
+    {
+      return m_pruned_count;
+    }
+
+  private:
+    filters_type m_filters{};
+    // Indices in m_filters of the filters kept for each value.
+    std::unordered_map<value_type, std::vector<size_type>, ValueHash, ValueEqual> m_kept{};
+    size_type m_pruned_count = 0;
+};
+
+} // namespace yafiyogi::yy_mqtt
@@ -0,0 +1,822 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "yy_cpp/yy_span.h"
+#include "yy_cpp/yy_vector.h"
+
+#include "yy_mqtt_char_trie.h"
+#include "yy_mqtt_constants.h"
+#include "yy_mqtt_huge_pages.h"
+#include "yy_mqtt_topic.h"
+
+namespace yafiyogi::yy_mqtt {
+namespace radix_topics_detail {
+
+using node_idx = char_trie_detail::node_idx;
+
+inline constexpr node_idx no_node = char_trie_detail::no_node;
+inline constexpr node_idx no_payload = char_trie_detail::no_payload;
+inline constexpr node_idx root_node = 0;
+
+// Once numbered, payload only marks the end of a filter. The value
+// is found through the path number, see radix_tables::paths.
+struct radix_node final
+{
+    uint32_t edges_begin = 0;
+    uint32_t edges_end = 0;
+    node_idx payload = no_payload;
+};
+
+// A wildcard edge is always the single character '+' or '#'. Literal
+// edges never contain a wildcard character, and any position inside a
+// literal label has exactly one continuation, so '+' and '#' only need
+// checking at nodes.
+struct radix_edge final
+{
+    uint8_t first = 0;
+    uint32_t label_offset = 0;
+    uint32_t label_size = 0;
+    node_idx target = no_node;
+    uint32_t path_offset = 0;
+};
+
+// Filter ends are numbered so the number of a filter is the sum of
+// the path offsets of the edges leading to it. Numbers depend only on
+// the shape of the subtree below an edge, so identical subtrees can be
+// merged and still give each filter its own number. paths maps a
+// number to the filter's value.
+struct radix_tables final
+{
+    yy_quad::simple_vector<radix_node> nodes{};
+    yy_quad::simple_vector<radix_edge> edges{};
+    std::string labels{};
+    yy_quad::simple_vector<node_idx> paths{};
+};
+
+enum class RadixLayout:uint8_t {Tree, Minimized};
+
+// Collapses single child chains of the character trie into one edge.
+class radix_builder final
+{
+  public:
+    explicit radix_builder(const char_trie & p_trie) noexcept:
+      m_trie(p_trie)
+    {
+    }
+
+    radix_builder() = delete;
+    radix_builder(const radix_builder &) = delete;
+    radix_builder(radix_builder &&) = delete;
+    ~radix_builder() = default;
+
+    radix_builder & operator=(const radix_builder &) = delete;
+    radix_builder & operator=(radix_builder &&) = delete;
+
+    void build(radix_tables & p_tables)
+    {
+      p_tables.nodes.clear();
+      p_tables.edges.clear();
+      p_tables.labels.clear();
+      p_tables.paths.clear();
+
+      m_pending.clear();
+      m_pending.emplace_back(char_trie_detail::root_node);
+      p_tables.nodes.emplace_back();
+
+      // Nodes are emitted breadth first, so a node's edges are contiguous.
+      for(size_type idx = 0; idx < m_pending.size(); ++idx)
+      {
+        const auto & trie_node = m_trie[m_pending[idx]];
+        auto & node = p_tables.nodes[idx];
+
+        node.payload = trie_node.payload;
+        node.edges_begin = static_cast<uint32_t>(p_tables.edges.size());
+
+        for(const auto & [label, child] : trie_node.edges)
+        {
+          radix_edge edge{};
+          edge.first = label;
+          edge.label_offset = static_cast<uint32_t>(p_tables.labels.size());
+
+          p_tables.labels.push_back(static_cast<char>(label));
+          node_idx target = child;
+          if(!is_wildcard(label))
+          {
+            while(is_chain(target))
+            {
+              const auto [next_label, next] = m_trie[target].edges.front();
+              p_tables.labels.push_back(static_cast<char>(next_label));
+              target = next;
+            }
+          }
+
+          edge.label_size = static_cast<uint32_t>(p_tables.labels.size()) - edge.label_offset;
+          edge.target = static_cast<node_idx>(m_pending.size());
+          m_pending.emplace_back(target);
+          p_tables.edges.emplace_back(edge);
+        }
+
+        // emplace_back() above may reallocate nodes.
+        p_tables.nodes[idx].edges_end = static_cast<uint32_t>(p_tables.edges.size());
+        p_tables.nodes.resize(m_pending.size());
+      }
+
+      number(p_tables);
+    }
+
+  private:
+    // A node's own payload is number 0 of its range, followed by the
+    // ranges of its edges. Children always follow their parent.
+    static void number(radix_tables & p_tables)
+    {
+      std::vector<uint32_t> counts(p_tables.nodes.size(), 0);
+
+      for(size_type idx = p_tables.nodes.size(); idx > 0; --idx)
+      {
+        const auto & node = p_tables.nodes[idx - 1];
+        uint32_t count = (no_payload != node.payload) ? 1 : 0;
+
+        for(auto edge = node.edges_begin; edge < node.edges_end; ++edge)
+        {
+          p_tables.edges[edge].path_offset = count;
+          count += counts[p_tables.edges[edge].target];
+        }
+        counts[idx - 1] = count;
+      }
+
+      std::vector<uint32_t> base(p_tables.nodes.size(), 0);
+      p_tables.paths.resize(counts.empty() ? 0 : counts[root_node]);
+
+      for(size_type idx = 0; idx < p_tables.nodes.size(); ++idx)
+      {
+        const auto & node = p_tables.nodes[idx];
+        if(no_payload != node.payload)
+        {
+          p_tables.paths[base[idx]] = node.payload;
+        }
+
+        for(auto edge = node.edges_begin; edge < node.edges_end; ++edge)
+        {
+          const auto & child = p_tables.edges[edge];
+          base[child.target] = base[idx] + child.path_offset;
+        }
+      }
+    }
+
+    static constexpr bool is_wildcard(uint8_t p_label) noexcept
+    {
+      return (mqtt_detail::TopicSingleLevelWildcardChar == static_cast<char>(p_label))
+        || (mqtt_detail::TopicMultiLevelWildcardChar == static_cast<char>(p_label));
+    }
+
+    // True if p_node can be folded into the edge leading to it.
+    [[nodiscard]]
+    bool is_chain(node_idx p_node) const noexcept
+    {
+      const auto & node = m_trie[p_node];
+
+      return (1 == node.edges.size())
+        && (no_payload == node.payload)
+        && !is_wildcard(std::get<0>(node.edges.front()));
+    }
+
+    const char_trie & m_trie;
+    std::vector<node_idx> m_pending{};
+};
+
+// Merges structurally identical subtrees, e.g. the '/battery',
+// '/linkquality', ... levels repeated under every device, turning the
+// tree into a DAG whose size grows with the number of distinct shapes.
+class radix_minimizer final
+{
+  public:
+    radix_minimizer() noexcept = default;
+    radix_minimizer(const radix_minimizer &) = delete;
+    radix_minimizer(radix_minimizer &&) = delete;
+    ~radix_minimizer() = default;
+
+    radix_minimizer & operator=(const radix_minimizer &) = delete;
+    radix_minimizer & operator=(radix_minimizer &&) = delete;
+
+    void minimize(radix_tables & p_tables)
+    {
+      const auto & nodes = p_tables.nodes;
+
+      m_classes.clear();
+      m_representatives.clear();
+      m_class.assign(nodes.size(), no_node);
+
+      // Children follow their parent, so walking backwards classifies
+      // a node's children before the node.
+      for(size_type idx = nodes.size(); idx > 0; --idx)
+      {
+        const auto node = static_cast<node_idx>(idx - 1);
+        signature(p_tables, node);
+
+        const auto [found, added] = m_classes.try_emplace(m_key, static_cast<node_idx>(m_representatives.size()));
+        if(added)
+        {
+          m_representatives.emplace_back(node);
+        }
+        m_class[node] = found->second;
+      }
+
+      radix_tables minimized{};
+      m_index.assign(m_representatives.size(), no_node);
+      m_pending.clear();
+      add_class(m_class[root_node], minimized);
+
+      for(size_type idx = 0; idx < m_pending.size(); ++idx)
+      {
+        const auto & node = nodes[m_representatives[m_pending[idx]]];
+
+        minimized.nodes[idx].payload = node.payload;
+        minimized.nodes[idx].edges_begin = static_cast<uint32_t>(minimized.edges.size());
+
+        for(auto edge_idx = node.edges_begin; edge_idx < node.edges_end; ++edge_idx)
+        {
+          auto edge{p_tables.edges[edge_idx]};
+          const auto label_offset = static_cast<uint32_t>(minimized.labels.size());
+
+          minimized.labels.append(p_tables.labels, edge.label_offset, edge.label_size);
+          edge.label_offset = label_offset;
+          edge.target = add_class(m_class[edge.target], minimized);
+          minimized.edges.emplace_back(edge);
+        }
+
+        minimized.nodes[idx].edges_end = static_cast<uint32_t>(minimized.edges.size());
+      }
+
+      minimized.paths = std::move(p_tables.paths);
+      p_tables = std::move(minimized);
+    }
+
+  private:
+    // Payload flag, then each edge's label and target class. Path
+    // offsets follow from these, so need not be part of the key.
+    void signature(const radix_tables & p_tables,
+                   node_idx p_node)
+    {
+      const auto & node = p_tables.nodes[p_node];
+
+      m_key.clear();
+      m_key.push_back((no_payload != node.payload) ? '1' : '0');
+
+      for(auto edge_idx = node.edges_begin; edge_idx < node.edges_end; ++edge_idx)
+      {
+        const auto & edge = p_tables.edges[edge_idx];
+        const auto target = m_class[edge.target];
+
+        m_key.append(reinterpret_cast<const char *>(&edge.label_size), sizeof(edge.label_size));
+        m_key.append(p_tables.labels, edge.label_offset, edge.label_size);
+        m_key.append(reinterpret_cast<const char *>(&target), sizeof(target));
+      }
+    }
+
+    node_idx add_class(node_idx p_class,
+                       radix_tables & p_tables)
+    {
+      if(no_node == m_index[p_class])
+      {
+        m_index[p_class] = static_cast<node_idx>(m_pending.size());
+        m_pending.emplace_back(p_class);
+        p_tables.nodes.emplace_back();
+      }
+
+      return m_index[p_class];
+    }
+
+    std::unordered_map<std::string, node_idx> m_classes{};
+    std::vector<node_idx> m_representatives{};
+    std::vector<node_idx> m_class{};
+    std::vector<node_idx> m_index{};
+    std::vector<node_idx> m_pending{};
+    std::string m_key{};
+};
+
+template<typename ValueType>
+class Query final
+{
+  public:
+    using value_type = ValueType;
+    using value_ptr = value_type *;
+    using data_vector = yy_quad::simple_vector<value_type>;
+    using payloads_type = yy_quad::simple_vector<value_ptr>;
+    using payloads_span_type = yy_quad::span<typename payloads_type::value_type>;
+    enum class search_type:uint8_t {Literal, SingleLevel, MultiLevel};
+
+    struct state_type final
+    {
+        std::string_view topic{};
+        node_idx state = root_node;
+        uint32_t path = 0;
+        search_type search = search_type::Literal;
+    };
+    using queue = yy_quad::simple_vector<state_type>;
+
+    // With huge pages requested the tables are copied into one region,
+    // so a lookup walks nodes, edges and labels without leaving it, and
+    // huge pages can cover all three. Otherwise, or when the region
+    // can't be mapped, they stay in their vectors.
+    explicit Query(radix_tables && p_tables,
+                   data_vector && p_data,
+                   HugePages p_pages = HugePages::Off) noexcept:
+      m_tables(std::move(p_tables)),
+      m_data(std::move(p_data)),
+      m_node_count(static_cast<uint32_t>(m_tables.nodes.size())),
+      m_edge_count(static_cast<uint32_t>(m_tables.edges.size())),
+      m_labels_size(static_cast<uint32_t>(m_tables.labels.size()))
+    {
+      if(HugePages::Off != p_pages)
+      {
+        copy_to_region(p_pages);
+      }
+
+      m_search_states.reserve(6);
+      m_payloads.reserve(3);
+    }
+
+    constexpr Query() noexcept = default;
+    Query(const Query &) = delete;
+    constexpr Query(Query &&) noexcept = default;
+    constexpr ~Query() noexcept = default;
+
+    Query & operator=(const Query &) = delete;
+    constexpr Query & operator=(Query &&) noexcept = default;
+
+    [[nodiscard]]
+    constexpr payloads_span_type find(std::string_view p_topic) noexcept
+    {
+      m_search_states.clear(yy_quad::ClearAction::Keep);
+      m_payloads.clear(yy_quad::ClearAction::Keep);
+
+      if(!p_topic.empty() && (0 != node_count()))
+      {
+        find_span(p_topic);
+      }
+
+      return yy_quad::make_span(m_payloads);
+    }
+
+    [[nodiscard]]
+    constexpr payloads_span_type find(const Topic & p_topic) noexcept
+    {
+      return find(p_topic.view());
+    }
+
+    [[nodiscard]]
+    constexpr size_type node_count() const noexcept
+    {
+      // A moved from query has neither region nor tables.
+      return m_region.empty() ? m_tables.nodes.size() : m_node_count;
+    }
+
+    // Bytes used by nodes, edges, labels and path numbers.
+    [[nodiscard]]
+    constexpr size_type memory_size() const noexcept
+    {
+      return (m_node_count * sizeof(radix_node))
+        + (m_edge_count * sizeof(radix_edge))
+        + m_labels_size
+        + (m_tables.paths.size() * sizeof(node_idx));
+    }
+
+    // Pages actually backing the tables.
+    [[nodiscard]]
+    constexpr HugePages backing() const noexcept
+    {
+      return m_region.backing();
+    }
+
+  private:
+    static constexpr size_type align_up(size_type p_offset,
+                                        size_type p_align) noexcept
+    {
+      return ((p_offset + p_align - 1) / p_align) * p_align;
+    }
+
+    void copy_to_region(HugePages p_pages) noexcept
+    {
+      const auto nodes_bytes = m_node_count * sizeof(radix_node);
+      const auto edges_bytes = m_edge_count * sizeof(radix_edge);
+      const auto edges_offset = align_up(nodes_bytes, alignof(radix_edge));
+      const auto labels_offset = edges_offset + edges_bytes;
+
+      huge_page_region region{labels_offset + m_labels_size, p_pages};
+      if(region.empty())
+      {
+        return;
+      }
+
+      auto * base = static_cast<char *>(region.data());
+      copy_table(base, m_tables.nodes.data(), nodes_bytes);
+      copy_table(base + edges_offset, m_tables.edges.data(), edges_bytes);
+      copy_table(base + labels_offset, m_tables.labels.data(), m_labels_size);
+
+      m_region = std::move(region);
+      m_edges_offset = static_cast<uint32_t>(edges_offset);
+      m_labels_offset = static_cast<uint32_t>(labels_offset);
+      m_tables.nodes = yy_quad::simple_vector<radix_node>{};
+      m_tables.edges = yy_quad::simple_vector<radix_edge>{};
+      m_tables.labels = std::string{};
+    }
+
+    // An empty table may have no storage, and memcpy() from null is
+    // undefined even for zero bytes.
+    static void copy_table(char * p_dest,
+                           const void * p_src,
+                           size_type p_size) noexcept
+    {
+      if(0 != p_size)
+      {
+        std::memcpy(p_dest, p_src, p_size);
+      }
+    }
+
+    [[nodiscard]]
+    const radix_node * nodes() const noexcept
+    {
+      if(m_region.empty())
+      {
+        return m_tables.nodes.data();
+      }
+
+      return static_cast<const radix_node *>(m_region.data());
+    }
+
+    [[nodiscard]]
+    const radix_edge * edges() const noexcept
+    {
+      if(m_region.empty())
+      {
+        return m_tables.edges.data();
+      }
+
+      return reinterpret_cast<const radix_edge *>(static_cast<const char *>(m_region.data()) + m_edges_offset);
+    }
+
+    [[nodiscard]]
+    std::string_view label(const radix_edge & p_edge) const noexcept
+    {
+      const char * labels = m_region.empty()
+        ? m_tables.labels.data()
+        : static_cast<const char *>(m_region.data()) + m_labels_offset;
+
+      return std::string_view{labels + p_edge.label_offset, p_edge.label_size};
+    }
+
+    [[nodiscard]]
+    const radix_edge * find_edge(node_idx p_node,
+                                 char p_label) const noexcept
+    {
+      const auto & node = nodes()[p_node];
+      const auto begin = edges() + node.edges_begin;
+      const auto end = edges() + node.edges_end;
+      const auto first = static_cast<uint8_t>(p_label);
+
+      auto edge = std::lower_bound(begin, end, first,
+                                   [](const radix_edge & e, uint8_t label) {
+                                     return e.first < label;
+                                   });
+
+      if((end != edge) && (first == edge->first))
+      {
+        return &*edge;
+      }
+
+      return nullptr;
+    }
+
+    // Wildcard and separator edges are single character.
+    [[nodiscard]]
+    const radix_edge * find_single(node_idx p_node,
+                                   char p_label) const noexcept
+    {
+      const auto * edge = find_edge(p_node, p_label);
+
+      return (nullptr != edge) && (1 == edge->label_size) ? edge : nullptr;
+    }
+
+    constexpr void add_payload(node_idx p_node,
+                               uint32_t p_path) noexcept
+    {
+      if(no_payload != nodes()[p_node].payload)
+      {
+        m_payloads.emplace_back(&m_data[m_tables.paths[p_path]]);
+      }
+    }
+
+    constexpr void add_sub_state(char p_label,
+                                 std::string_view p_topic,
+                                 search_type p_type,
+                                 node_idx p_node,
+                                 uint32_t p_path) noexcept
+    {
+      if(const auto * edge = find_single(p_node, p_label);
+         nullptr != edge)
+      {
+        m_search_states.emplace_back(p_topic, edge->target, p_path + edge->path_offset, p_type);
+      }
+    }
+
+    constexpr void add_wildcards(node_idx p_node,
+                                 uint32_t p_path,
+                                 std::string_view p_topic) noexcept
+    {
+      add_sub_state(mqtt_detail::TopicSingleLevelWildcardChar, p_topic, search_type::SingleLevel, p_node, p_path);
+      add_sub_state(mqtt_detail::TopicMultiLevelWildcardChar, p_topic, search_type::MultiLevel, p_node, p_path);
+    }
+
+    // 'abc/#' matches 'abc'.
+    constexpr void add_parent_multi_level(node_idx p_node,
+                                          uint32_t p_path) noexcept
+    {
+      if(const auto * separator = find_single(p_node, mqtt_detail::TopicLevelSeparatorChar);
+         nullptr != separator)
+      {
+        add_sub_state(mqtt_detail::TopicMultiLevelWildcardChar, std::string_view{}, search_type::MultiLevel,
+                      separator->target, p_path + separator->path_offset);
+      }
+    }
+
+    constexpr void at_end(node_idx p_node,
+                          uint32_t p_path) noexcept
+    {
+      // Topic is 'abc/cde' or 'abc/cde/', add any payloads.
+      add_payload(p_node, p_path);
+      // 'abc/cde/#' matches 'abc/cde', 'abc/cde//#' matches 'abc/cde/'.
+      add_parent_multi_level(p_node, p_path);
+    }
+
+    // Match the label of p_edge, less the first p_skip characters,
+    // against p_topic at p_pos.
+    constexpr bool consume(const radix_edge & p_edge,
+                           size_type p_skip,
+                           std::string_view p_topic,
+                           size_type & p_pos,
+                           node_idx & p_node,
+                           uint32_t & p_path) noexcept
+    {
+      const auto edge_label{label(p_edge).substr(p_skip)};
+      const auto remaining = p_topic.size() - p_pos;
+
+      if(remaining < edge_label.size())
+      {
+        // Topic 'abc' ends inside edge 'abc/', try to match 'abc/#'.
+        if(((remaining + 1) == edge_label.size())
+           && (mqtt_detail::TopicLevelSeparatorChar == edge_label.back())
+           && (0 == std::memcmp(edge_label.data(), p_topic.data() + p_pos, remaining)))
+        {
+          add_sub_state(mqtt_detail::TopicMultiLevelWildcardChar, std::string_view{}, search_type::MultiLevel,
+                        p_edge.target, p_path + p_edge.path_offset);
+        }
+        return false;
+      }
+
+      if(0 != std::memcmp(edge_label.data(), p_topic.data() + p_pos, edge_label.size()))
+      {
+        return false;
+      }
+
+      p_pos += edge_label.size();
+      p_node = p_edge.target;
+      p_path += p_edge.path_offset;
+
+      if(label(p_edge).back() == mqtt_detail::TopicLevelSeparatorChar)
+      {
+        // Topic is 'abc/cde/', try to match 'abc/cde/+' & 'abc/cde/#'
+        add_wildcards(p_node, p_path, p_topic.substr(p_pos));
+      }
+
+      return true;
+    }
+
+    constexpr void literal_find(std::string_view p_topic,
+                                node_idx p_state,
+                                uint32_t p_path) noexcept
+    {
+      size_type pos = 0;
+
+      while(pos < p_topic.size())
+      {
+        const auto * edge = find_edge(p_state, p_topic[pos]);
+
+        if((nullptr == edge)
+           || !consume(*edge, 0, p_topic, pos, p_state, p_path))
+        {
+          return;
+        }
+      }
+
+      at_end(p_state, p_path);
+    }
+
+    constexpr void single_level_find(std::string_view p_topic,
+                                     node_idx p_state,
+                                     uint32_t p_path) noexcept
+    {
+      const auto pos = p_topic.find(mqtt_detail::TopicLevelSeparatorChar);
+
+      if(std::string_view::npos == pos)
+      {
+        // Topic is 'abc/+'.
+        add_payload(p_state, p_path);
+        add_parent_multi_level(p_state, p_path);
+        return;
+      }
+
+      const auto rest_topic{p_topic.substr(pos + 1)};
+      if(rest_topic.empty())
+      {
+        // Topic 'abc/cde/' matches 'abc/+'.
+        add_payload(p_state, p_path);
+      }
+
+      const auto * edge = find_edge(p_state, mqtt_detail::TopicLevelSeparatorChar);
+      if(nullptr == edge)
+      {
+        return;
+      }
+
+      if(1 == edge->label_size)
+      {
+        const auto separator = edge->target;
+        const auto separator_path = p_path + edge->path_offset;
+        if(rest_topic.empty())
+        {
+          // Topic 'abc/cde/' matches 'abc/+/' and 'abc/+//#'.
+          add_payload(separator, separator_path);
+          add_parent_multi_level(separator, separator_path);
+        }
+        else
+        {
+          // Try to match 'abc/+/cde'.
+          m_search_states.emplace_back(rest_topic, separator, separator_path, search_type::Literal);
+        }
+        // Try to match 'abc/+/+' and 'abc/+/#'.
+        add_wildcards(separator, separator_path, rest_topic);
+        return;
+      }
+
+      // The separator is inside a literal edge, so there are no
+      // wildcards to try until the end of the edge.
+      size_type rest_pos = 0;
+      node_idx state = p_state;
+      uint32_t path = p_path;
+      if(consume(*edge, 1, rest_topic, rest_pos, state, path))
+      {
+        if(rest_pos < rest_topic.size())
+        {
+          m_search_states.emplace_back(rest_topic.substr(rest_pos), state, path, search_type::Literal);
+        }
+        else
+        {
+          at_end(state, path);
+        }
+      }
+    }
+
+    constexpr void find_span(std::string_view p_topic) noexcept
+    {
+      m_search_states.emplace_back(p_topic, root_node, 0, search_type::Literal);
+      if(mqtt_detail::TopicSysChar != p_topic[0])
+      {
+        add_wildcards(root_node, 0, p_topic);
+      }
+
+      for(size_type head = 0; head < m_search_states.size(); ++head)
+      {
+        const auto [search_topic, state, path, type] = m_search_states[head];
+
+        switch(type)
+        {
+          case search_type::Literal:
+            literal_find(search_topic, state, path);
+            break;
+
+          case search_type::SingleLevel:
+            single_level_find(search_topic, state, path);
+            break;
+
+          case search_type::MultiLevel:
+            add_payload(state, path);
+            break;
+        }
+      }
+    }
+
+    huge_page_region m_region{};
+    radix_tables m_tables{};
+    data_vector m_data{};
+    uint32_t m_node_count = 0;
+    uint32_t m_edge_count = 0;
+    uint32_t m_labels_size = 0;
+    uint32_t m_edges_offset = 0;
+    uint32_t m_labels_offset = 0;
+    queue m_search_states{};
+    payloads_type m_payloads{};
+};
+
+} // namespace radix_topics_detail
+
+// Character level filter trie with single child chains collapsed
+// into one multi-character edge, compared with memcmp.
+template<typename ValueType>
+class radix_topics final
+{
+  public:
+    using value_type = ValueType;
+    using automaton_type = radix_topics_detail::Query<value_type>;
+    using data_vector = typename automaton_type::data_vector;
+    using node_idx = radix_topics_detail::node_idx;
+    using RadixLayout = radix_topics_detail::RadixLayout;
+
+    radix_topics() = default;
+    radix_topics(const radix_topics &) = default;
+    radix_topics(radix_topics &&) noexcept = default;
+    ~radix_topics() = default;
+
+    radix_topics & operator=(const radix_topics &) = default;
+    radix_topics & operator=(radix_topics &&) noexcept = default;
+
+    void add(std::string_view p_filter,
+             value_type p_value)
+    {
+      if(auto & payload = m_trie[m_trie.add(p_filter)].payload;
+         radix_topics_detail::no_payload == payload)
+      {
+        payload = static_cast<node_idx>(m_values.size());
+        m_values.emplace_back(std::move(p_value));
+      }
+      else
+      {
+        m_values[payload] = std::move(p_value);
+      }
+    }
+
+    // p_pages asks for the compiled tables to be placed in huge
+    // pages, see huge_page_region. Minimized merges identical
+    // subtrees, see radix_minimizer.
+    [[nodiscard]]
+    automaton_type create_automaton(HugePages p_pages = HugePages::Off,
+                                    RadixLayout p_layout = RadixLayout::Minimized) const
+    {
+      radix_topics_detail::radix_tables tables{};
+      radix_topics_detail::radix_builder builder{m_trie};
+      builder.build(tables);
+
+      if(RadixLayout::Minimized == p_layout)
+      {
+        radix_topics_detail::radix_minimizer{}.minimize(tables);
+      }
+
+      data_vector data{};
+      data.reserve(m_values.size());
+      for(const auto & value : m_values)
+      {
+        data.emplace_back(value);
+      }
+
+      return automaton_type{std::move(tables), std::move(data), p_pages};
+    }
+
+  private:
+    char_trie m_trie{};
+    std::vector<value_type> m_values{};
+};
+
+} // namespace yafiyogi::yy_mqtt
@@ -0,0 +1,567 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "yy_cpp/yy_span.h"
+#include "yy_cpp/yy_vector.h"
+
+#include "yy_mqtt_constants.h"
+#include "yy_mqtt_types.h"
+#include "yy_mqtt_util.h"
+
+namespace yafiyogi::yy_mqtt {
+namespace retained_topics_detail {
+
+using node_idx = uint32_t;
+using label_idx = uint32_t;
+
+inline constexpr node_idx no_node = std::numeric_limits<node_idx>::max();
+inline constexpr node_idx no_payload = std::numeric_limits<node_idx>::max();
+inline constexpr label_idx no_label = std::numeric_limits<label_idx>::max();
+inline constexpr node_idx root_node = 0;
+
+struct retained_edge final
+{
+    label_idx label = no_label;
+    node_idx node = no_node;
+};
+
+struct retained_node final
+{
+    std::vector<retained_edge> edges{}; // Sorted by label.
+    node_idx parent = no_node;
+    label_idx label = no_label;
+    node_idx payload = no_payload;
+};
+
+struct label_hash final
+{
+    using is_transparent = void;
+
+    [[nodiscard]]
+    std::size_t operator()(std::string_view p_label) const noexcept
+    {
+      return std::hash<std::string_view>{}(p_label);
+    }
+};
+
+// Each distinct level label is stored once and referred to by index,
+// so 'iot21' in a million topic names costs four bytes per edge.
+class label_pool final
+{
+  public:
+    label_pool() = default;
+    label_pool(const label_pool &) = delete;
+    label_pool(label_pool &&) = delete;
+    ~label_pool() = default;
+
+    label_pool & operator=(const label_pool &) = delete;
+    label_pool & operator=(label_pool &&) = delete;
+
+    [[nodiscard]]
+    label_idx find(std::string_view p_label) const noexcept
+    {
+      if(auto found = m_index.find(p_label);
+         m_index.end() != found)
+      {
+        return found->second;
+      }
+
+      return no_label;
+    }
+
+    label_idx intern(std::string_view p_label)
+    {
+      if(auto found = m_index.find(p_label);
+         m_index.end() != found)
+      {
+        return found->second;
+      }
+
+      const auto idx = static_cast<label_idx>(m_labels.size());
+      // Keys of a node based map do not move, so views of them stay valid.
+      auto [inserted, ignore] = m_index.emplace(std::string{p_label}, idx);
+      m_labels.emplace_back(inserted->first);
+      m_bytes += p_label.size();
+
+      return idx;
+    }
+
+    [[nodiscard]]
+    std::string_view operator[](label_idx p_idx) const noexcept
+    {
+      return m_labels[p_idx];
+    }
+
+    [[nodiscard]]
+    size_type size() const noexcept
+    {
+      return m_labels.size();
+    }
+
+    [[nodiscard]]
+    size_type bytes() const noexcept
+    {
+      return m_bytes;
+    }
+
+  private:
+    std::unordered_map<std::string, label_idx, label_hash, std::equal_to<>> m_index{};
+    std::vector<std::string_view> m_labels{};
+    size_type m_bytes = 0;
+};
+
+} // namespace retained_topics_detail
+
+// Index of retained topic names answering "which names match this
+// filter". A trie of names with one edge per level, walked with the
+// filter's '+' and '#' levels.
+template<typename ValueType>
+class retained_topics final
+{
+  public:
+    using value_type = ValueType;
+    using value_ptr = value_type *;
+    using node_idx = retained_topics_detail::node_idx;
+    using label_idx = retained_topics_detail::label_idx;
+    using node_type = retained_topics_detail::retained_node;
+    using edge_type = retained_topics_detail::retained_edge;
+    using payloads_type = yy_quad::simple_vector<value_ptr>;
+    using payloads_span_type = yy_quad::span<typename payloads_type::value_type>;
+
+    retained_topics():
+      m_nodes(1)
+    {
+    }
+
+    retained_topics(const retained_topics &) = delete;
+    retained_topics(retained_topics &&) = delete;
+    ~retained_topics() = default;
+
+    retained_topics & operator=(const retained_topics &) = delete;
+    retained_topics & operator=(retained_topics &&) = delete;
+
+    // Add or replace the value retained for topic name p_topic.
+    void set(std::string_view p_topic,
+             value_type p_value)
+    {
+      topic_tokenize_view(m_levels, p_topic);
+
+      node_idx node = retained_topics_detail::root_node;
+      for(const auto & level : m_levels)
+      {
+        node = add_edge(node, m_labels.intern(level));
+      }
+
+      if(auto & payload = m_nodes[node].payload;
+         retained_topics_detail::no_payload == payload)
+      {
+        payload = new_value(std::move(p_value));
+        ++m_size;
+      }
+      else
+      {
+        m_values[payload] = std::move(p_value);
+      }
+    }
+
+    // Remove topic name p_topic. Returns false if it was not retained.
+    bool erase(std::string_view p_topic)
+    {
+      node_idx node = find_topic(p_topic);
+      if(retained_topics_detail::no_node == node)
+      {
+        return false;
+      }
+
+      auto & payload = m_nodes[node].payload;
+      if(retained_topics_detail::no_payload == payload)
+      {
+        return false;
+      }
+
+      m_values[payload] = value_type{};
+      m_free_values.emplace_back(payload);
+      payload = retained_topics_detail::no_payload;
+      --m_size;
+
+      // Prune levels no longer leading to a retained topic.
+      while((retained_topics_detail::root_node != node)
+            && m_nodes[node].edges.empty()
+            && (retained_topics_detail::no_payload == m_nodes[node].payload))
+      {
+        const node_idx parent = m_nodes[node].parent;
+        auto & edges = m_nodes[parent].edges;
+        edges.erase(lower_bound(edges, m_nodes[node].label));
+
+        m_nodes[node] = node_type{};
+        m_free_nodes.emplace_back(node);
+        node = parent;
+      }
+
+      return true;
+    }
+
+    // Release spare capacity, e.g. after loading a large set of
+    // retained topics.
+    void shrink_to_fit()
+    {
+      for(auto & node : m_nodes)
+      {
+        node.edges.shrink_to_fit();
+      }
+      m_nodes.shrink_to_fit();
+      m_values.shrink_to_fit();
+    }
+
+    // Find the values of all retained topic names matching p_filter.
+    // The span returned is valid until the next call to find(), set()
+    // or erase().
+    [[nodiscard]]
+    payloads_span_type find(std::string_view p_filter)
+    {
+      if(p_filter.empty())
+      {
+        m_payloads.clear(yy_quad::ClearAction::Keep);
+        return yy_quad::make_span(m_payloads);
+      }
+
+      topic_tokenize_view(m_levels, p_filter);
+
+      return find_levels(m_levels);
+    }
+
+    // As find(), using the levels already split by the Topic.
+    [[nodiscard]]
+    payloads_span_type find(const Topic & p_filter)
+    {
+      return find_levels(p_filter.levels());
+    }
+
+    // Number of retained topic names.
+    [[nodiscard]]
+    size_type size() const noexcept
+    {
+      return m_size;
+    }
+
+    [[nodiscard]]
+    bool empty() const noexcept
+    {
+      return 0 == m_size;
+    }
+
+    [[nodiscard]]
+    size_type node_count() const noexcept
+    {
+      return m_nodes.size() - m_free_nodes.size();
+    }
+
+    [[nodiscard]]
+    size_type label_count() const noexcept
+    {
+      return m_labels.size();
+    }
+
+    // Approximate bytes used by nodes, edges and labels.
+    [[nodiscard]]
+    size_type memory_size() const noexcept
+    {
+      size_type bytes = (m_nodes.capacity() * sizeof(node_type))
+        + (m_values.capacity() * sizeof(value_type))
+        + m_labels.bytes()
+        + (m_labels.size() * (sizeof(std::string) + sizeof(std::string_view)));
+
+      for(const auto & node : m_nodes)
+      {
+        bytes += node.edges.capacity() * sizeof(edge_type);
+      }
+
+      return bytes;
+    }
+
+  private:
+    payloads_span_type find_levels(const TopicLevelsView & p_levels)
+    {
+      m_payloads.clear(yy_quad::ClearAction::Keep);
+      m_stack.clear();
+
+      if(p_levels.empty())
+      {
+        return yy_quad::make_span(m_payloads);
+      }
+
+      const size_type max_level = p_levels.size();
+
+      m_stack.emplace_back(retained_topics_detail::root_node, 0);
+
+      while(!m_stack.empty())
+      {
+        const auto [node, level_no] = m_stack.back();
+        m_stack.pop_back();
+
+        if(max_level == level_no)
+        {
+          add_payload(node);
+          continue;
+        }
+
+        const auto level = p_levels[level_no];
+
+        if(mqtt_detail::TopicMultiLevelWildcard == level)
+        {
+          // mqtt-v5.0-os 4.7.1.2 Multi-level wildcard
+          // 'sport/tennis/player1/#' matches 'sport/tennis/player1'.
+          add_payload(node);
+          add_subtree(node);
+        }
+        else if(mqtt_detail::TopicSingleLevelWildcard == level)
+        {
+          const bool last = (max_level == (level_no + 1));
+
+          for(const auto & edge : m_nodes[node].edges)
+          {
+            if(!skip_sys(node, edge))
+            {
+              m_stack.emplace_back(edge.node, level_no + 1);
+              if(last)
+              {
+                // As the filter engines do, a final '+' also matches
+                // a topic with a trailing separator: 'a/+' matches 'a/b/'.
+                add_empty_level_payload(edge.node);
+              }
+            }
+          }
+        }
+        else if(const auto label = m_labels.find(level);
+                retained_topics_detail::no_label != label)
+        {
+          if(const auto child = find_edge(node, label);
+             retained_topics_detail::no_node != child)
+          {
+            m_stack.emplace_back(child, level_no + 1);
+          }
+        }
+      }
+
+      return yy_quad::make_span(m_payloads);
+    }
+
+    using stack_entry = std::tuple<node_idx, size_type>;
+
+    [[nodiscard]]
+    static std::vector<edge_type>::iterator lower_bound(std::vector<edge_type> & p_edges,
+                                                        label_idx p_label) noexcept
+    {
+      return std::lower_bound(p_edges.begin(), p_edges.end(), p_label,
+                              [](const edge_type & edge, label_idx label) {
+                                return edge.label < label;
+                              });
+    }
+
+    [[nodiscard]]
+    node_idx find_edge(node_idx p_node,
+                       label_idx p_label) noexcept
+    {
+      auto & edges = m_nodes[p_node].edges;
+
+      if(auto edge = lower_bound(edges, p_label);
+         (edges.end() != edge) && (p_label == edge->label))
+      {
+        return edge->node;
+      }
+
+      return retained_topics_detail::no_node;
+    }
+
+    [[nodiscard]]
+    node_idx find_topic(std::string_view p_topic)
+    {
+      topic_tokenize_view(m_levels, p_topic);
+
+      node_idx node = retained_topics_detail::root_node;
+      for(const auto & level : m_levels)
+      {
+        const auto label = m_labels.find(level);
+        if(retained_topics_detail::no_label == label)
+        {
+          return retained_topics_detail::no_node;
+        }
+
+        node = find_edge(node, label);
+        if(retained_topics_detail::no_node == node)
+        {
+          return retained_topics_detail::no_node;
+        }
+      }
+
+      return node;
+    }
+
+    node_idx add_edge(node_idx p_node,
+                      label_idx p_label)
+    {
+      auto edge = lower_bound(m_nodes[p_node].edges, p_label);
+      if((m_nodes[p_node].edges.end() != edge) && (p_label == edge->label))
+      {
+        return edge->node;
+      }
+
+      const auto offset = edge - m_nodes[p_node].edges.begin();
+      // new_node() may reallocate m_nodes.
+      const node_idx child = new_node(p_node, p_label);
+      auto & edges = m_nodes[p_node].edges;
+      edges.insert(edges.begin() + offset, edge_type{p_label, child});
+
+      return child;
+    }
+
+    node_idx new_node(node_idx p_parent,
+                      label_idx p_label)
+    {
+      node_idx idx = 0;
+      if(m_free_nodes.empty())
+      {
+        idx = static_cast<node_idx>(m_nodes.size());
+        m_nodes.emplace_back();
+      }
+      else
+      {
+        idx = m_free_nodes.back();
+        m_free_nodes.pop_back();
+      }
+
+      m_nodes[idx].parent = p_parent;
+      m_nodes[idx].label = p_label;
+
+      return idx;
+    }
+
+    node_idx new_value(value_type && p_value)
+    {
+      if(m_free_values.empty())
+      {
+        const auto idx = static_cast<node_idx>(m_values.size());
+        m_values.emplace_back(std::move(p_value));
+        return idx;
+      }
+
+      const auto idx = m_free_values.back();
+      m_free_values.pop_back();
+      m_values[idx] = std::move(p_value);
+
+      return idx;
+    }
+
+    // mqtt-v5.0-os 4.7.2 Topics beginning with $
+    // A filter starting with a wildcard does not match a topic name
+    // starting with '$'.
+    [[nodiscard]]
+    bool skip_sys(node_idx p_node,
+                  const edge_type & p_edge) const noexcept
+    {
+      if(retained_topics_detail::root_node != p_node)
+      {
+        return false;
+      }
+
+      const auto label = m_labels[p_edge.label];
+      return !label.empty() && (mqtt_detail::TopicSysChar == label[0]);
+    }
+
+    void add_payload(node_idx p_node)
+    {
+      if(const auto payload = m_nodes[p_node].payload;
+         retained_topics_detail::no_payload != payload)
+      {
+        m_payloads.emplace_back(&m_values[payload]);
+      }
+    }
+
+    void add_empty_level_payload(node_idx p_node)
+    {
+      if(const auto label = m_labels.find(std::string_view{});
+         retained_topics_detail::no_label != label)
+      {
+        if(const auto child = find_edge(p_node, label);
+           retained_topics_detail::no_node != child)
+        {
+          add_payload(child);
+        }
+      }
+    }
+
+    // Every topic name below p_node.
+    void add_subtree(node_idx p_node)
+    {
+      for(const auto & edge : m_nodes[p_node].edges)
+      {
+        if(!skip_sys(p_node, edge))
+        {
+          m_subtree.emplace_back(edge.node);
+        }
+      }
+
+      while(!m_subtree.empty())
+      {
+        const node_idx node = m_subtree.back();
+        m_subtree.pop_back();
+
+        add_payload(node);
+        for(const auto & edge : m_nodes[node].edges)
+        {
+          m_subtree.emplace_back(edge.node);
+        }
+      }
+    }
+
+    std::vector<node_type> m_nodes;
+    std::vector<value_type> m_values{};
+    std::vector<node_idx> m_free_nodes{};
+    std::vector<node_idx> m_free_values{};
+    retained_topics_detail::label_pool m_labels{};
+    size_type m_size = 0;
+
+    // Scratch space reused between calls.
+    TopicLevelsView m_levels{};
+    std::vector<stack_entry> m_stack{};
+    std::vector<node_idx> m_subtree{};
+    payloads_type m_payloads{};
+};
+
+} // namespace yafiyogi::yy_mqtt
@@ -0,0 +1,451 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <algorithm>
+#include <bit>
+#include <tuple>
+#include <utility>
+
+#include "yy_mqtt_roaring.h"
+
+namespace yafiyogi::yy_mqtt {
+namespace {
+
+using roaring_detail::array_max;
+using roaring_detail::dense_words;
+using roaring_detail::low_bits;
+using roaring_detail::low_mask;
+
+// Binary search the larger array when it is this many times the smaller.
+constexpr uint32_t gallop_ratio = 32;
+
+[[nodiscard]]
+uint32_t popcount(const uint64_t * p_words) noexcept
+{
+  uint32_t count = 0;
+  for(size_type word = 0; word < dense_words; ++word)
+  {
+    count += static_cast<uint32_t>(std::popcount(p_words[word]));
+  }
+
+  return count;
+}
+
+[[nodiscard]]
+bool test_bit(const uint64_t * p_words,
+              uint16_t p_low) noexcept
+{
+  return 0 != (p_words[p_low / 64] & (uint64_t{1} << (p_low % 64)));
+}
+
+void intersect_arrays(const uint16_t * p_lhs,
+                      uint32_t p_lhs_size,
+                      const uint16_t * p_rhs,
+                      uint32_t p_rhs_size,
+                      yy_quad::simple_vector<uint16_t> & p_values)
+{
+  if(p_lhs_size > p_rhs_size)
+  {
+    std::swap(p_lhs, p_rhs);
+    std::swap(p_lhs_size, p_rhs_size);
+  }
+
+  const uint16_t * lhs = p_lhs;
+  const uint16_t * lhs_end = p_lhs + p_lhs_size;
+  const uint16_t * rhs = p_rhs;
+  const uint16_t * rhs_end = p_rhs + p_rhs_size;
+
+  if((p_lhs_size * gallop_ratio) < p_rhs_size)
+  {
+    // A few ids against many, e.g. a device's filters against '+'.
+    for(; (lhs != lhs_end) && (rhs != rhs_end); ++lhs)
+    {
+      rhs = std::lower_bound(rhs, rhs_end, *lhs);
+      if((rhs != rhs_end) && (*rhs == *lhs))
+      {
+        p_values.emplace_back(*lhs);
+      }
+    }
+    return;
+  }
+
+  while((lhs != lhs_end) && (rhs != rhs_end))
+  {
+    if(*lhs < *rhs)
+    {
+      ++lhs;
+    }
+    else if(*rhs < *lhs)
+    {
+      ++rhs;
+    }
+    else
+    {
+      p_values.emplace_back(*lhs);
+      ++lhs;
+      ++rhs;
+    }
+  }
+}
+
+} // namespace
+
+void roaring_bitmap::clear() noexcept
+{
+  m_containers.clear(yy_quad::ClearAction::Keep);
+  m_values.clear(yy_quad::ClearAction::Keep);
+  m_words.clear(yy_quad::ClearAction::Keep);
+}
+
+void roaring_bitmap::push_back(uint32_t p_id)
+{
+  add(p_id, 0);
+}
+
+roaring_range roaring_bitmap::append(yy_quad::const_span<uint32_t> p_ids)
+{
+  const auto first = m_containers.size();
+  for(const auto id : p_ids)
+  {
+    add(id, first);
+  }
+
+  return roaring_range{static_cast<uint32_t>(first), static_cast<uint32_t>(m_containers.size())};
+}
+
+void roaring_bitmap::add(uint32_t p_id,
+                         size_type p_first)
+{
+  const auto key = static_cast<uint16_t>(p_id >> low_bits);
+  const auto low = static_cast<uint16_t>(p_id & low_mask);
+
+  if((m_containers.size() == p_first) || (key != m_containers.back().key))
+  {
+    add_container(key, false);
+  }
+
+  auto & last = m_containers.back();
+  ++last.cardinality;
+
+  if(last.dense)
+  {
+    m_words[last.offset + (low / 64)] |= uint64_t{1} << (low % 64);
+  }
+  else
+  {
+    m_values.emplace_back(low);
+    if(last.cardinality > array_max)
+    {
+      densify();
+    }
+  }
+}
+
+roaring_detail::container & roaring_bitmap::add_container(uint16_t p_key,
+                                                          bool p_dense)
+{
+  container added{};
+  added.key = p_key;
+  added.dense = p_dense;
+
+  if(p_dense)
+  {
+    added.offset = static_cast<uint32_t>(m_words.size());
+    m_words.resize(m_words.size() + dense_words);
+    std::fill(m_words.begin() + added.offset, m_words.end(), uint64_t{0});
+  }
+  else
+  {
+    added.offset = static_cast<uint32_t>(m_values.size());
+  }
+
+  m_containers.emplace_back(added);
+
+  return m_containers.back();
+}
+
+// Drops the last container if empty, and stores it in its smaller form.
+void roaring_bitmap::finish_container()
+{
+  auto & last = m_containers.back();
+
+  if(0 == last.cardinality)
+  {
+    if(last.dense)
+    {
+      m_words.resize(last.offset);
+    }
+    m_containers.pop_back();
+  }
+  else if(last.dense && (last.cardinality <= array_max))
+  {
+    sparsify();
+  }
+  else if(!last.dense && (last.cardinality > array_max))
+  {
+    densify();
+  }
+}
+
+// The last container's values are the last in m_values.
+void roaring_bitmap::densify()
+{
+  auto & last = m_containers.back();
+  const auto offset = static_cast<uint32_t>(m_words.size());
+
+  m_words.resize(m_words.size() + dense_words);
+  std::fill(m_words.begin() + offset, m_words.end(), uint64_t{0});
+
+  uint64_t * dense = m_words.data() + offset;
+  for(auto idx = last.offset; idx < m_values.size(); ++idx)
+  {
+    const auto low = m_values[idx];
+    dense[low / 64] |= uint64_t{1} << (low % 64);
+  }
+
+  m_values.resize(last.offset);
+  last.offset = offset;
+  last.dense = true;
+}
+
+// The last container's words are the last in m_words.
+void roaring_bitmap::sparsify()
+{
+  auto & last = m_containers.back();
+  const auto offset = static_cast<uint32_t>(m_values.size());
+
+  const uint64_t * dense = m_words.data() + last.offset;
+  for(size_type word = 0; word < dense_words; ++word)
+  {
+    for(uint64_t bits = dense[word]; 0 != bits; bits &= bits - 1)
+    {
+      m_values.emplace_back(static_cast<uint16_t>((word * 64) + static_cast<size_type>(std::countr_zero(bits))));
+    }
+  }
+
+  m_words.resize(last.offset);
+  last.offset = offset;
+  last.dense = false;
+}
+
+void roaring_bitmap::copy_container(const roaring_view & p_view,
+                                    const container & p_container)
+{
+  auto & copy = add_container(p_container.key, p_container.dense);
+  copy.cardinality = p_container.cardinality;
+
+  if(p_container.dense)
+  {
+    std::copy_n(p_view.words + p_container.offset, dense_words, m_words.data() + copy.offset);
+  }
+  else
+  {
+    const uint16_t * values = p_view.values + p_container.offset;
+    for(uint32_t idx = 0; idx < p_container.cardinality; ++idx)
+    {
+      m_values.emplace_back(values[idx]);
+    }
+  }
+}
+
+void roaring_bitmap::assign_and(roaring_view p_lhs,
+                                roaring_view p_rhs)
+{
+  clear();
+
+  auto lhs = p_lhs.containers.begin();
+  auto rhs = p_rhs.containers.begin();
+  while((p_lhs.containers.end() != lhs) && (p_rhs.containers.end() != rhs))
+  {
+    if(lhs->key < rhs->key)
+    {
+      ++lhs;
+    }
+    else if(rhs->key < lhs->key)
+    {
+      ++rhs;
+    }
+    else
+    {
+      and_containers(p_lhs, *lhs, p_rhs, *rhs);
+      finish_container();
+      ++lhs;
+      ++rhs;
+    }
+  }
+}
+
+void roaring_bitmap::assign_or(roaring_view p_lhs,
+                               roaring_view p_rhs)
+{
+  clear();
+
+  auto lhs = p_lhs.containers.begin();
+  auto rhs = p_rhs.containers.begin();
+  while((p_lhs.containers.end() != lhs) || (p_rhs.containers.end() != rhs))
+  {
+    if((p_rhs.containers.end() == rhs)
+       || ((p_lhs.containers.end() != lhs) && (lhs->key < rhs->key)))
+    {
+      copy_container(p_lhs, *lhs);
+      ++lhs;
+    }
+    else if((p_lhs.containers.end() == lhs) || (rhs->key < lhs->key))
+    {
+      copy_container(p_rhs, *rhs);
+      ++rhs;
+    }
+    else
+    {
+      or_containers(p_lhs, *lhs, p_rhs, *rhs);
+      finish_container();
+      ++lhs;
+      ++rhs;
+    }
+  }
+}
+
+void roaring_bitmap::and_containers(const roaring_view & p_lhs,
+                                    const container & p_lhs_container,
+                                    const roaring_view & p_rhs,
+                                    const container & p_rhs_container)
+{
+  if(p_lhs_container.dense && p_rhs_container.dense)
+  {
+    auto & result = add_container(p_lhs_container.key, true);
+    const uint64_t * lhs = p_lhs.words + p_lhs_container.offset;
+    const uint64_t * rhs = p_rhs.words + p_rhs_container.offset;
+    uint64_t * words = m_words.data() + result.offset;
+
+    // Plain loops over whole bitsets, which the compiler vectorizes.
+    for(size_type word = 0; word < dense_words; ++word)
+    {
+      words[word] = lhs[word] & rhs[word];
+    }
+    result.cardinality = popcount(words);
+    return;
+  }
+
+  auto & result = add_container(p_lhs_container.key, false);
+
+  if(p_lhs_container.dense || p_rhs_container.dense)
+  {
+    const auto & [sparse_view, sparse, dense_view, dense] = p_lhs_container.dense
+      ? std::tie(p_rhs, p_rhs_container, p_lhs, p_lhs_container)
+      : std::tie(p_lhs, p_lhs_container, p_rhs, p_rhs_container);
+
+    const uint16_t * values = sparse_view.values + sparse.offset;
+    const uint64_t * words = dense_view.words + dense.offset;
+    for(uint32_t idx = 0; idx < sparse.cardinality; ++idx)
+    {
+      if(test_bit(words, values[idx]))
+      {
+        m_values.emplace_back(values[idx]);
+      }
+    }
+  }
+  else
+  {
+    intersect_arrays(p_lhs.values + p_lhs_container.offset,
+                     p_lhs_container.cardinality,
+                     p_rhs.values + p_rhs_container.offset,
+                     p_rhs_container.cardinality,
+                     m_values);
+  }
+
+  m_containers.back().cardinality = static_cast<uint32_t>(m_values.size() - result.offset);
+}
+
+void roaring_bitmap::or_containers(const roaring_view & p_lhs,
+                                   const container & p_lhs_container,
+                                   const roaring_view & p_rhs,
+                                   const container & p_rhs_container)
+{
+  if(p_lhs_container.dense || p_rhs_container.dense)
+  {
+    const auto & [other_view, other, dense_view, dense] = p_lhs_container.dense
+      ? std::tie(p_rhs, p_rhs_container, p_lhs, p_lhs_container)
+      : std::tie(p_lhs, p_lhs_container, p_rhs, p_rhs_container);
+
+    auto & result = add_container(dense.key, true);
+    uint64_t * words = m_words.data() + result.offset;
+    std::copy_n(dense_view.words + dense.offset, dense_words, words);
+
+    if(other.dense)
+    {
+      const uint64_t * other_words = other_view.words + other.offset;
+      for(size_type word = 0; word < dense_words; ++word)
+      {
+        words[word] |= other_words[word];
+      }
+    }
+    else
+    {
+      const uint16_t * values = other_view.values + other.offset;
+      for(uint32_t idx = 0; idx < other.cardinality; ++idx)
+      {
+        words[values[idx] / 64] |= uint64_t{1} << (values[idx] % 64);
+      }
+    }
+    result.cardinality = popcount(words);
+    return;
+  }
+
+  auto & result = add_container(p_lhs_container.key, false);
+  const uint16_t * lhs = p_lhs.values + p_lhs_container.offset;
+  const uint16_t * lhs_end = lhs + p_lhs_container.cardinality;
+  const uint16_t * rhs = p_rhs.values + p_rhs_container.offset;
+  const uint16_t * rhs_end = rhs + p_rhs_container.cardinality;
+
+  while((lhs != lhs_end) || (rhs != rhs_end))
+  {
+    if((rhs == rhs_end) || ((lhs != lhs_end) && (*lhs < *rhs)))
+    {
+      m_values.emplace_back(*lhs++);
+    }
+    else if((lhs == lhs_end) || (*rhs < *lhs))
+    {
+      m_values.emplace_back(*rhs++);
+    }
+    else
+    {
+      m_values.emplace_back(*lhs);
+      ++lhs;
+      ++rhs;
+    }
+  }
+
+  m_containers.back().cardinality = static_cast<uint32_t>(m_values.size() - result.offset);
+}
+
+size_type roaring_bitmap::memory_size() const noexcept
+{
+  return (m_containers.size() * sizeof(container))
+    + (m_values.size() * sizeof(uint16_t))
+    + (m_words.size() * sizeof(uint64_t));
+}
+
+} // namespace yafiyogi::yy_mqtt
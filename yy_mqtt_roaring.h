@@ -0,0 +1,202 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include <bit>
+
+#include "yy_cpp/yy_span.h"
+#include "yy_cpp/yy_vector.h"
+
+#include "yy_mqtt_types.h"
+
+namespace yafiyogi::yy_mqtt {
+namespace roaring_detail {
+
+inline constexpr uint32_t low_bits = 16;
+inline constexpr uint32_t low_mask = (uint32_t{1} << low_bits) - 1;
+inline constexpr size_type dense_words = (size_type{1} << low_bits) / 64;
+
+// Above this an array of uint16_t takes more room than a bitset.
+inline constexpr uint32_t array_max = 4096;
+
+struct container final
+{
+    uint32_t offset = 0; // First value, or first word if dense.
+    uint32_t cardinality = 0;
+    uint16_t key = 0; // High 16 bits of the ids held.
+    bool dense = false;
+};
+
+} // namespace roaring_detail
+
+// Containers [begin, end) of a roaring_bitmap holding several bitmaps.
+struct roaring_range final
+{
+    uint32_t begin = 0;
+    uint32_t end = 0;
+};
+
+// Read only view of a bitmap. Invalidated when its roaring_bitmap grows.
+struct roaring_view final
+{
+    yy_quad::const_span<roaring_detail::container> containers{};
+    const uint16_t * values = nullptr;
+    const uint64_t * words = nullptr;
+
+    [[nodiscard]]
+    bool empty() const noexcept
+    {
+      return containers.empty();
+    }
+
+    [[nodiscard]]
+    size_type cardinality() const noexcept
+    {
+      size_type count = 0;
+      for(const auto & container : containers)
+      {
+        count += container.cardinality;
+      }
+
+      return count;
+    }
+
+    // Calls p_fn with each id in ascending order.
+    template<typename Fn>
+    void for_each(Fn && p_fn) const
+    {
+      for(const auto & container : containers)
+      {
+        const uint32_t high = uint32_t{container.key} << roaring_detail::low_bits;
+
+        if(container.dense)
+        {
+          const uint64_t * dense = words + container.offset;
+          for(size_type word = 0; word < roaring_detail::dense_words; ++word)
+          {
+            for(uint64_t bits = dense[word]; 0 != bits; bits &= bits - 1)
+            {
+              p_fn(high | static_cast<uint32_t>((word * 64) + static_cast<size_type>(std::countr_zero(bits))));
+            }
+          }
+        }
+        else
+        {
+          const uint16_t * sparse = values + container.offset;
+          for(uint32_t idx = 0; idx < container.cardinality; ++idx)
+          {
+            p_fn(high | sparse[idx]);
+          }
+        }
+      }
+    }
+};
+
+// Compressed bitmap of 32 bit ids after Roaring. Ids are split into
+// containers by their high 16 bits; a container holds its low bits as
+// a sorted array while it has at most 4096 of them, and as a 64k bit
+// bitset after that. A roaring_bitmap may hold a pool of bitmaps,
+// each a range of containers, sharing the value and word storage.
+class roaring_bitmap final
+{
+  public:
+    using container = roaring_detail::container;
+
+    roaring_bitmap() noexcept = default;
+    roaring_bitmap(const roaring_bitmap &) = delete;
+    roaring_bitmap(roaring_bitmap &&) noexcept = default;
+    ~roaring_bitmap() noexcept = default;
+
+    roaring_bitmap & operator=(const roaring_bitmap &) = delete;
+    roaring_bitmap & operator=(roaring_bitmap &&) noexcept = default;
+
+    void clear() noexcept;
+
+    // p_id must be greater than every id already in the last bitmap.
+    void push_back(uint32_t p_id);
+
+    // Adds a bitmap of the ascending p_ids to the pool.
+    [[nodiscard]]
+    roaring_range append(yy_quad::const_span<uint32_t> p_ids);
+
+    // Replaces the contents with p_lhs & p_rhs or p_lhs | p_rhs,
+    // neither of which may view this bitmap.
+    void assign_and(roaring_view p_lhs,
+                    roaring_view p_rhs);
+    void assign_or(roaring_view p_lhs,
+                   roaring_view p_rhs);
+
+    [[nodiscard]]
+    roaring_view view() const noexcept
+    {
+      return roaring_view{yy_quad::make_const_span(m_containers), m_values.data(), m_words.data()};
+    }
+
+    [[nodiscard]]
+    roaring_view view(roaring_range p_range) const noexcept
+    {
+      return roaring_view{yy_quad::const_span<container>{m_containers.data() + p_range.begin, m_containers.data() + p_range.end},
+                          m_values.data(),
+                          m_words.data()};
+    }
+
+    [[nodiscard]]
+    bool empty() const noexcept
+    {
+      return m_containers.empty();
+    }
+
+    [[nodiscard]]
+    size_type memory_size() const noexcept;
+
+  private:
+    void add(uint32_t p_id,
+             size_type p_first);
+    container & add_container(uint16_t p_key,
+                              bool p_dense);
+    void finish_container();
+    void densify();
+    void sparsify();
+    void copy_container(const roaring_view & p_view,
+                        const container & p_container);
+    void and_containers(const roaring_view & p_lhs,
+                        const container & p_lhs_container,
+                        const roaring_view & p_rhs,
+                        const container & p_rhs_container);
+    void or_containers(const roaring_view & p_lhs,
+                       const container & p_lhs_container,
+                       const roaring_view & p_rhs,
+                       const container & p_rhs_container);
+
+    yy_quad::simple_vector<container> m_containers{};
+    yy_quad::simple_vector<uint16_t> m_values{};
+    yy_quad::simple_vector<uint64_t> m_words{};
+};
+
+} // namespace yafiyogi::yy_mqtt
@@ -0,0 +1,330 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include "yy_cpp/yy_span.h"
+#include "yy_cpp/yy_vector.h"
+
+#include "yy_mqtt_constants.h"
+#include "yy_mqtt_faster_topics.h"
+#include "yy_mqtt_types.h"
+#include "yy_mqtt_util.h"
+
+namespace yafiyogi::yy_mqtt {
+namespace shared_topics_detail {
+
+enum class select_type:uint8_t {RoundRobin, Hashed};
+
+// One shared subscription group: every member subscribed to
+// '$share/{share_name}/{filter}'. A match delivers to one member.
+template<typename MemberType>
+class shared_group final
+{
+  public:
+    using member_type = MemberType;
+    using members_type = std::vector<member_type>;
+
+    shared_group(std::string_view p_share_name,
+                 std::string_view p_filter,
+                 members_type p_members = members_type{}):
+      m_share_name(p_share_name),
+      m_filter(p_filter),
+      m_members(std::move(p_members))
+    {
+    }
+
+    shared_group() = delete;
+    shared_group(const shared_group &) = delete;
+    shared_group(shared_group && p_other) noexcept:
+      m_share_name(std::move(p_other.m_share_name)),
+      m_filter(std::move(p_other.m_filter)),
+      m_members(std::move(p_other.m_members)),
+      m_next(p_other.m_next.load(std::memory_order_relaxed))
+    {
+    }
+    ~shared_group() = default;
+
+    shared_group & operator=(const shared_group &) = delete;
+    shared_group & operator=(shared_group && p_other) noexcept
+    {
+      if(this != &p_other)
+      {
+        m_share_name = std::move(p_other.m_share_name);
+        m_filter = std::move(p_other.m_filter);
+        m_members = std::move(p_other.m_members);
+        m_next.store(p_other.m_next.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      }
+
+      return *this;
+    }
+
+    // Returns false if p_member is already in the group.
+    bool add(member_type p_member)
+    {
+      if(std::find(m_members.begin(), m_members.end(), p_member) != m_members.end())
+      {
+        return false;
+      }
+
+      m_members.emplace_back(std::move(p_member));
+      return true;
+    }
+
+    // Pick the member to deliver p_topic to. Round robin uses a
+    // relaxed atomic counter, hashed sends a topic to the same member
+    // each time. Both are O(1) whatever the size of the group.
+    [[nodiscard]]
+    member_type & select(std::string_view p_topic,
+                         select_type p_select) noexcept
+    {
+      const auto size = m_members.size();
+      size_type idx = 0;
+
+      if(select_type::Hashed == p_select)
+      {
+        idx = std::hash<std::string_view>{}(p_topic) % size;
+      }
+      else
+      {
+        idx = m_next.fetch_add(1, std::memory_order_relaxed) % size;
+      }
+
+      return m_members[idx];
+    }
+
+    [[nodiscard]]
+    std::string_view share_name() const noexcept
+    {
+      return m_share_name;
+    }
+
+    [[nodiscard]]
+    std::string_view filter() const noexcept
+    {
+      return m_filter;
+    }
+
+    [[nodiscard]]
+    const members_type & members() const noexcept
+    {
+      return m_members;
+    }
+
+  private:
+    std::string m_share_name;
+    std::string m_filter;
+    members_type m_members{};
+    std::atomic<size_type> m_next{0};
+};
+
+// Groups sharing a filter are stored next to each other, so the
+// filter's trie payload is a range of groups.
+struct group_range final
+{
+    uint32_t begin = 0;
+    uint32_t end = 0;
+};
+
+template<typename MemberType>
+class Query final
+{
+  public:
+    using member_type = MemberType;
+    using member_ptr = member_type *;
+    using group_type = shared_group<member_type>;
+    using groups_type = std::vector<group_type>;
+    using topics_automaton_type = typename faster_topics<group_range>::automaton_type;
+    using payloads_type = yy_quad::simple_vector<member_ptr>;
+    using payloads_span_type = yy_quad::span<typename payloads_type::value_type>;
+
+    constexpr explicit Query(topics_automaton_type && p_topics,
+                             groups_type && p_groups,
+                             select_type p_select) noexcept:
+      m_topics(std::move(p_topics)),
+      m_groups(std::move(p_groups)),
+      m_select(p_select)
+    {
+      m_payloads.reserve(3);
+    }
+
+    Query() = default;
+    Query(const Query &) = delete;
+    Query(Query &&) noexcept = default;
+    ~Query() = default;
+
+    Query & operator=(const Query &) = delete;
+    Query & operator=(Query &&) noexcept = default;
+
+    // One member from each shared group with a filter matching
+    // p_topic.
+    [[nodiscard]]
+    payloads_span_type find(std::string_view p_topic) noexcept
+    {
+      return select(m_topics.find(p_topic), p_topic);
+    }
+
+    [[nodiscard]]
+    payloads_span_type find(const Topic & p_topic) noexcept
+    {
+      return select(m_topics.find(p_topic), p_topic.view());
+    }
+
+    [[nodiscard]]
+    const groups_type & groups() const noexcept
+    {
+      return m_groups;
+    }
+
+  private:
+    template<typename Ranges>
+    payloads_span_type select(Ranges p_ranges,
+                              std::string_view p_topic) noexcept
+    {
+      m_payloads.clear(yy_quad::ClearAction::Keep);
+
+      for(const auto range : p_ranges)
+      {
+        for(auto idx = range->begin; idx < range->end; ++idx)
+        {
+          m_payloads.emplace_back(&m_groups[idx].select(p_topic, m_select));
+        }
+      }
+
+      return yy_quad::make_span(m_payloads);
+    }
+
+    topics_automaton_type m_topics{};
+    groups_type m_groups{};
+    select_type m_select = select_type::RoundRobin;
+    payloads_type m_payloads{};
+};
+
+} // namespace shared_topics_detail
+
+// Engine for MQTT 5 shared subscriptions. Each
+// '$share/{ShareName}/{filter}' group is a single trie payload holding
+// its member set, so matching a group of 1000 members costs the same
+// as matching one subscription.
+template<typename MemberType>
+class shared_topics final
+{
+  public:
+    using member_type = MemberType;
+    using value_type = member_type;
+    using select_type = shared_topics_detail::select_type;
+    using automaton_type = shared_topics_detail::Query<member_type>;
+    using group_type = typename automaton_type::group_type;
+    using groups_type = typename automaton_type::groups_type;
+
+    constexpr explicit shared_topics(select_type p_select) noexcept:
+      m_select(p_select)
+    {
+    }
+
+    constexpr shared_topics() noexcept = default;
+    shared_topics(const shared_topics &) = delete;
+    shared_topics(shared_topics &&) noexcept = default;
+    ~shared_topics() = default;
+
+    shared_topics & operator=(const shared_topics &) = delete;
+    shared_topics & operator=(shared_topics &&) noexcept = default;
+
+    // Add p_member to the group of shared subscription p_filter.
+    // Returns false if p_filter is not a valid
+    // '$share/{ShareName}/{filter}' subscription.
+    bool add(std::string_view p_filter,
+             member_type p_member)
+    {
+      SharedSubscription shared{};
+      if(!topic_parse_shared(p_filter, shared))
+      {
+        return false;
+      }
+
+      // '{ShareName}/{filter}' identifies the group.
+      const auto key{p_filter.substr(mqtt_detail::TopicSharePrefix.size())};
+      auto [group, inserted] = m_index.try_emplace(std::string{key}, m_groups.size());
+      if(inserted)
+      {
+        m_groups.emplace_back(shared.share_name, shared.filter);
+      }
+
+      std::ignore = m_groups[group->second].add(std::move(p_member));
+
+      return true;
+    }
+
+    [[nodiscard]]
+    automaton_type create_automaton() const
+    {
+      groups_type groups{};
+      groups.reserve(m_groups.size());
+      for(const auto & group : m_groups)
+      {
+        groups.emplace_back(group.share_name(), group.filter(), group.members());
+      }
+
+      std::stable_sort(groups.begin(), groups.end(),
+                       [](const group_type & lhs, const group_type & rhs) {
+                         return lhs.filter() < rhs.filter();
+                       });
+
+      faster_topics<shared_topics_detail::group_range> topics{};
+      for(size_type begin = 0; begin < groups.size();)
+      {
+        size_type end = begin + 1;
+        while((end < groups.size()) && (groups[end].filter() == groups[begin].filter()))
+        {
+          ++end;
+        }
+
+        topics.add(groups[begin].filter(),
+                   shared_topics_detail::group_range{static_cast<uint32_t>(begin), static_cast<uint32_t>(end)});
+        begin = end;
+      }
+
+      return automaton_type{topics.create_automaton(), std::move(groups), m_select};
+    }
+
+  private:
+    std::map<std::string, size_type, std::less<>> m_index{};
+    groups_type m_groups{};
+    select_type m_select = select_type::RoundRobin;
+};
+
+} // namespace yafiyogi::yy_mqtt
@@ -39,6 +39,7 @@
 #include "yy_cpp/yy_vector.h"
 
 #include "yy_mqtt_constants.h"
+#include "yy_mqtt_topic.h"
 
 namespace yafiyogi::yy_mqtt {
 namespace state_topics_detail {
@@ -92,6 +93,12 @@ class Query final
       return yy_quad::make_span(m_payloads);
     }
 
+    [[nodiscard]]
+    constexpr payloads_span_type find(const Topic & p_topic) noexcept
+    {
+      return find(p_topic.view());
+    }
+
   private:
     class state_type;
     using queue = yy_quad::vector<state_type, yy_data::ClearAction::Keep>;
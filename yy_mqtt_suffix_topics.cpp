@@ -0,0 +1,62 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include "yy_mqtt_constants.h"
+#include "yy_mqtt_suffix_topics.h"
+#include "yy_mqtt_util.h"
+
+namespace yafiyogi::yy_mqtt {
+
+SuffixPlan suffix_plan(std::string_view p_filter) noexcept
+{
+  const auto levels = topic_tokenize_view(p_filter);
+
+  size_type forward = 0;
+  while((forward < levels.size())
+        && (mqtt_detail::TopicSingleLevelWildcard != levels[forward])
+        && (mqtt_detail::TopicMultiLevelWildcard != levels[forward]))
+  {
+    ++forward;
+  }
+
+  if(levels.size() == forward)
+  {
+    return SuffixPlan::Forward;
+  }
+
+  // mqtt-v5.0 4.7.1.2 Multi-level wildcard
+  // '#' is always the last level, so a filter with '#' has no trailing literal.
+  size_type reverse = 0;
+  while((mqtt_detail::TopicSingleLevelWildcard != levels[levels.size() - reverse - 1])
+        && (mqtt_detail::TopicMultiLevelWildcard != levels[levels.size() - reverse - 1]))
+  {
+    ++reverse;
+  }
+
+  return ((0 != reverse) && (reverse >= forward)) ? SuffixPlan::Reverse : SuffixPlan::Forward;
+}
+
+} // namespace yafiyogi::yy_mqtt
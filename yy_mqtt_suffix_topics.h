@@ -0,0 +1,288 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+
+#include "yy_cpp/yy_span.h"
+#include "yy_cpp/yy_vector.h"
+
+#include "yy_mqtt_constants.h"
+#include "yy_mqtt_radix_topics.h"
+#include "yy_mqtt_topic.h"
+#include "yy_mqtt_util.h"
+
+namespace yafiyogi::yy_mqtt {
+
+enum class SuffixPlan:uint8_t {Forward, Reverse};
+
+namespace suffix_topics_detail {
+
+using entry_idx = uint32_t;
+using index_type = radix_topics<entry_idx>;
+using index_query = index_type::automaton_type;
+
+// What a reverse match must also check: reversed, '+' matches exactly
+// one level only if the level counts agree, and the '$' rule applies
+// to the original first level, which is now the last.
+struct reverse_entry final
+{
+    uint32_t levels = 0;
+    bool leading_wildcard = false;
+};
+
+// Appends the levels of p_levels last to first, separated by '/'.
+template<typename LevelsType>
+void reverse_levels(const LevelsType & p_levels,
+                    std::string & p_reversed)
+{
+  p_reversed.clear();
+
+  for(auto idx = p_levels.size(); idx > 0; --idx)
+  {
+    p_reversed.append(p_levels[idx - 1]);
+    if(idx > 1)
+    {
+      p_reversed.push_back(mqtt_detail::TopicLevelSeparatorChar);
+    }
+  }
+}
+
+template<typename ValueType>
+class Query final
+{
+  public:
+    using value_type = ValueType;
+    using value_ptr = value_type *;
+    using data_vector = yy_quad::simple_vector<value_type>;
+    using payloads_type = yy_quad::simple_vector<value_ptr>;
+    using payloads_span_type = yy_quad::span<typename payloads_type::value_type>;
+    using reverse_entries = yy_quad::simple_vector<reverse_entry>;
+
+    Query(index_query && p_forward,
+          index_query && p_reverse,
+          reverse_entries && p_entries,
+          data_vector && p_data) noexcept:
+      m_forward(std::move(p_forward)),
+      m_reverse(std::move(p_reverse)),
+      m_entries(std::move(p_entries)),
+      m_data(std::move(p_data))
+    {
+      m_payloads.reserve(3);
+    }
+
+    Query() noexcept = default;
+    Query(const Query &) = delete;
+    Query(Query &&) noexcept = default;
+    ~Query() noexcept = default;
+
+    Query & operator=(const Query &) = delete;
+    Query & operator=(Query &&) noexcept = default;
+
+    // Forward matches first, then reverse matches.
+    [[nodiscard]]
+    payloads_span_type find(std::string_view p_topic) noexcept
+    {
+      m_payloads.clear(yy_quad::ClearAction::Keep);
+
+      if(!p_topic.empty())
+      {
+        add_forward(m_forward.find(p_topic));
+
+        if(!m_entries.empty())
+        {
+          topic_tokenize_view(m_levels, p_topic);
+          reverse_levels(m_levels, m_reversed);
+          add_reverse(m_levels.size(), mqtt_detail::TopicSysChar == p_topic[0]);
+        }
+      }
+
+      return yy_quad::make_span(m_payloads);
+    }
+
+    [[nodiscard]]
+    payloads_span_type find(const Topic & p_topic) noexcept
+    {
+      m_payloads.clear(yy_quad::ClearAction::Keep);
+
+      if(!p_topic.empty())
+      {
+        add_forward(m_forward.find(p_topic.view()));
+
+        if(!m_entries.empty())
+        {
+          reverse_levels(p_topic.levels(), m_reversed);
+          add_reverse(p_topic.size(), p_topic.is_sys());
+        }
+      }
+
+      return yy_quad::make_span(m_payloads);
+    }
+
+    // Filters held by each index.
+    [[nodiscard]]
+    size_type reverse_count() const noexcept
+    {
+      return m_entries.size();
+    }
+
+    [[nodiscard]]
+    size_type forward_count() const noexcept
+    {
+      return m_data.size() - m_entries.size();
+    }
+
+  private:
+    void add_forward(index_query::payloads_span_type p_found) noexcept
+    {
+      for(const auto entry : p_found)
+      {
+        m_payloads.emplace_back(&m_data[*entry]);
+      }
+    }
+
+    void add_reverse(size_type p_levels,
+                     bool p_sys) noexcept
+    {
+      for(const auto entry : m_reverse.find(m_reversed))
+      {
+        // Reverse entries are numbered before forward ones.
+        const auto & reverse = m_entries[*entry];
+
+        if((reverse.levels == p_levels)
+           // mqtt-v5.0 4.7.2 Topics beginning with $
+           // Wildcards at the first level do not match topics beginning with '$'.
+           && !(p_sys && reverse.leading_wildcard))
+        {
+          m_payloads.emplace_back(&m_data[*entry]);
+        }
+      }
+    }
+
+    index_query m_forward{};
+    index_query m_reverse{};
+    reverse_entries m_entries{};
+    data_vector m_data{};
+    TopicLevelsView m_levels{};
+    std::string m_reversed{};
+    payloads_type m_payloads{};
+};
+
+} // namespace suffix_topics_detail
+
+// Chooses the index for p_filter. Filters are matched from the end
+// whose literal run is longer, ties going to the reverse index:
+// leading levels tend to be namespaces shared by every filter
+// ('iot21', 'zigbee2mqtt') while trailing levels name a measurement.
+// Filters containing '#' or ending in '+' have no trailing literal,
+// and filters without wildcards have nothing to skip; both go forward.
+SuffixPlan suffix_plan(std::string_view p_filter) noexcept;
+
+// Filters such as '+/+/temperature' make a forward trie follow every
+// '+' branch to the last level before failing. These are indexed by
+// their reversed levels ('temperature/+/+') and matched against the
+// reversed topic, which fails at the first level. suffix_plan() picks
+// the index per filter.
+template<typename ValueType>
+class suffix_topics final
+{
+  public:
+    using value_type = ValueType;
+    using automaton_type = suffix_topics_detail::Query<value_type>;
+    using data_vector = typename automaton_type::data_vector;
+
+    suffix_topics() = default;
+    suffix_topics(const suffix_topics &) = default;
+    suffix_topics(suffix_topics &&) noexcept = default;
+    ~suffix_topics() = default;
+
+    suffix_topics & operator=(const suffix_topics &) = default;
+    suffix_topics & operator=(suffix_topics &&) noexcept = default;
+
+    void add(std::string_view p_filter,
+             value_type p_value)
+    {
+      m_filters.insert_or_assign(std::string{p_filter}, std::move(p_value));
+    }
+
+    [[nodiscard]]
+    automaton_type create_automaton() const
+    {
+      using suffix_topics_detail::entry_idx;
+
+      suffix_topics_detail::index_type forward{};
+      suffix_topics_detail::index_type reverse{};
+      typename automaton_type::reverse_entries entries{};
+      data_vector data{};
+      TopicLevelsView levels{};
+      std::string reversed{};
+
+      // Reverse filters take the first entries, so an entry doubles as
+      // the index of its reverse_entry.
+      for(const auto plan : {SuffixPlan::Reverse, SuffixPlan::Forward})
+      {
+        for(const auto & [filter, value] : m_filters)
+        {
+          if(plan != suffix_plan(filter))
+          {
+            continue;
+          }
+
+          const auto entry = static_cast<entry_idx>(data.size());
+          data.emplace_back(value);
+
+          if(SuffixPlan::Forward == plan)
+          {
+            forward.add(filter, entry);
+          }
+          else
+          {
+            topic_tokenize_view(levels, filter);
+            suffix_topics_detail::reverse_levels(levels, reversed);
+            reverse.add(reversed, entry);
+            entries.emplace_back(static_cast<uint32_t>(levels.size()),
+                                 mqtt_detail::TopicSingleLevelWildcard == levels[0]);
+          }
+        }
+      }
+
+      return automaton_type{forward.create_automaton(),
+                            reverse.create_automaton(),
+                            std::move(entries),
+                            std::move(data)};
+    }
+
+  private:
+    std::map<std::string, value_type, std::less<>> m_filters{};
+};
+
+} // namespace yafiyogi::yy_mqtt
@@ -0,0 +1,117 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <cstdint>
+
+#include <string_view>
+
+#include "yy_mqtt_constants.h"
+#include "yy_mqtt_topic.h"
+
+namespace yafiyogi::yy_mqtt {
+
+Topic::Topic(std::string_view p_topic,
+             TopicType p_type) noexcept
+{
+  assign(p_topic, p_type);
+}
+
+TopicValidStatus Topic::assign(std::string_view p_topic,
+                               TopicType p_type) noexcept
+{
+  m_topic = p_topic;
+  m_levels.clear();
+  m_hashes.clear();
+  m_type = p_type;
+  m_status = TopicValidStatus::Valid;
+  m_wildcards = 0;
+
+  if((TopicType::Name != p_type)
+     && (TopicType::Filter != p_type))
+  {
+    m_status = TopicValidStatus::BadParam;
+    return m_status;
+  }
+
+  if(p_topic.empty())
+  {
+    return m_status;
+  }
+
+  const size_type max = p_topic.size();
+  size_type level_begin = 0;
+  hash_type hash = topic_detail::level_hash_basis;
+  uint8_t level_wildcards = 0;
+
+  for(size_type idx = 0; idx <= max; ++idx)
+  {
+    const bool end = max == idx;
+    const char ch = end ? mqtt_detail::TopicLevelSeparatorChar : p_topic[idx];
+
+    if(mqtt_detail::TopicLevelSeparatorChar != ch)
+    {
+      if(mqtt_detail::TopicSingleLevelWildcardChar == ch)
+      {
+        level_wildcards |= single_level_wildcard;
+      }
+      else if(mqtt_detail::TopicMultiLevelWildcardChar == ch)
+      {
+        level_wildcards |= multi_level_wildcard;
+      }
+
+      hash = topic_detail::level_hash_add(hash, ch);
+      continue;
+    }
+
+    const auto level{p_topic.substr(level_begin, idx - level_begin)};
+
+    // mqtt-v5.0-os 4.7.1 Topic Wildcards
+    // The wildcard characters can be used in Topic Filters, but MUST NOT
+    // be used within a Topic Name. A wildcard occupies a whole level and
+    // '#' must be the last level.
+    if(0 != level_wildcards)
+    {
+      if((TopicType::Name == p_type)
+         || (1 != level.size())
+         || ((multi_level_wildcard == level_wildcards) && !end))
+      {
+        m_status = TopicValidStatus::Invalid;
+      }
+      m_wildcards |= level_wildcards;
+    }
+
+    m_levels.emplace_back(level);
+    m_hashes.emplace_back(hash);
+
+    level_begin = idx + 1;
+    hash = topic_detail::level_hash_basis;
+    level_wildcards = 0;
+  }
+
+  return m_status;
+}
+
+} // namespace yafiyogi::yy_mqtt
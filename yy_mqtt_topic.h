@@ -0,0 +1,191 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include <string_view>
+
+#include "yy_cpp/yy_vector.h"
+
+#include "yy_mqtt_constants.h"
+#include "yy_mqtt_types.h"
+
+namespace yafiyogi::yy_mqtt {
+
+namespace topic_detail {
+
+inline constexpr uint64_t level_hash_basis = 14695981039346656037ULL;
+inline constexpr uint64_t level_hash_prime = 1099511628211ULL;
+
+[[nodiscard]]
+constexpr uint64_t level_hash_add(uint64_t p_hash,
+                                  char p_ch) noexcept
+{
+  return (p_hash ^ static_cast<uint8_t>(p_ch)) * level_hash_prime;
+}
+
+} // namespace topic_detail
+
+// FNV-1a over one topic level, as stored by Topic::level_hash().
+[[nodiscard]]
+constexpr uint64_t topic_level_hash(std::string_view p_level) noexcept
+{
+  uint64_t hash = topic_detail::level_hash_basis;
+
+  for(const auto ch : p_level)
+  {
+    hash = topic_detail::level_hash_add(hash, ch);
+  }
+
+  return hash;
+}
+
+// A topic name or filter validated and split into levels in a single
+// pass over its bytes. Holds a view of the original string, a view and
+// hash per level and a summary of the wildcards used, so the same
+// message can be validated, matched and looked up without re-scanning.
+// The string viewed must outlive the Topic.
+class Topic final
+{
+  public:
+    using hash_type = uint64_t;
+    using hashes_type = yy_quad::simple_vector<hash_type, yy_quad::ClearAction::Keep>;
+
+    Topic() noexcept = default;
+    explicit Topic(std::string_view p_topic,
+                   TopicType p_type = TopicType::Name) noexcept;
+    Topic(const Topic &) = default;
+    Topic(Topic &&) noexcept = default;
+    ~Topic() = default;
+
+    Topic & operator=(const Topic &) = default;
+    Topic & operator=(Topic &&) noexcept = default;
+
+    // Re-parses, keeping the level buffers from the previous topic.
+    TopicValidStatus assign(std::string_view p_topic,
+                            TopicType p_type = TopicType::Name) noexcept;
+
+    [[nodiscard]]
+    constexpr std::string_view view() const noexcept
+    {
+      return m_topic;
+    }
+
+    [[nodiscard]]
+    const TopicLevelsView & levels() const noexcept
+    {
+      return m_levels;
+    }
+
+    [[nodiscard]]
+    size_type size() const noexcept
+    {
+      return m_levels.size();
+    }
+
+    [[nodiscard]]
+    bool empty() const noexcept
+    {
+      return m_levels.empty();
+    }
+
+    [[nodiscard]]
+    std::string_view level(size_type p_idx) const noexcept
+    {
+      return m_levels[p_idx];
+    }
+
+    // Offset of level p_idx from the start of view().
+    [[nodiscard]]
+    size_type level_offset(size_type p_idx) const noexcept
+    {
+      return static_cast<size_type>(m_levels[p_idx].data() - m_topic.data());
+    }
+
+    [[nodiscard]]
+    hash_type level_hash(size_type p_idx) const noexcept
+    {
+      return m_hashes[p_idx];
+    }
+
+    [[nodiscard]]
+    constexpr TopicType type() const noexcept
+    {
+      return m_type;
+    }
+
+    [[nodiscard]]
+    constexpr TopicValidStatus status() const noexcept
+    {
+      return m_status;
+    }
+
+    [[nodiscard]]
+    constexpr bool valid() const noexcept
+    {
+      return TopicValidStatus::Valid == m_status;
+    }
+
+    [[nodiscard]]
+    constexpr bool has_single_level_wildcard() const noexcept
+    {
+      return 0 != (m_wildcards & single_level_wildcard);
+    }
+
+    [[nodiscard]]
+    constexpr bool has_multi_level_wildcard() const noexcept
+    {
+      return 0 != (m_wildcards & multi_level_wildcard);
+    }
+
+    [[nodiscard]]
+    constexpr bool has_wildcards() const noexcept
+    {
+      return 0 != m_wildcards;
+    }
+
+    // mqtt-v5.0-os 4.7.2 Topics beginning with $
+    [[nodiscard]]
+    constexpr bool is_sys() const noexcept
+    {
+      return !m_topic.empty() && (mqtt_detail::TopicSysChar == m_topic[0]);
+    }
+
+  private:
+    static constexpr uint8_t single_level_wildcard = 0x01;
+    static constexpr uint8_t multi_level_wildcard = 0x02;
+
+    std::string_view m_topic{};
+    TopicLevelsView m_levels{};
+    hashes_type m_hashes{};
+    TopicType m_type = TopicType::Name;
+    TopicValidStatus m_status = TopicValidStatus::Valid;
+    uint8_t m_wildcards = 0;
+};
+
+} // namespace yafiyogi::yy_mqtt
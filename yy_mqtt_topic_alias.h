@@ -0,0 +1,194 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "yy_cpp/yy_span.h"
+#include "yy_cpp/yy_vector.h"
+
+#include "yy_mqtt_types.h"
+
+namespace yafiyogi::yy_mqtt {
+
+using topic_alias_type = uint16_t;
+using automaton_generation_type = uint32_t;
+
+// Per connection MQTT 5 topic alias table. Each alias keeps its topic
+// and the payloads the automaton matched for it, so a PUBLISH carrying
+// only an alias is answered without tokenizing or matching. Cached
+// payloads are tied to the automaton generation they were matched
+// with, and are matched again after the automaton is rebuilt.
+template<typename AutomatonType>
+class topic_alias_table final
+{
+  public:
+    using automaton_type = AutomatonType;
+    using value_type = typename automaton_type::value_type;
+    using value_ptr = value_type *;
+    using payloads_type = yy_quad::simple_vector<value_ptr>;
+    using payloads_span_type = yy_quad::span<typename payloads_type::value_type>;
+
+    // mqtt-v5.0-os 3.1.2.11.5 Topic Alias Maximum
+    // Entries are added as aliases are first set, so an unused large
+    // maximum costs nothing.
+    explicit topic_alias_table(topic_alias_type p_alias_maximum) noexcept:
+      m_alias_maximum(p_alias_maximum)
+    {
+    }
+
+    topic_alias_table() = delete;
+    topic_alias_table(const topic_alias_table &) = delete;
+    topic_alias_table(topic_alias_table &&) noexcept = default;
+    ~topic_alias_table() = default;
+
+    topic_alias_table & operator=(const topic_alias_table &) = delete;
+    topic_alias_table & operator=(topic_alias_table &&) noexcept = default;
+
+    // Payloads for a PUBLISH with topic name p_topic and alias
+    // p_alias. An empty p_topic uses the topic already set for the
+    // alias, otherwise the alias is set to p_topic.
+    // p_generation must change whenever p_automaton is rebuilt.
+    //
+    // mqtt-v5.0-os 3.3.2.3.4 Topic Alias
+    [[nodiscard]]
+    payloads_span_type find(topic_alias_type p_alias,
+                            std::string_view p_topic,
+                            automaton_type & p_automaton,
+                            automaton_generation_type p_generation)
+    {
+      // A Topic Alias of 0 is not permitted.
+      if((0 == p_alias) || (p_alias > m_alias_maximum))
+      {
+        m_status = TopicAliasStatus::InvalidAlias;
+        return payloads_span_type{};
+      }
+
+      if(p_topic.empty()
+         && ((p_alias >= m_entries.size()) || m_entries[p_alias].topic.empty()))
+      {
+        m_status = TopicAliasStatus::UnknownAlias;
+        return payloads_span_type{};
+      }
+
+      if(p_alias >= m_entries.size())
+      {
+        m_entries.resize(static_cast<size_type>(p_alias) + 1);
+      }
+
+      auto & entry = m_entries[p_alias];
+
+      if(!p_topic.empty())
+      {
+        entry.topic.assign(p_topic);
+        entry.valid = false;
+      }
+
+      m_status = TopicAliasStatus::Ok;
+
+      if(!entry.valid || (p_generation != entry.generation))
+      {
+        // The automaton's result is only valid until its next find().
+        entry.payloads.clear(yy_quad::ClearAction::Keep);
+        for(auto payload : p_automaton.find(entry.topic))
+        {
+          entry.payloads.emplace_back(payload);
+        }
+        entry.generation = p_generation;
+        entry.valid = true;
+        ++m_misses;
+      }
+      else
+      {
+        ++m_hits;
+      }
+
+      return yy_quad::make_span(entry.payloads);
+    }
+
+    // Topic name set for p_alias, empty if none.
+    [[nodiscard]]
+    std::string_view topic(topic_alias_type p_alias) const noexcept
+    {
+      if(p_alias >= m_entries.size())
+      {
+        return std::string_view{};
+      }
+
+      return m_entries[p_alias].topic;
+    }
+
+    // Forget every alias, e.g. when the network connection is closed.
+    void clear() noexcept
+    {
+      for(auto & entry : m_entries)
+      {
+        entry.topic.clear();
+        entry.payloads.clear(yy_quad::ClearAction::Keep);
+        entry.valid = false;
+      }
+    }
+
+    [[nodiscard]]
+    TopicAliasStatus status() const noexcept
+    {
+      return m_status;
+    }
+
+    [[nodiscard]]
+    size_type hits() const noexcept
+    {
+      return m_hits;
+    }
+
+    [[nodiscard]]
+    size_type misses() const noexcept
+    {
+      return m_misses;
+    }
+
+  private:
+    struct entry_type final
+    {
+        std::string topic{};
+        payloads_type payloads{};
+        automaton_generation_type generation = 0;
+        bool valid = false;
+    };
+
+    topic_alias_type m_alias_maximum = 0;
+    std::vector<entry_type> m_entries{};
+    TopicAliasStatus m_status = TopicAliasStatus::Ok;
+    size_type m_hits = 0;
+    size_type m_misses = 0;
+};
+
+} // namespace yafiyogi::yy_mqtt
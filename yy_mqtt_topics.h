@@ -30,11 +30,15 @@
 
 #include <string_view>
 #include <tuple>
+#include <utility>
 #include <vector>
 
+#include "yy_cpp/yy_span.h"
 #include "yy_cpp/yy_trie.h"
+#include "yy_cpp/yy_vector.h"
 
 #include "yy_mqtt_constants.h"
+#include "yy_mqtt_topic.h"
 
 namespace yafiyogi::yy_mqtt {
 namespace topics_detail {
@@ -63,11 +67,15 @@ class Query final
     using node_edge = typename traits::node_edge;
     using queue = std::vector<std::tuple<label_type, node_type *>>;
     using value_type = typename traits::value_type;
-    using payloads_type = std::vector<value_type *>;
+    using payloads_type = yy_quad::simple_vector<value_type *>;
+    using payloads_span_type = yy_quad::span<typename payloads_type::value_type>;
 
     constexpr explicit Query(root_node_ptr p_root) noexcept:
       m_root(std::move(p_root))
     {
+      m_search_states.reserve(6);
+      m_new_states.reserve(6);
+      m_payloads.reserve(3);
     }
 
     Query() = delete;
@@ -78,11 +86,16 @@ class Query final
     Query & operator=(const Query &) = delete;
     Query & operator=(Query &&) = delete;
 
-    constexpr payloads_type find(std::string_view topic) noexcept
+    // Scratch buffers are kept between calls, so once they have grown
+    // to fit the deepest search a lookup does not allocate. The span
+    // returned is valid until the next call to find().
+    [[nodiscard]]
+    constexpr payloads_span_type find(std::string_view topic) noexcept
     {
-      payloads_type payloads;
-
       m_search_states.clear();
+      m_new_states.clear();
+      m_payloads.clear(yy_quad::ClearAction::Keep);
+
       add_state(label_type{}, m_root.get(), m_search_states);
 
       if(!topic.empty())
@@ -92,19 +105,23 @@ class Query final
           add_wildcards(m_root.get(), m_search_states);
         }
 
-        payloads.reserve(3);
-
         const auto max = topic.size();
         for(size_type idx = 0; idx < max; ++idx)
         {
-          if(!next(topic[idx], idx == (max - 1), payloads))
+          if(!next(topic[idx], idx == (max - 1), m_payloads))
           {
             break;
           }
         }
       }
 
-      return payloads;
+      return yy_quad::make_span(m_payloads);
+    }
+
+    [[nodiscard]]
+    constexpr payloads_span_type find(const Topic & p_topic) noexcept
+    {
+      return find(p_topic.view());
     }
 
   private:
@@ -157,12 +174,12 @@ class Query final
                         const bool p_last,
                         payloads_type & payloads) noexcept
     {
-      queue new_states;
-
-      while(!m_search_states.empty())
+      // States added to m_search_states while walking it are matched
+      // against the current character, those in m_new_states against
+      // the next one.
+      for(size_type head = 0; head < m_search_states.size(); ++head)
       {
-        auto [label, state] = m_search_states.front();
-        m_search_states.erase(m_search_states.begin());
+        auto [label, state] = m_search_states[head];
 
         switch(label)
         {
@@ -184,7 +201,7 @@ class Query final
                 else
                 {
                   // Finished matching +, match / next.
-                  add_state(mqtt_detail::TopicLevelSeparatorChar, separator, new_states);
+                  add_state(mqtt_detail::TopicLevelSeparatorChar, separator, m_new_states);
                 }
               }
               else if(p_last)
@@ -201,7 +218,7 @@ class Query final
             else
             {
               // Continue to match '+'
-              add_state(label, state, new_states);
+              add_state(label, state, m_new_states);
             }
             break;
 
@@ -213,9 +230,8 @@ class Query final
           case mqtt_detail::TopicLevelSeparatorChar:
             // Only add wildcard nodes at the beginning of a new level.
             add_wildcards(state, m_search_states);
-            // Add pch to state list
-            add_node_state(p_ch, state, new_states);
-            break;
+            // Match p_ch as any other, it may end the topic ('a/b').
+            [[fallthrough]];
 
           default:
             // Find p_ch.
@@ -254,19 +270,22 @@ class Query final
               else
               {
                 // More to match...
-                add_state(p_ch, next_state, new_states);
+                add_state(p_ch, next_state, m_new_states);
               }
             }
             break;
         }
       }
 
-      std::swap(m_search_states, new_states);
+      m_search_states.clear();
+      std::swap(m_search_states, m_new_states);
       return !m_search_states.empty();
     }
 
     root_node_ptr m_root;
     queue m_search_states;
+    queue m_new_states;
+    payloads_type m_payloads;
 };
 
 } // namespace detail
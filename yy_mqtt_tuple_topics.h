@@ -0,0 +1,349 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2024-2025 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "yy_cpp/yy_span.h"
+#include "yy_cpp/yy_vector.h"
+
+#include "yy_mqtt_constants.h"
+#include "yy_mqtt_topic.h"
+#include "yy_mqtt_util.h"
+
+namespace yafiyogi::yy_mqtt {
+namespace tuple_topics_detail {
+
+using entry_idx = uint32_t;
+
+// A shape has one character per filter level: shape_literal, '+' or '#'.
+inline constexpr char shape_literal = 'L';
+
+struct key_hash final
+{
+    using is_transparent = void;
+
+    [[nodiscard]]
+    std::size_t operator()(std::string_view p_key) const noexcept
+    {
+      return std::hash<std::string_view>{}(p_key);
+    }
+};
+
+using key_table = std::unordered_map<std::string, entry_idx, key_hash, std::equal_to<>>;
+
+// Splits p_levels into a shape and a key; the key is each literal
+// level followed by '/'.
+template<typename LevelsType>
+void shape_key(const LevelsType & p_levels,
+               std::string & p_shape,
+               std::string & p_key)
+{
+  p_shape.clear();
+  p_key.clear();
+
+  for(const auto level : p_levels)
+  {
+    if((mqtt_detail::TopicSingleLevelWildcard == level)
+       || (mqtt_detail::TopicMultiLevelWildcard == level))
+    {
+      p_shape.push_back(level[0]);
+      continue;
+    }
+
+    p_key.append(level);
+    p_key.push_back(mqtt_detail::TopicLevelSeparatorChar);
+    p_shape.push_back(shape_literal);
+  }
+}
+
+struct shape_table final
+{
+    std::string shape{};
+    key_table entries{};
+    size_type levels = 0; // Excluding a trailing '#'.
+    bool multi = false;
+    bool leading_wildcard = false;
+    bool trailing_single = false;
+};
+
+template<typename ValueType>
+class Query final
+{
+  public:
+    using value_type = ValueType;
+    using value_ptr = value_type *;
+    using data_vector = yy_quad::simple_vector<value_type>;
+    using payloads_type = yy_quad::simple_vector<value_ptr>;
+    using payloads_span_type = yy_quad::span<typename payloads_type::value_type>;
+    using shapes_type = yy_quad::simple_vector<shape_table>;
+    using shape_list = yy_quad::simple_vector<size_type>;
+    using candidates_type = yy_quad::simple_vector<shape_list>;
+
+    // Candidate lists are re-ordered by hits every reorder_interval lookups.
+    static constexpr size_type reorder_interval = 4096;
+
+    Query(shapes_type && p_shapes,
+          data_vector && p_data) noexcept:
+      m_shapes(std::move(p_shapes)),
+      m_data(std::move(p_data))
+    {
+      build_candidates();
+      m_payloads.reserve(3);
+    }
+
+    Query() noexcept = default;
+    Query(const Query &) = delete;
+    Query(Query &&) noexcept = default;
+    ~Query() noexcept = default;
+
+    Query & operator=(const Query &) = delete;
+    Query & operator=(Query &&) noexcept = default;
+
+    [[nodiscard]]
+    payloads_span_type find(std::string_view p_topic) noexcept
+    {
+      m_payloads.clear(yy_quad::ClearAction::Keep);
+
+      if(!p_topic.empty())
+      {
+        find_levels(topic_tokenize_view(m_levels, p_topic), mqtt_detail::TopicSysChar == p_topic[0]);
+      }
+
+      return yy_quad::make_span(m_payloads);
+    }
+
+    [[nodiscard]]
+    payloads_span_type find(const Topic & p_topic) noexcept
+    {
+      m_payloads.clear(yy_quad::ClearAction::Keep);
+
+      if(!p_topic.empty())
+      {
+        find_levels(p_topic.levels(), p_topic.is_sys());
+      }
+
+      return yy_quad::make_span(m_payloads);
+    }
+
+    [[nodiscard]]
+    size_type shape_count() const noexcept
+    {
+      return m_shapes.size();
+    }
+
+  private:
+    // m_candidates[n] lists the shapes that can match a topic of n
+    // levels; the last list serves every longer topic.
+    void build_candidates()
+    {
+      size_type max_levels = 0;
+      for(const auto & table : m_shapes)
+      {
+        max_levels = std::max(max_levels, table.levels);
+      }
+
+      m_candidates.resize(max_levels + 3);
+      m_hits.resize(m_shapes.size());
+
+      for(size_type levels = 1; levels < m_candidates.size(); ++levels)
+      {
+        for(size_type shape = 0; shape < m_shapes.size(); ++shape)
+        {
+          const auto & table = m_shapes[shape];
+
+          // 'abc/#' matches 'abc', 'abc/+' matches 'abc/cde/'.
+          if((table.multi && (table.levels <= levels))
+             || (table.levels == levels)
+             || (table.trailing_single && ((table.levels + 1) == levels)))
+          {
+            m_candidates[levels].emplace_back(shape);
+          }
+        }
+      }
+    }
+
+    void reorder() noexcept
+    {
+      for(auto & candidates : m_candidates)
+      {
+        std::stable_sort(candidates.begin(), candidates.end(), [this](size_type p_lhs, size_type p_rhs) {
+          return m_hits[p_lhs] > m_hits[p_rhs];
+        });
+      }
+    }
+
+    template<typename LevelsType>
+    void find_levels(const LevelsType & p_levels,
+                     bool p_sys) noexcept
+    {
+      if(0 == (++m_lookups % reorder_interval))
+      {
+        reorder();
+      }
+
+      const auto size = p_levels.size();
+      // Topic is 'abc/cde/'.
+      const bool trailing = (size > 1) && p_levels[size - 1].empty();
+
+      for(const auto shape : m_candidates[std::min(size, m_candidates.size() - 1)])
+      {
+        const auto & table = m_shapes[shape];
+
+        // mqtt-v5.0 4.7.2 Topics beginning with $
+        // Wildcards at the first level do not match topics beginning with '$'.
+        if((p_sys && table.leading_wildcard)
+           || (!table.multi && (table.levels != size) && !trailing))
+        {
+          continue;
+        }
+
+        m_key.clear();
+        for(size_type idx = 0; idx < table.levels; ++idx)
+        {
+          if(shape_literal == table.shape[idx])
+          {
+            m_key.append(p_levels[idx]);
+            m_key.push_back(mqtt_detail::TopicLevelSeparatorChar);
+          }
+        }
+
+        if(auto found = table.entries.find(std::string_view{m_key});
+           table.entries.end() != found)
+        {
+          m_payloads.emplace_back(&m_data[found->second]);
+          ++m_hits[shape];
+        }
+      }
+    }
+
+    shapes_type m_shapes{};
+    candidates_type m_candidates{};
+    yy_quad::simple_vector<uint64_t> m_hits{};
+    uint64_t m_lookups = 0;
+    data_vector m_data{};
+    TopicLevelsView m_levels{};
+    std::string m_key{};
+    payloads_type m_payloads{};
+};
+
+} // namespace tuple_topics_detail
+
+// Tuple space search: filters are grouped by shape, e.g. 'L/L/+/L'
+// for 'iot21/Attic/+/battery', and each group is a hash table keyed
+// by the filter's literal levels. A lookup probes each shape that fits
+// the topic's level count once, so its cost follows the number of
+// shapes rather than the depth or fan-out of a trie.
+template<typename ValueType>
+class tuple_topics final
+{
+  public:
+    using value_type = ValueType;
+    using automaton_type = tuple_topics_detail::Query<value_type>;
+    using data_vector = typename automaton_type::data_vector;
+
+    tuple_topics() = default;
+    tuple_topics(const tuple_topics &) = default;
+    tuple_topics(tuple_topics &&) noexcept = default;
+    ~tuple_topics() = default;
+
+    tuple_topics & operator=(const tuple_topics &) = default;
+    tuple_topics & operator=(tuple_topics &&) noexcept = default;
+
+    // Filters that are not valid, or have no levels, are ignored.
+    void add(std::string_view p_filter,
+             value_type p_value)
+    {
+      if((TopicValidStatus::Valid != topic_validate(p_filter, TopicType::Filter))
+         || topic_tokenize_view(m_levels, p_filter).empty())
+      {
+        return;
+      }
+
+      tuple_topics_detail::shape_key(m_levels, m_shape, m_key);
+
+      auto & entries = m_shapes[m_shape];
+      if(auto found = entries.find(std::string_view{m_key});
+         entries.end() != found)
+      {
+        m_values[found->second] = std::move(p_value);
+        return;
+      }
+
+      entries.emplace(m_key, static_cast<tuple_topics_detail::entry_idx>(m_values.size()));
+      m_values.emplace_back(std::move(p_value));
+    }
+
+    [[nodiscard]]
+    automaton_type create_automaton() const
+    {
+      typename automaton_type::shapes_type shapes{};
+      data_vector data{};
+
+      for(const auto & value : m_values)
+      {
+        data.emplace_back(value);
+      }
+
+      for(const auto & [shape, entries] : m_shapes)
+      {
+        if(shape.empty())
+        {
+          continue;
+        }
+
+        tuple_topics_detail::shape_table table{};
+
+        table.shape = shape;
+        table.entries = entries;
+        table.multi = mqtt_detail::TopicMultiLevelWildcardChar == shape.back();
+        table.levels = shape.size() - (table.multi ? 1 : 0);
+        table.leading_wildcard = tuple_topics_detail::shape_literal != shape.front();
+        table.trailing_single = mqtt_detail::TopicSingleLevelWildcardChar == shape.back();
+
+        shapes.emplace_back(std::move(table));
+      }
+
+      return automaton_type{std::move(shapes), std::move(data)};
+    }
+
+  private:
+    std::map<std::string, tuple_topics_detail::key_table> m_shapes{};
+    std::vector<value_type> m_values{};
+    TopicLevelsView m_levels{};
+    std::string m_shape{};
+    std::string m_key{};
+};
+
+} // namespace yafiyogi::yy_mqtt
@@ -26,6 +26,9 @@
 
 #pragma once
 
+#include <cstdint>
+
+#include <string>
 #include <string_view>
 
 #include "yy_cpp/yy_vector.h"
@@ -35,4 +38,132 @@ namespace yafiyogi::yy_mqtt {
 using TopicLevelsView = yy_quad::simple_vector<std::string_view, yy_quad::ClearAction::Keep>;
 using TopicLevels = yy_quad::simple_vector<std::string, yy_quad::ClearAction::Keep>;
 
+// Owning topic levels held in one character buffer, each level ending
+// at the matching entry of an offset array. clear() keeps both buffers,
+// so once they have grown to fit the deepest topic, filling them again
+// does not allocate. Views returned are invalidated by emplace_back().
+class TopicLevelsBuffer final
+{
+  public:
+    using offsets_type = yy_quad::simple_vector<size_type, yy_quad::ClearAction::Keep>;
+
+    class const_iterator final
+    {
+      public:
+        constexpr const_iterator(const TopicLevelsBuffer * p_levels,
+                                 size_type p_idx) noexcept:
+          m_levels(p_levels),
+          m_idx(p_idx)
+        {
+        }
+
+        std::string_view operator*() const noexcept
+        {
+          return (*m_levels)[m_idx];
+        }
+
+        constexpr const_iterator & operator++() noexcept
+        {
+          ++m_idx;
+          return *this;
+        }
+
+        constexpr bool operator==(const const_iterator & other) const noexcept = default;
+
+      private:
+        const TopicLevelsBuffer * m_levels;
+        size_type m_idx;
+    };
+
+    TopicLevelsBuffer() noexcept = default;
+    TopicLevelsBuffer(const TopicLevelsBuffer &) = default;
+    TopicLevelsBuffer(TopicLevelsBuffer &&) noexcept = default;
+    ~TopicLevelsBuffer() = default;
+
+    TopicLevelsBuffer & operator=(const TopicLevelsBuffer &) = default;
+    TopicLevelsBuffer & operator=(TopicLevelsBuffer &&) noexcept = default;
+
+    void reserve(size_type p_levels,
+                 size_type p_chars)
+    {
+      m_ends.reserve(p_levels);
+      m_chars.reserve(p_chars);
+    }
+
+    void clear() noexcept
+    {
+      m_ends.clear();
+      m_chars.clear();
+    }
+
+    void emplace_back(std::string_view p_level)
+    {
+      m_chars.append(p_level);
+      m_ends.emplace_back(m_chars.size());
+    }
+
+    [[nodiscard]]
+    std::string_view operator[](size_type p_idx) const noexcept
+    {
+      const size_type begin = (0 == p_idx) ? 0 : m_ends[p_idx - 1];
+
+      return std::string_view{m_chars.data() + begin, m_ends[p_idx] - begin};
+    }
+
+    [[nodiscard]]
+    size_type size() const noexcept
+    {
+      return m_ends.size();
+    }
+
+    [[nodiscard]]
+    bool empty() const noexcept
+    {
+      return m_ends.empty();
+    }
+
+    [[nodiscard]]
+    const_iterator begin() const noexcept
+    {
+      return const_iterator{this, 0};
+    }
+
+    [[nodiscard]]
+    const_iterator end() const noexcept
+    {
+      return const_iterator{this, size()};
+    }
+
+    // Characters held, excluding separators.
+    [[nodiscard]]
+    size_type char_count() const noexcept
+    {
+      return m_chars.size();
+    }
+
+  private:
+    offsets_type m_ends{};
+    std::string m_chars{};
+};
+
+enum class TopicValidStatus { Valid, Invalid, BadParam};
+
+enum class TopicSearchStatus:uint8_t { Ok, LevelLimit, StateLimit };
+
+// Per lookup work limits. Zero means unlimited.
+struct TopicSearchLimits final
+{
+    size_type max_levels = 0;
+    size_type max_states = 0;
+};
+
+enum class TopicAliasStatus:uint8_t { Ok, InvalidAlias, UnknownAlias };
+
+// Parts of a '$share/{ShareName}/{filter}' subscription.
+struct SharedSubscription final
+{
+    std::string_view share_name{};
+    std::string_view filter{};
+};
+
 } // namespace yafiyogi::yy_mqtt
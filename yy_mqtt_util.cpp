@@ -27,6 +27,7 @@
 #include <cstddef>
 
 #include <stdexcept>
+#include <tuple>
 
 #include "yy_cpp/yy_string_util.h"
 #include "yy_cpp/yy_span.h"
@@ -42,6 +43,360 @@ namespace {
 using tokenizer_type = yy_util::tokenizer<std::string_view::value_type>;
 using token_type = tokenizer_type::token_type;
 
+// Splits levels off a topic or filter. 'a/' has two levels, 'a' and ''.
+class level_scanner final
+{
+  public:
+    constexpr explicit level_scanner(std::string_view p_topic) noexcept:
+      m_rest(p_topic),
+      m_more(!p_topic.empty())
+    {
+    }
+
+    [[nodiscard]]
+    constexpr std::string_view first() const noexcept
+    {
+      return m_rest;
+    }
+
+    [[nodiscard]]
+    constexpr bool has_more() const noexcept
+    {
+      return m_more;
+    }
+
+    constexpr std::string_view scan() noexcept
+    {
+      const auto pos = m_rest.find(mqtt_detail::TopicLevelSeparatorChar);
+
+      if(std::string_view::npos == pos)
+      {
+        const auto level{m_rest};
+        m_rest = std::string_view{};
+        m_more = false;
+        return level;
+      }
+
+      const auto level{m_rest.substr(0, pos)};
+      m_rest = m_rest.substr(pos + 1);
+      return level;
+    }
+
+  private:
+    std::string_view m_rest;
+    bool m_more;
+};
+
+// mqtt-v5.0-os 4.7.2 Topics beginning with $
+// A filter starting with a wildcard does not match a topic starting
+// with '$'.
+constexpr bool is_sys_topic(std::string_view p_filter,
+                            std::string_view p_topic) noexcept
+{
+  return !p_filter.empty()
+    && !p_topic.empty()
+    && ((mqtt_detail::TopicMultiLevelWildcardChar == p_filter[0])
+        || (mqtt_detail::TopicSingleLevelWildcardChar == p_filter[0]))
+    && (mqtt_detail::TopicSysChar == p_topic[0]);
+}
+
+enum class FilterLevel {Literal, SingleLevel, MultiLevel};
+
+// Walks a filter string level by level without splitting it first;
+// a literal level is one compare of the topic level's length, so
+// most filters fail on the first level without scanning the rest.
+class filter_scanner final
+{
+  public:
+    constexpr explicit filter_scanner(std::string_view p_filter) noexcept:
+      m_filter(p_filter),
+      m_more(!p_filter.empty())
+    {
+    }
+
+    [[nodiscard]]
+    constexpr bool empty() const noexcept
+    {
+      return m_filter.empty();
+    }
+
+    [[nodiscard]]
+    constexpr std::string_view first() const noexcept
+    {
+      return m_filter;
+    }
+
+    [[nodiscard]]
+    constexpr bool has_more() const noexcept
+    {
+      return m_more;
+    }
+
+    [[nodiscard]]
+    constexpr FilterLevel kind() const noexcept
+    {
+      const size_type next = m_pos + 1;
+
+      if((m_pos == m_filter.size())
+         || ((next != m_filter.size())
+             && (mqtt_detail::TopicLevelSeparatorChar != m_filter[next])))
+      {
+        return FilterLevel::Literal;
+      }
+
+      switch(m_filter[m_pos])
+      {
+        case mqtt_detail::TopicMultiLevelWildcardChar:
+          return FilterLevel::MultiLevel;
+
+        case mqtt_detail::TopicSingleLevelWildcardChar:
+          return FilterLevel::SingleLevel;
+
+        default:
+          return FilterLevel::Literal;
+      }
+    }
+
+    constexpr void skip() noexcept
+    {
+      ++m_pos;
+      next_level();
+    }
+
+    template<typename TopicLevels>
+    [[nodiscard]]
+    constexpr bool match(TopicLevels & p_topic) noexcept
+    {
+      const auto topic_level{p_topic.scan()};
+
+      if(topic_level != m_filter.substr(m_pos, topic_level.size()))
+      {
+        return false;
+      }
+      m_pos += topic_level.size();
+
+      return next_level();
+    }
+
+  private:
+    constexpr bool next_level() noexcept
+    {
+      if(m_filter.size() == m_pos)
+      {
+        m_more = false;
+        return true;
+      }
+
+      if(mqtt_detail::TopicLevelSeparatorChar != m_filter[m_pos])
+      {
+        return false;
+      }
+      ++m_pos;
+
+      return true;
+    }
+
+    std::string_view m_filter;
+    size_type m_pos = 0;
+    bool m_more;
+};
+
+// Walks the levels of a tokenized topic or filter.
+class levels_scanner final
+{
+  public:
+    explicit levels_scanner(const TopicLevelsView & p_levels) noexcept:
+      m_levels(p_levels)
+    {
+    }
+
+    [[nodiscard]]
+    bool empty() const noexcept
+    {
+      return m_levels.empty();
+    }
+
+    [[nodiscard]]
+    std::string_view first() const noexcept
+    {
+      return m_levels.empty() ? std::string_view{} : m_levels[0];
+    }
+
+    [[nodiscard]]
+    bool has_more() const noexcept
+    {
+      return m_levels.size() != m_level_no;
+    }
+
+    [[nodiscard]]
+    FilterLevel kind() const noexcept
+    {
+      return filter_level_kind(m_levels[m_level_no]);
+    }
+
+    void skip() noexcept
+    {
+      ++m_level_no;
+    }
+
+    [[nodiscard]]
+    std::string_view scan() noexcept
+    {
+      return m_levels[m_level_no++];
+    }
+
+    template<typename TopicLevels>
+    [[nodiscard]]
+    bool match(TopicLevels & p_topic) noexcept
+    {
+      return scan() == p_topic.scan();
+    }
+
+    [[nodiscard]]
+    static constexpr FilterLevel filter_level_kind(std::string_view p_level) noexcept
+    {
+      if(mqtt_detail::TopicMultiLevelWildcard == p_level)
+      {
+        return FilterLevel::MultiLevel;
+      }
+
+      if(mqtt_detail::TopicSingleLevelWildcard == p_level)
+      {
+        return FilterLevel::SingleLevel;
+      }
+
+      return FilterLevel::Literal;
+    }
+
+  private:
+    const TopicLevelsView & m_levels;
+    size_type m_level_no = 0;
+};
+
+// Walks the levels of a Topic; matching two of them compares the
+// level hashes first, which rejects most unequal levels cheaply.
+class topic_scanner final
+{
+  public:
+    explicit topic_scanner(const Topic & p_topic) noexcept:
+      m_topic(p_topic)
+    {
+    }
+
+    [[nodiscard]]
+    bool empty() const noexcept
+    {
+      return m_topic.empty();
+    }
+
+    [[nodiscard]]
+    std::string_view first() const noexcept
+    {
+      return m_topic.view();
+    }
+
+    [[nodiscard]]
+    bool has_more() const noexcept
+    {
+      return m_topic.size() != m_level_no;
+    }
+
+    [[nodiscard]]
+    FilterLevel kind() const noexcept
+    {
+      return levels_scanner::filter_level_kind(m_topic.level(m_level_no));
+    }
+
+    void skip() noexcept
+    {
+      ++m_level_no;
+    }
+
+    [[nodiscard]]
+    std::string_view scan() noexcept
+    {
+      return m_topic.level(m_level_no++);
+    }
+
+    [[nodiscard]]
+    bool match(topic_scanner & p_topic) noexcept
+    {
+      if(m_topic.level_hash(m_level_no) != p_topic.m_topic.level_hash(p_topic.m_level_no))
+      {
+        return false;
+      }
+
+      return scan() == p_topic.scan();
+    }
+
+  private:
+    const Topic & m_topic;
+    size_type m_level_no = 0;
+};
+
+// The one filter matcher behind every topic_match() overload, so the
+// '$' and trailing '+' rules live in one place. The filter scanner
+// decides how a literal level is compared; the topic scanner only
+// hands out levels.
+template<typename FilterLevels,
+         typename TopicLevels,
+         typename FilterSource,
+         typename TopicSource>
+TopicMatchStatus match_levels(const FilterSource & p_filter,
+                              const TopicSource & p_topic) noexcept
+{
+  FilterLevels filter{p_filter};
+  TopicLevels topic{p_topic};
+
+  if(filter.empty()
+     || is_sys_topic(filter.first(), topic.first()))
+  {
+    return TopicMatchStatus::Fail;
+  }
+
+  bool single_level = false;
+  while(filter.has_more())
+  {
+    const auto kind = filter.kind();
+
+    if(FilterLevel::MultiLevel == kind)
+    {
+      return TopicMatchStatus::Match;
+    }
+
+    if(!topic.has_more())
+    {
+      return TopicMatchStatus::Fail;
+    }
+
+    single_level = FilterLevel::SingleLevel == kind;
+    if(single_level)
+    {
+      filter.skip();
+      std::ignore = topic.scan();
+    }
+    else if(!filter.match(topic))
+    {
+      return TopicMatchStatus::Fail;
+    }
+  }
+
+  if(!topic.has_more())
+  {
+    return TopicMatchStatus::Match;
+  }
+
+  // A final '+' also matches a trailing separator: 'a/+' matches 'a/b/'.
+  if(single_level
+     && topic.scan().empty()
+     && !topic.has_more())
+  {
+    return TopicMatchStatus::Match;
+  }
+
+  return TopicMatchStatus::Fail;
+}
+
 }
 
 std::string_view topic_trim(const std::string_view p_topic) noexcept
@@ -103,6 +458,25 @@ TopicLevels topic_tokenize(const std::string_view p_topic) noexcept
   return levels;
 }
 
+TopicLevelsBuffer & topic_tokenize(TopicLevelsBuffer & p_levels,
+                                   const std::string_view p_topic) noexcept
+{
+  tokenizer_type tokenizer{yy_quad::make_const_span(p_topic),
+                                          mqtt_detail::TopicLevelSeparatorChar};
+
+  p_levels.clear();
+  p_levels.reserve(static_cast<size_type>(std::count(p_topic.begin(), p_topic.end(), mqtt_detail::TopicLevelSeparatorChar) + 1),
+                   p_topic.size());
+
+  while(!tokenizer.empty() || tokenizer.has_more())
+  {
+    auto level{tokenizer.scan()};
+    p_levels.emplace_back(std::string_view{level.data(), level.size()});
+  }
+
+  return p_levels;
+}
+
 TopicValidStatus topic_validate_level(std::string_view p_level,
                                       const TopicType p_type,
                                       const bool has_more)
@@ -189,132 +563,173 @@ TopicValidStatus topic_validate(const TopicLevelsView & p_levels,
 TopicMatchStatus topic_match(const std::string_view & p_filter,
                              const std::string_view & p_topic) noexcept
 {
-  auto filter{yy_quad::make_const_span(p_filter)};
-  tokenizer_type filter_tokenizer{filter,
-                                          mqtt_detail::TopicLevelSeparatorChar};
+  return match_levels<filter_scanner, level_scanner>(p_filter, p_topic);
+}
 
-  auto topic{yy_quad::make_const_span(p_topic)};
-  tokenizer_type topic_tokenizer{topic,
-                                          mqtt_detail::TopicLevelSeparatorChar};
+TopicMatchStatus topic_match(const TopicLevelsView & p_filter,
+                             const TopicLevelsView & p_topic) noexcept
+{
+  return match_levels<levels_scanner, levels_scanner>(p_filter, p_topic);
+}
+
+TopicMatchStatus topic_match(const std::string_view & p_filter,
+                             const Topic & p_topic) noexcept
+{
+  return match_levels<filter_scanner, levels_scanner>(p_filter, p_topic.levels());
+}
+
+TopicMatchStatus topic_match(const Topic & p_filter,
+                             const Topic & p_topic) noexcept
+{
+  return match_levels<topic_scanner, topic_scanner>(p_filter, p_topic);
+}
 
-  if(!p_filter.empty()
-     && !p_topic.empty())
+void topic_matcher::topic(std::string_view p_topic) noexcept
+{
+  m_levels.clear();
+
+  level_scanner topic{p_topic};
+  while(topic.has_more())
   {
-    auto filter_level_0{tokenizer_type::scanner::scan(filter,
-                                          mqtt_detail::TopicLevelSeparatorChar)};
-    auto topic_level_0{tokenizer_type::scanner::scan(topic,
-                                          mqtt_detail::TopicLevelSeparatorChar)};
+    m_levels.emplace_back(topic.scan());
+  }
+}
 
-    if(((mqtt_detail::TopicMultiLevelWildcard == filter_level_0)
-        || (mqtt_detail::TopicSingleLevelWildcard == filter_level_0))
-       && !topic_level_0.empty()
-       && (mqtt_detail::TopicSysChar == topic_level_0[0]))
-    {
-      return TopicMatchStatus::Fail;
-    }
+TopicMatchStatus topic_matcher::match(std::string_view p_filter) const noexcept
+{
+  return match_levels<filter_scanner, levels_scanner>(p_filter, m_levels);
+}
+
+void topic_matcher::match_many(yy_quad::const_span<std::string_view> p_filters,
+                               TopicMatchResults & p_results) const noexcept
+{
+  p_results.clear();
+  for(const auto & filter : p_filters)
+  {
+    p_results.emplace_back(match(filter));
   }
+}
+
+void topic_match_many(std::string_view p_topic,
+                      yy_quad::const_span<std::string_view> p_filters,
+                      TopicMatchResults & p_results) noexcept
+{
+  topic_matcher matcher{};
 
-  while(filter_tokenizer.has_more())
+  matcher.topic(p_topic);
+  matcher.match_many(p_filters, p_results);
+}
+
+void topic_match_many(const Topic & p_topic,
+                      yy_quad::const_span<std::string_view> p_filters,
+                      TopicMatchResults & p_results) noexcept
+{
+  p_results.clear();
+  for(const auto & filter : p_filters)
   {
-    token_type filter_level{filter_tokenizer.scan()};
+    p_results.emplace_back(topic_match(filter, p_topic));
+  }
+}
 
-    if(mqtt_detail::TopicMultiLevelWildcard == filter_level)
-    {
-      return TopicMatchStatus::Match;
-    }
+bool topic_parse_shared(const std::string_view p_filter,
+                        SharedSubscription & p_shared) noexcept
+{
+  // mqtt-v5.0-os 4.8.2 Shared Subscriptions
+  // $share/{ShareName}/{filter}
+  if(!p_filter.starts_with(mqtt_detail::TopicSharePrefix))
+  {
+    return false;
+  }
 
-    if(mqtt_detail::TopicSingleLevelWildcard == filter_level)
-    {
-      if(topic_tokenizer.empty())
-      {
-        return TopicMatchStatus::Match;
-      }
-      std::ignore = topic_tokenizer.scan();
-    }
-    else
-    {
-      if(topic_tokenizer.empty()
-         || (filter_level != topic_tokenizer.scan()))
-      {
-        return TopicMatchStatus::Fail;
-      }
-    }
+  const auto share{p_filter.substr(mqtt_detail::TopicSharePrefix.size())};
+  const auto pos = share.find(mqtt_detail::TopicLevelSeparatorChar);
+  if(std::string_view::npos == pos)
+  {
+    return false;
   }
 
-  if(topic_tokenizer.has_more())
+  // The ShareName MUST NOT contain the characters "/", "+" or "#",
+  // but MUST be followed by a "/" character. This "/" character MUST
+  // be followed by a Topic Filter.
+  const auto share_name{share.substr(0, pos)};
+  const auto filter{share.substr(pos + 1)};
+  if(share_name.empty()
+     || filter.empty()
+     || (std::string_view::npos != share_name.find_first_of("+#"))
+     || (TopicValidStatus::Valid != topic_validate(filter, TopicType::Filter)))
   {
-    if(!p_filter.empty()
-       && (mqtt_detail::TopicSingleLevelWildcard == filter_tokenizer.token()))
-    {
-      std::ignore = topic_tokenizer.scan();
-      if(!topic_tokenizer.token().empty())
-      {
-        return TopicMatchStatus::Fail;
-      }
-    }
+    return false;
   }
 
-  return TopicMatchStatus::Match;
+  p_shared.share_name = share_name;
+  p_shared.filter = filter;
+
+  return true;
 }
 
+bool filter_subsumes(const std::string_view & p_general,
+                     const std::string_view & p_specific) noexcept
+{
+  return filter_subsumes(topic_tokenize_view(p_general),
+                         topic_tokenize_view(p_specific));
+}
 
-TopicMatchStatus topic_match(const TopicLevelsView & p_filter,
-                             const TopicLevelsView & p_topic) noexcept
+bool filter_subsumes(const TopicLevelsView & p_general,
+                     const TopicLevelsView & p_specific) noexcept
 {
-  size_type filter_level_no = 0;
-  const size_type max_topic_level = p_topic.size();
-  size_type topic_level_no = 0;
-
-  if(!p_filter.empty()
-     && !p_topic.empty()
-     && ((mqtt_detail::TopicMultiLevelWildcard == p_filter[0])
-         || (mqtt_detail::TopicSingleLevelWildcard == p_filter[0]))
-     && !p_topic[0].empty()
-     && (mqtt_detail::TopicSysChar == p_topic[0][0]))
+  if(p_general.empty()
+     || p_specific.empty()
+     || (TopicValidStatus::Valid != topic_validate(p_general, TopicType::Filter))
+     || (TopicValidStatus::Valid != topic_validate(p_specific, TopicType::Filter)))
   {
-    return TopicMatchStatus::Fail;
+    return false;
   }
 
-  for(const auto & filter_level : p_filter)
+  // mqtt-v5.0-os 4.7.2 Topics beginning with $
+  // A leading wildcard does not match '$' topics, so cannot subsume
+  // a filter that only matches them.
+  if(((mqtt_detail::TopicMultiLevelWildcard == p_general[0])
+      || (mqtt_detail::TopicSingleLevelWildcard == p_general[0]))
+     && !p_specific[0].empty()
+     && (mqtt_detail::TopicSysChar == p_specific[0][0]))
   {
-    if(mqtt_detail::TopicMultiLevelWildcard == filter_level)
+    return false;
+  }
+
+  const size_type max_specific_level = p_specific.size();
+  size_type level_no = 0;
+
+  for(const auto & general_level : p_general)
+  {
+    if(mqtt_detail::TopicMultiLevelWildcard == general_level)
     {
-      return TopicMatchStatus::Match;
+      // 'a/#' matches 'a' and everything below it.
+      return true;
     }
 
-    if(mqtt_detail::TopicSingleLevelWildcard == filter_level)
+    if(max_specific_level == level_no)
     {
-      if(max_topic_level == topic_level_no)
-      {
-        return TopicMatchStatus::Match;
-      }
+      return false;
     }
-    else
+
+    const auto & specific_level = p_specific[level_no];
+    if(mqtt_detail::TopicSingleLevelWildcard == general_level)
     {
-      if((max_topic_level == topic_level_no)
-         || (filter_level != p_topic[topic_level_no]))
+      // '+' covers any one level, but not the many matched by '#'.
+      if(mqtt_detail::TopicMultiLevelWildcard == specific_level)
       {
-        return TopicMatchStatus::Fail;
+        return false;
       }
     }
-
-    ++filter_level_no;
-    ++topic_level_no;
-  }
-
-  if(topic_level_no < max_topic_level)
-  {
-    if(!p_filter.empty()
-       && (mqtt_detail::TopicSingleLevelWildcard == p_filter[filter_level_no - 1]))
+    else if(general_level != specific_level)
     {
-      if(!p_topic[topic_level_no].empty())
-      {
-        return TopicMatchStatus::Fail;
-      }
+      return false;
     }
+
+    ++level_no;
   }
 
-  return TopicMatchStatus::Match;
+  return max_specific_level == level_no;
 }
 
 } // namespace yafiyogi::yy_mqtt
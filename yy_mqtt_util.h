@@ -28,7 +28,10 @@
 
 #include <string_view>
 
+#include "yy_cpp/yy_span.h"
+
 #include "yy_mqtt_constants.h"
+#include "yy_mqtt_topic.h"
 #include "yy_mqtt_types.h"
 
 namespace yafiyogi::yy_mqtt {
@@ -40,15 +43,65 @@ TopicLevelsView topic_tokenize_view(const std::string_view p_topic) noexcept;
 TopicLevels & topic_tokenize(TopicLevels & p_levels,
                              const std::string_view p_topic) noexcept;
 TopicLevels topic_tokenize(const std::string_view p_topic) noexcept;
-enum class TopicValidStatus { Valid, Invalid, BadParam};
+TopicLevelsBuffer & topic_tokenize(TopicLevelsBuffer & p_levels,
+                                   const std::string_view p_topic) noexcept;
 TopicValidStatus topic_validate(std::string_view topic,
                                 const TopicType p_type);
 TopicValidStatus topic_validate(const TopicLevelsView & p_levels,
                                 const TopicType p_type);
 enum class TopicMatchStatus { Match, Fail, Continue};
+using TopicMatchResults = yy_quad::simple_vector<TopicMatchStatus, yy_quad::ClearAction::Keep>;
 TopicMatchStatus topic_match(const std::string_view & p_filter,
                              const std::string_view & p_topic) noexcept;
 TopicMatchStatus topic_match(const TopicLevelsView & p_filter,
                              const TopicLevelsView & p_topic) noexcept;
+TopicMatchStatus topic_match(const std::string_view & p_filter,
+                             const Topic & p_topic) noexcept;
+TopicMatchStatus topic_match(const Topic & p_filter,
+                             const Topic & p_topic) noexcept;
+
+// Matches one topic against many filters. The topic is split into
+// levels once, and each filter is compared against the cached levels,
+// failing on the first level that differs or when it runs past the
+// topic's level count.
+class topic_matcher final
+{
+  public:
+    topic_matcher() = default;
+    topic_matcher(const topic_matcher &) = default;
+    topic_matcher(topic_matcher &&) noexcept = default;
+    ~topic_matcher() = default;
+
+    topic_matcher & operator=(const topic_matcher &) = default;
+    topic_matcher & operator=(topic_matcher &&) noexcept = default;
+
+    // p_topic must outlive the matches made against it.
+    void topic(std::string_view p_topic) noexcept;
+
+    [[nodiscard]]
+    TopicMatchStatus match(std::string_view p_filter) const noexcept;
+    void match_many(yy_quad::const_span<std::string_view> p_filters,
+                    TopicMatchResults & p_results) const noexcept;
+
+  private:
+    TopicLevelsView m_levels{};
+};
+
+// p_results[i] is the match of p_topic against p_filters[i].
+void topic_match_many(std::string_view p_topic,
+                      yy_quad::const_span<std::string_view> p_filters,
+                      TopicMatchResults & p_results) noexcept;
+void topic_match_many(const Topic & p_topic,
+                      yy_quad::const_span<std::string_view> p_filters,
+                      TopicMatchResults & p_results) noexcept;
+
+bool topic_parse_shared(const std::string_view p_filter,
+                        SharedSubscription & p_shared) noexcept;
+// True if every topic name matched by p_specific is also matched by
+// p_general. Invalid filters subsume nothing.
+bool filter_subsumes(const std::string_view & p_general,
+                     const std::string_view & p_specific) noexcept;
+bool filter_subsumes(const TopicLevelsView & p_general,
+                     const TopicLevelsView & p_specific) noexcept;
 
 } // namespace yafiyogi::yy_mqtt